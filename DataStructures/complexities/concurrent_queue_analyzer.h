@@ -0,0 +1,187 @@
+#pragma once
+
+#include <complexities/complexity_analyzer.h>
+#include <libds/adt/queue.h>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace ds::utils
+{
+    /**
+     * @brief Measures time needed by producer and consumer threads to move a batch of items through a concurrent queue.
+     * @details The structure is first grown to the given size (standing backlog), then @c BATCH_SIZE items are
+     *          pushed and popped concurrently. Throughput is BATCH_SIZE divided by the measured duration.
+     */
+    template<class Queue>
+    class ConcurrentQueueThroughputAnalyzer : public ComplexityAnalyzer<Queue>
+    {
+    public:
+        ConcurrentQueueThroughputAnalyzer(const std::string& name, size_t producerCount, size_t consumerCount);
+
+        static const size_t BATCH_SIZE = 100'000;
+
+    protected:
+        Queue createPrototype() override;
+        void growToSize(Queue& structure, size_t size) override;
+        void executeOperation(Queue& structure) override;
+
+    private:
+        std::default_random_engine rngData_;
+        size_t producerCount_;
+        size_t consumerCount_;
+    };
+
+    /**
+     * @brief Same as @c ConcurrentQueueThroughputAnalyzer with one producer and one consumer moving runs of
+     *        @c RUN_LENGTH items through pushBatch/popBatch.
+     */
+    template<class Queue>
+    class SpscQueueBatchThroughputAnalyzer : public ConcurrentQueueThroughputAnalyzer<Queue>
+    {
+    public:
+        explicit SpscQueueBatchThroughputAnalyzer(const std::string& name);
+
+        static const size_t RUN_LENGTH = 64;
+
+    protected:
+        void executeOperation(Queue& structure) override;
+    };
+
+    /**
+     * @brief Container for all concurrent queue analyzers.
+     */
+    class ConcurrentQueuesAnalyzer : public CompositeAnalyzer
+    {
+    public:
+        ConcurrentQueuesAnalyzer();
+    };
+
+    //----------
+
+    template<class Queue>
+    ConcurrentQueueThroughputAnalyzer<Queue>::ConcurrentQueueThroughputAnalyzer(const std::string& name, size_t producerCount, size_t consumerCount) :
+        ComplexityAnalyzer<Queue>(name),
+        rngData_(144),
+        producerCount_(producerCount),
+        consumerCount_(consumerCount)
+    {
+    }
+
+    template<class Queue>
+    Queue ConcurrentQueueThroughputAnalyzer<Queue>::createPrototype()
+    {
+        return Queue(this->getStepSize() * this->getStepCount() + BATCH_SIZE);
+    }
+
+    template<class Queue>
+    void ConcurrentQueueThroughputAnalyzer<Queue>::growToSize(Queue& structure, size_t size)
+    {
+        const size_t toInsert = size - structure.size();
+        for (size_t i = 0; i < toInsert; ++i)
+        {
+            structure.push(static_cast<int>(rngData_()));
+        }
+    }
+
+    template<class Queue>
+    void ConcurrentQueueThroughputAnalyzer<Queue>::executeOperation(Queue& structure)
+    {
+        std::atomic<size_t> popped(0);
+        std::vector<std::thread> threads;
+        threads.reserve(producerCount_ + consumerCount_);
+
+        for (size_t p = 0; p < producerCount_; ++p)
+        {
+            const size_t count = BATCH_SIZE / producerCount_ + (p < BATCH_SIZE % producerCount_ ? 1 : 0);
+            threads.emplace_back([&structure, count]()
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        while (!structure.tryPush(static_cast<int>(i)))
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+        }
+
+        for (size_t c = 0; c < consumerCount_; ++c)
+        {
+            threads.emplace_back([&structure, &popped]()
+                {
+                    int value = 0;
+                    while (popped.load(std::memory_order_relaxed) < BATCH_SIZE)
+                    {
+                        if (structure.tryPop(value))
+                        {
+                            popped.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        else
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    template<class Queue>
+    SpscQueueBatchThroughputAnalyzer<Queue>::SpscQueueBatchThroughputAnalyzer(const std::string& name) :
+        ConcurrentQueueThroughputAnalyzer<Queue>(name, 1, 1)
+    {
+    }
+
+    template<class Queue>
+    void SpscQueueBatchThroughputAnalyzer<Queue>::executeOperation(Queue& structure)
+    {
+        const size_t batchSize = ConcurrentQueueThroughputAnalyzer<Queue>::BATCH_SIZE;
+
+        std::thread producer([&structure, batchSize]()
+            {
+                int run[RUN_LENGTH] = {};
+                size_t pushed = 0;
+                while (pushed < batchSize)
+                {
+                    const size_t count = pushed + RUN_LENGTH <= batchSize ? RUN_LENGTH : batchSize - pushed;
+                    const size_t accepted = structure.pushBatch(run, count);
+                    if (accepted == 0)
+                    {
+                        std::this_thread::yield();
+                    }
+                    pushed += accepted;
+                }
+            });
+
+        int run[RUN_LENGTH];
+        size_t popped = 0;
+        while (popped < batchSize)
+        {
+            const size_t count = structure.popBatch(run, RUN_LENGTH);
+            if (count == 0)
+            {
+                std::this_thread::yield();
+            }
+            popped += count;
+        }
+        producer.join();
+    }
+
+    //----------
+
+    inline ConcurrentQueuesAnalyzer::ConcurrentQueuesAnalyzer() :
+        CompositeAnalyzer("ConcurrentQueues")
+    {
+        this->addAnalyzer(std::make_unique<ConcurrentQueueThroughputAnalyzer<ds::adt::ConcurrentBoundedQueue<int>>>("ConcurrentBoundedQueue-1p1c", 1, 1));
+        this->addAnalyzer(std::make_unique<ConcurrentQueueThroughputAnalyzer<ds::adt::ConcurrentBoundedQueue<int>>>("ConcurrentBoundedQueue-2p2c", 2, 2));
+        this->addAnalyzer(std::make_unique<ConcurrentQueueThroughputAnalyzer<ds::adt::ConcurrentBoundedQueue<int>>>("ConcurrentBoundedQueue-4p4c", 4, 4));
+        this->addAnalyzer(std::make_unique<ConcurrentQueueThroughputAnalyzer<ds::adt::SpscRingQueue<int>>>("SpscRingQueue-1p1c", 1, 1));
+        this->addAnalyzer(std::make_unique<SpscQueueBatchThroughputAnalyzer<ds::adt::SpscRingQueue<int>>>("SpscRingQueue-batch"));
+    }
+}
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <complexities/complexity_analyzer.h>
+#include <libds/amt/explicit_hierarchy.h>
+#include <libds/exec/parallel_hierarchy.h>
+#include <atomic>
+#include <random>
+#include <vector>
+
+namespace ds::utils
+{
+    /**
+     * @brief Shared settings of hierarchy traversal analyzers.
+     * @details Sizes are multiplied by NODES_PER_SIZE_UNIT, so the default steps end at a million nodes. Every
+     *          visited node is hashed by work, which stands for a cheap but not negligible per-node operation.
+     */
+    struct HierarchyTraversalAnalysis
+    {
+        static const size_t NODES_PER_SIZE_UNIT = 10;
+        static const size_t GRAIN_SIZE = 4096;
+
+        static size_t work(int data)
+        {
+            size_t hash = static_cast<size_t>(data);
+            for (int round = 0; round < 4; ++round)
+            {
+                hash = (hash ^ (hash >> 29)) * 0x9E3779B97F4A7C15ull;
+            }
+            return hash;
+        }
+    };
+
+    /**
+     * @brief Measures one traversal of a random recursive tree, every new node is a son of a random older node.
+     */
+    class HierarchyTraversalAnalyzer : public ComplexityAnalyzer<amt::MultiWayEH<int>>
+    {
+    protected:
+        using BlockType = amt::MultiWayEH<int>::BlockType;
+
+        explicit HierarchyTraversalAnalyzer(const std::string& name);
+
+        void growToSize(amt::MultiWayEH<int>& structure, size_t size) override;
+
+        size_t checksum_;
+
+    private:
+        std::default_random_engine rngParent_;
+        std::vector<BlockType*> nodes_;
+    };
+
+    /**
+     * @brief Serial processPreOrder, the baseline of the parallel analyzers.
+     */
+    class PreOrderAnalyzer : public HierarchyTraversalAnalyzer
+    {
+    public:
+        PreOrderAnalyzer();
+
+    protected:
+        void executeOperation(amt::MultiWayEH<int>& structure) override;
+    };
+
+    /**
+     * @brief parallelProcessPreOrder with the same per-node work as PreOrderAnalyzer.
+     * @details Only hashes with zero low bits are counted in a shared atomic, so threads hardly ever contend.
+     */
+    class ParallelPreOrderAnalyzer : public HierarchyTraversalAnalyzer
+    {
+    public:
+        ParallelPreOrderAnalyzer();
+
+    protected:
+        void executeOperation(amt::MultiWayEH<int>& structure) override;
+    };
+
+    /**
+     * @brief parallelReduce summing the per-node work of PreOrderAnalyzer.
+     */
+    class ParallelReduceAnalyzer : public HierarchyTraversalAnalyzer
+    {
+    public:
+        ParallelReduceAnalyzer();
+
+    protected:
+        void executeOperation(amt::MultiWayEH<int>& structure) override;
+    };
+
+    /**
+     * @brief Random K-way hierarchy, every new node is placed by a descent along random son orders from the root.
+     * @details The size is the number of nodes. Hierarchy is either KWayEH or InlineKWayEH, so blocks with K
+     *          pointers to sons can be compared with the blocks holding a sequence of sons on the heap.
+     */
+    template<class Hierarchy, size_t K>
+    class KWayHierarchyAnalyzer : public ComplexityAnalyzer<Hierarchy>
+    {
+    protected:
+        using BlockType = typename Hierarchy::BlockType;
+
+        explicit KWayHierarchyAnalyzer(const std::string& name);
+
+        void growToSize(Hierarchy& structure, size_t size) override;
+
+        std::default_random_engine rngOrder_;
+        size_t checksum_;
+    };
+
+    /**
+     * @brief Measures DESCENT_COUNT descents along random son orders from the root until a missing son.
+     */
+    template<class Hierarchy, size_t K>
+    class KWayDescentAnalyzer : public KWayHierarchyAnalyzer<Hierarchy, K>
+    {
+    public:
+        static const size_t DESCENT_COUNT = 1000;
+
+        explicit KWayDescentAnalyzer(const std::string& name);
+
+    protected:
+        void executeOperation(Hierarchy& structure) override;
+    };
+
+    /**
+     * @brief Measures a level-order traversal that sums data of all nodes.
+     */
+    template<class Hierarchy, size_t K>
+    class KWayTraversalAnalyzer : public KWayHierarchyAnalyzer<Hierarchy, K>
+    {
+    public:
+        explicit KWayTraversalAnalyzer(const std::string& name);
+
+    protected:
+        void executeOperation(Hierarchy& structure) override;
+    };
+
+    /**
+     * @brief Container for all hierarchy traversal analyzers.
+     */
+    class HierarchyTraversalsAnalyzer : public CompositeAnalyzer
+    {
+    public:
+        HierarchyTraversalsAnalyzer();
+    };
+
+    /**
+     * @brief Container for all analyzers comparing KWayEH with InlineKWayEH.
+     */
+    class KWayHierarchiesAnalyzer : public CompositeAnalyzer
+    {
+    public:
+        KWayHierarchiesAnalyzer();
+    };
+
+    //----------
+
+    inline HierarchyTraversalAnalyzer::HierarchyTraversalAnalyzer(const std::string& name) :
+        ComplexityAnalyzer<amt::MultiWayEH<int>>(name),
+        checksum_(0),
+        rngParent_(144)
+    {
+    }
+
+    inline void HierarchyTraversalAnalyzer::growToSize(amt::MultiWayEH<int>& structure, size_t size)
+    {
+        if (structure.isEmpty())
+        {
+            nodes_.clear();
+            nodes_.push_back(&structure.emplaceRoot());
+            nodes_.back()->data_ = 0;
+        }
+
+        const size_t nodeCount = size * HierarchyTraversalAnalysis::NODES_PER_SIZE_UNIT;
+        while (nodes_.size() < nodeCount)
+        {
+            BlockType* parent = nodes_[rngParent_() % nodes_.size()];
+            BlockType& son = structure.emplaceSon(*parent, structure.degree(*parent));
+            son.data_ = static_cast<int>(nodes_.size());
+            nodes_.push_back(&son);
+        }
+    }
+
+    inline PreOrderAnalyzer::PreOrderAnalyzer() :
+        HierarchyTraversalAnalyzer("MultiWayEH-processPreOrder")
+    {
+    }
+
+    inline void PreOrderAnalyzer::executeOperation(amt::MultiWayEH<int>& structure)
+    {
+        const size_t mask = (size_t(1) << 10) - 1;
+        size_t count = 0;
+        structure.processPreOrder(structure.accessRoot(), [&count, mask](const BlockType* node)
+            {
+                count += (HierarchyTraversalAnalysis::work(node->data_) & mask) == 0 ? 1 : 0;
+            });
+        checksum_ += count;
+    }
+
+    inline ParallelPreOrderAnalyzer::ParallelPreOrderAnalyzer() :
+        HierarchyTraversalAnalyzer("MultiWayEH-parallelProcessPreOrder")
+    {
+    }
+
+    inline void ParallelPreOrderAnalyzer::executeOperation(amt::MultiWayEH<int>& structure)
+    {
+        const size_t mask = (size_t(1) << 10) - 1;
+        std::atomic<size_t> count(0);
+        exec::parallelProcessPreOrder(structure, structure.accessRoot(), [&count, mask](const BlockType* node)
+            {
+                if ((HierarchyTraversalAnalysis::work(node->data_) & mask) == 0)
+                {
+                    count.fetch_add(1, std::memory_order_relaxed);
+                }
+            }, HierarchyTraversalAnalysis::GRAIN_SIZE);
+        checksum_ += count.load();
+    }
+
+    inline ParallelReduceAnalyzer::ParallelReduceAnalyzer() :
+        HierarchyTraversalAnalyzer("MultiWayEH-parallelReduce")
+    {
+    }
+
+    inline void ParallelReduceAnalyzer::executeOperation(amt::MultiWayEH<int>& structure)
+    {
+        checksum_ += exec::parallelReduce(structure, structure.accessRoot(),
+            [](const BlockType* node) { return HierarchyTraversalAnalysis::work(node->data_); },
+            [](size_t left, size_t right) { return left + right; },
+            HierarchyTraversalAnalysis::GRAIN_SIZE);
+    }
+
+    template<class Hierarchy, size_t K>
+    KWayHierarchyAnalyzer<Hierarchy, K>::KWayHierarchyAnalyzer(const std::string& name) :
+        ComplexityAnalyzer<Hierarchy>(name),
+        rngOrder_(144),
+        checksum_(0)
+    {
+    }
+
+    template<class Hierarchy, size_t K>
+    void KWayHierarchyAnalyzer<Hierarchy, K>::growToSize(Hierarchy& structure, size_t size)
+    {
+        if (structure.isEmpty())
+        {
+            structure.emplaceRoot().data_ = 0;
+        }
+
+        for (size_t nodeCount = structure.size(); nodeCount < size; ++nodeCount)
+        {
+            BlockType* parent = structure.accessRoot();
+            size_t order = rngOrder_() % K;
+            BlockType* son = structure.accessSon(*parent, order);
+            while (son != nullptr)
+            {
+                parent = son;
+                order = rngOrder_() % K;
+                son = structure.accessSon(*parent, order);
+            }
+            structure.emplaceSon(*parent, order).data_ = static_cast<int>(nodeCount);
+        }
+    }
+
+    template<class Hierarchy, size_t K>
+    KWayDescentAnalyzer<Hierarchy, K>::KWayDescentAnalyzer(const std::string& name) :
+        KWayHierarchyAnalyzer<Hierarchy, K>(name)
+    {
+    }
+
+    template<class Hierarchy, size_t K>
+    void KWayDescentAnalyzer<Hierarchy, K>::executeOperation(Hierarchy& structure)
+    {
+        for (size_t i = 0; i < DESCENT_COUNT; ++i)
+        {
+            const typename Hierarchy::BlockType* node = structure.accessRoot();
+            while (node != nullptr)
+            {
+                this->checksum_ += static_cast<size_t>(node->data_);
+                node = structure.accessSon(*node, this->rngOrder_() % K);
+            }
+        }
+    }
+
+    template<class Hierarchy, size_t K>
+    KWayTraversalAnalyzer<Hierarchy, K>::KWayTraversalAnalyzer(const std::string& name) :
+        KWayHierarchyAnalyzer<Hierarchy, K>(name)
+    {
+    }
+
+    template<class Hierarchy, size_t K>
+    void KWayTraversalAnalyzer<Hierarchy, K>::executeOperation(Hierarchy& structure)
+    {
+        size_t sum = 0;
+        structure.processLevelOrder(structure.accessRoot(), [&sum](typename Hierarchy::BlockType* node)
+            {
+                sum += static_cast<size_t>(node->data_);
+            });
+        this->checksum_ += sum;
+    }
+
+    //----------
+
+    inline HierarchyTraversalsAnalyzer::HierarchyTraversalsAnalyzer() :
+        CompositeAnalyzer("HierarchyTraversals")
+    {
+        this->addAnalyzer(std::make_unique<PreOrderAnalyzer>());
+        this->addAnalyzer(std::make_unique<ParallelPreOrderAnalyzer>());
+        this->addAnalyzer(std::make_unique<ParallelReduceAnalyzer>());
+    }
+
+    inline KWayHierarchiesAnalyzer::KWayHierarchiesAnalyzer() :
+        CompositeAnalyzer("KWayHierarchies")
+    {
+        this->addAnalyzer(std::make_unique<KWayDescentAnalyzer<amt::KWayEH<int, 2>, 2>>("KWayEH-2-descent"));
+        this->addAnalyzer(std::make_unique<KWayDescentAnalyzer<amt::InlineKWayEH<int, 2>, 2>>("InlineKWayEH-2-descent"));
+        this->addAnalyzer(std::make_unique<KWayDescentAnalyzer<amt::KWayEH<int, 4>, 4>>("KWayEH-4-descent"));
+        this->addAnalyzer(std::make_unique<KWayDescentAnalyzer<amt::InlineKWayEH<int, 4>, 4>>("InlineKWayEH-4-descent"));
+        this->addAnalyzer(std::make_unique<KWayDescentAnalyzer<amt::KWayEH<int, 16>, 16>>("KWayEH-16-descent"));
+        this->addAnalyzer(std::make_unique<KWayDescentAnalyzer<amt::InlineKWayEH<int, 16>, 16>>("InlineKWayEH-16-descent"));
+        this->addAnalyzer(std::make_unique<KWayDescentAnalyzer<amt::KWayEH<int, 256>, 256>>("KWayEH-256-descent"));
+        this->addAnalyzer(std::make_unique<KWayDescentAnalyzer<amt::InlineKWayEH<int, 256>, 256>>("InlineKWayEH-256-descent"));
+        this->addAnalyzer(std::make_unique<KWayTraversalAnalyzer<amt::KWayEH<int, 2>, 2>>("KWayEH-2-traversal"));
+        this->addAnalyzer(std::make_unique<KWayTraversalAnalyzer<amt::InlineKWayEH<int, 2>, 2>>("InlineKWayEH-2-traversal"));
+        this->addAnalyzer(std::make_unique<KWayTraversalAnalyzer<amt::KWayEH<int, 4>, 4>>("KWayEH-4-traversal"));
+        this->addAnalyzer(std::make_unique<KWayTraversalAnalyzer<amt::InlineKWayEH<int, 4>, 4>>("InlineKWayEH-4-traversal"));
+        this->addAnalyzer(std::make_unique<KWayTraversalAnalyzer<amt::KWayEH<int, 16>, 16>>("KWayEH-16-traversal"));
+        this->addAnalyzer(std::make_unique<KWayTraversalAnalyzer<amt::InlineKWayEH<int, 16>, 16>>("InlineKWayEH-16-traversal"));
+        this->addAnalyzer(std::make_unique<KWayTraversalAnalyzer<amt::KWayEH<int, 256>, 256>>("KWayEH-256-traversal"));
+        this->addAnalyzer(std::make_unique<KWayTraversalAnalyzer<amt::InlineKWayEH<int, 256>, 256>>("InlineKWayEH-256-traversal"));
+    }
+}
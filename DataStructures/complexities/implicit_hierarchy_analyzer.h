@@ -0,0 +1,168 @@
+#pragma once
+
+#include <complexities/complexity_analyzer.h>
+#include <libds/adt/priority_queue.h>
+#include <libds/amt/implicit_hierarchy.h>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace ds::utils
+{
+    /**
+     * @brief Sizes of implicit hierarchy analyzers are multiplied by NODES_PER_SIZE_UNIT, so the default steps end
+     *        at 25.6 million nodes (102 MB of int blocks), well beyond the last level cache.
+     */
+    struct ImplicitHierarchyAnalysis
+    {
+        static const size_t NODES_PER_SIZE_UNIT = 256;
+    };
+
+    /**
+     * @brief Measures SEARCH_COUNT searches for random keys in an implicit binary search tree.
+     * @details Keys are placed in in-order, so the tree is a complete binary search tree. Every search descends
+     *          from the root to a leaf unless it finds its key, which is where layouts differ.
+     */
+    template<typename Layout>
+    class ImplicitTreeSearchAnalyzer : public ComplexityAnalyzer<amt::BinaryIH<int, Layout>>
+    {
+    public:
+        static const size_t SEARCH_COUNT = 1000;
+
+        explicit ImplicitTreeSearchAnalyzer(const std::string& name);
+
+    protected:
+        void growToSize(amt::BinaryIH<int, Layout>& structure, size_t size) override;
+        void executeOperation(amt::BinaryIH<int, Layout>& structure) override;
+
+    private:
+        std::default_random_engine rngKeys_;
+        std::vector<int> keys_;
+        size_t foundCount_;
+    };
+
+    /**
+     * @brief Measures HEAP_OPERATION_COUNT pairs of pop and push of a random priority in a binary heap.
+     */
+    template<typename Layout>
+    class BinaryHeapAnalyzer : public ComplexityAnalyzer<adt::BinaryHeap<int, int, Layout>>
+    {
+    public:
+        static const size_t HEAP_OPERATION_COUNT = 100;
+
+        explicit BinaryHeapAnalyzer(const std::string& name);
+
+    protected:
+        void growToSize(adt::BinaryHeap<int, int, Layout>& structure, size_t size) override;
+        void executeOperation(adt::BinaryHeap<int, int, Layout>& structure) override;
+
+    private:
+        std::default_random_engine rngPriority_;
+    };
+
+    /**
+     * @brief Container for all implicit hierarchy analyzers.
+     */
+    class ImplicitHierarchiesAnalyzer : public CompositeAnalyzer
+    {
+    public:
+        ImplicitHierarchiesAnalyzer();
+    };
+
+    //----------
+
+    template<typename Layout>
+    ImplicitTreeSearchAnalyzer<Layout>::ImplicitTreeSearchAnalyzer(const std::string& name) :
+        ComplexityAnalyzer<amt::BinaryIH<int, Layout>>(name),
+        rngKeys_(144),
+        foundCount_(0)
+    {
+    }
+
+    template<typename Layout>
+    void ImplicitTreeSearchAnalyzer<Layout>::growToSize(amt::BinaryIH<int, Layout>& structure, size_t size)
+    {
+        const size_t nodeCount = size * ImplicitHierarchyAnalysis::NODES_PER_SIZE_UNIT;
+        while (structure.size() < nodeCount)
+        {
+            structure.insertLastLeaf();
+        }
+
+        // Even keys in in-order, searched keys are hits and misses alike.
+        int nextKey = 0;
+        std::function<void(amt::MemoryBlock<int>*)> placeKeys;
+        placeKeys = [&structure, &nextKey, &placeKeys](amt::MemoryBlock<int>* node)
+        {
+            if (node != nullptr)
+            {
+                placeKeys(structure.accessLeftSon(*node));
+                node->data_ = nextKey;
+                nextKey += 2;
+                placeKeys(structure.accessRightSon(*node));
+            }
+        };
+        placeKeys(structure.accessRoot());
+
+        keys_.resize(SEARCH_COUNT);
+        for (int& key : keys_)
+        {
+            key = static_cast<int>(rngKeys_() % static_cast<size_t>(nextKey));
+        }
+    }
+
+    template<typename Layout>
+    void ImplicitTreeSearchAnalyzer<Layout>::executeOperation(amt::BinaryIH<int, Layout>& structure)
+    {
+        for (const int key : keys_)
+        {
+            amt::MemoryBlock<int>* node = structure.accessRoot();
+            while (node != nullptr && node->data_ != key)
+            {
+                // The son is chosen without a branch, so the next level is not loaded speculatively
+                // and only the layout decides how long a descent waits for memory.
+                node = structure.accessSon(*node, key > node->data_ ? 1 : 0);
+            }
+            foundCount_ += node != nullptr ? 1 : 0;
+        }
+    }
+
+    template<typename Layout>
+    BinaryHeapAnalyzer<Layout>::BinaryHeapAnalyzer(const std::string& name) :
+        ComplexityAnalyzer<adt::BinaryHeap<int, int, Layout>>(name),
+        rngPriority_(144)
+    {
+    }
+
+    template<typename Layout>
+    void BinaryHeapAnalyzer<Layout>::growToSize(adt::BinaryHeap<int, int, Layout>& structure, size_t size)
+    {
+        const size_t nodeCount = size * ImplicitHierarchyAnalysis::NODES_PER_SIZE_UNIT;
+        while (structure.size() < nodeCount)
+        {
+            structure.push(static_cast<int>(rngPriority_() % 1'000'000'000), 0);
+        }
+    }
+
+    template<typename Layout>
+    void BinaryHeapAnalyzer<Layout>::executeOperation(adt::BinaryHeap<int, int, Layout>& structure)
+    {
+        for (size_t i = 0; i < HEAP_OPERATION_COUNT; ++i)
+        {
+            const int data = structure.pop();
+            structure.push(static_cast<int>(rngPriority_() % 1'000'000'000), data);
+        }
+    }
+
+    //----------
+
+    inline ImplicitHierarchiesAnalyzer::ImplicitHierarchiesAnalyzer() :
+        CompositeAnalyzer("ImplicitHierarchies")
+    {
+        this->addAnalyzer(std::make_unique<ImplicitTreeSearchAnalyzer<amt::BreadthFirstLayout>>("ImplicitTree-search-bfs"));
+        this->addAnalyzer(std::make_unique<ImplicitTreeSearchAnalyzer<amt::EytzingerLayout>>("ImplicitTree-search-eytzinger"));
+        this->addAnalyzer(std::make_unique<ImplicitTreeSearchAnalyzer<amt::VanEmdeBoasLayout>>("ImplicitTree-search-veb"));
+        this->addAnalyzer(std::make_unique<BinaryHeapAnalyzer<amt::BreadthFirstLayout>>("BinaryHeap-pop-push-bfs"));
+        this->addAnalyzer(std::make_unique<BinaryHeapAnalyzer<amt::EytzingerLayout>>("BinaryHeap-pop-push-eytzinger"));
+        this->addAnalyzer(std::make_unique<BinaryHeapAnalyzer<amt::VanEmdeBoasLayout>>("BinaryHeap-pop-push-veb"));
+    }
+}
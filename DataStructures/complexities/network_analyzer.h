@@ -0,0 +1,151 @@
+#pragma once
+
+#include <complexities/complexity_analyzer.h>
+#include <libds/amt/compressed_network.h>
+#include <libds/amt/explicit_network.h>
+#include <libds/graph/graph_view.h>
+#include <libds/graph/breadth_first_search.h>
+#include <libds/graph/shortest_paths.h>
+#include <libds/graph/connected_components.h>
+#include <cstdlib>
+#include <random>
+
+namespace ds::utils
+{
+    /**
+     * @brief Measures a graph algorithm on a random network.
+     * @details The size is the number of nodes; every node has AVERAGE_DEGREE relations on average, so the default
+     *          steps end at 1.6 million relations. Relations processed per second are size * AVERAGE_DEGREE divided
+     *          by the measured duration. The network is frozen before the measurement, so the algorithm runs on
+     *          the compressed form without any conversion.
+     */
+    class NetworkAnalyzer : public ComplexityAnalyzer<amt::CompressedNetwork<int>>
+    {
+    public:
+        static const size_t AVERAGE_DEGREE = 16;
+
+    protected:
+        explicit NetworkAnalyzer(const std::string& name);
+
+        void growToSize(amt::CompressedNetwork<int>& structure, size_t size) override;
+
+    private:
+        std::default_random_engine rngData_;
+    };
+
+    /**
+     * @brief Direction-optimizing parallel BFS from the first node.
+     */
+    class BreadthFirstSearchAnalyzer : public NetworkAnalyzer
+    {
+    public:
+        BreadthFirstSearchAnalyzer();
+
+    protected:
+        void executeOperation(amt::CompressedNetwork<int>& structure) override;
+    };
+
+    /**
+     * @brief Delta-stepping shortest paths from the first node, relation weights are derived from node data.
+     */
+    class ShortestPathsAnalyzer : public NetworkAnalyzer
+    {
+    public:
+        ShortestPathsAnalyzer();
+
+    protected:
+        void executeOperation(amt::CompressedNetwork<int>& structure) override;
+    };
+
+    /**
+     * @brief Connected components by parallel union-find.
+     */
+    class ConnectedComponentsAnalyzer : public NetworkAnalyzer
+    {
+    public:
+        ConnectedComponentsAnalyzer();
+
+    protected:
+        void executeOperation(amt::CompressedNetwork<int>& structure) override;
+    };
+
+    /**
+     * @brief Container for all network analyzers.
+     */
+    class NetworksAnalyzer : public CompositeAnalyzer
+    {
+    public:
+        NetworksAnalyzer();
+    };
+
+    //----------
+
+    inline NetworkAnalyzer::NetworkAnalyzer(const std::string& name) :
+        ComplexityAnalyzer<amt::CompressedNetwork<int>>(name),
+        rngData_(144)
+    {
+    }
+
+    inline void NetworkAnalyzer::growToSize(amt::CompressedNetwork<int>& structure, size_t size)
+    {
+        amt::IGIRNetwork<int> network;
+        for (size_t i = 0; i < size; ++i)
+        {
+            network.insert().data_ = static_cast<int>(rngData_() % 1000);
+        }
+
+        const size_t connectionCount = size * AVERAGE_DEGREE / 2;
+        for (size_t i = 0; i < connectionCount; ++i)
+        {
+            network.connect(*network.accessNodeFromGate(rngData_() % size), *network.accessNodeFromGate(rngData_() % size));
+        }
+
+        structure.assign(network.freeze());
+    }
+
+    inline BreadthFirstSearchAnalyzer::BreadthFirstSearchAnalyzer() :
+        NetworkAnalyzer("Network-bfs")
+    {
+    }
+
+    inline void BreadthFirstSearchAnalyzer::executeOperation(amt::CompressedNetwork<int>& structure)
+    {
+        graph::GraphView<int> view(structure);
+        graph::BreadthFirstSearch().run(view, 0);
+    }
+
+    inline ShortestPathsAnalyzer::ShortestPathsAnalyzer() :
+        NetworkAnalyzer("Network-delta-stepping")
+    {
+    }
+
+    inline void ShortestPathsAnalyzer::executeOperation(amt::CompressedNetwork<int>& structure)
+    {
+        graph::GraphView<int> view(structure);
+        graph::DeltaSteppingShortestPaths(1.0).run(view, 0, [](const int& from, const int& to)
+            {
+                return static_cast<double>(std::abs(from - to) % 23) / 8.0;
+            });
+    }
+
+    inline ConnectedComponentsAnalyzer::ConnectedComponentsAnalyzer() :
+        NetworkAnalyzer("Network-components")
+    {
+    }
+
+    inline void ConnectedComponentsAnalyzer::executeOperation(amt::CompressedNetwork<int>& structure)
+    {
+        graph::GraphView<int> view(structure);
+        graph::ConnectedComponents().run(view);
+    }
+
+    //----------
+
+    inline NetworksAnalyzer::NetworksAnalyzer() :
+        CompositeAnalyzer("Networks")
+    {
+        this->addAnalyzer(std::make_unique<BreadthFirstSearchAnalyzer>());
+        this->addAnalyzer(std::make_unique<ShortestPathsAnalyzer>());
+        this->addAnalyzer(std::make_unique<ConnectedComponentsAnalyzer>());
+    }
+}
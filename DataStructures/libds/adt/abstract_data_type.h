@@ -1,8 +1,10 @@
 #pragma once
 
 #include <libds/amt/abstract_memory_type.h>
+#include <iterator>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 
 namespace ds::adt {
 
@@ -16,6 +18,37 @@ namespace ds::adt {
 
     //----------
 
+    /**
+     * @brief Length of [first, last) if it can be computed without consuming the range, otherwise 0.
+     * Used by bulk insertions to reserve capacity once.
+     */
+    template<typename Iterator>
+    size_t knownRangeLength(Iterator first, Iterator last);
+
+    //----------
+
+    /**
+     * @brief Non-owning reference to a function that returns a new element.
+     * The element is returned as a prvalue, so calling the factory in the initialiser of the place where a
+     * structure keeps the element constructs it right there, without a copy or a move. Virtual methods take
+     * it where a template parameter pack cannot be passed.
+     */
+    template<typename T>
+    class ElementFactory
+    {
+    public:
+        template<typename Function>
+        explicit ElementFactory(const Function& function);
+
+        T operator()() const;
+
+    private:
+        const void* function_;
+        T (*call_)(const void* function);
+    };
+
+    //----------
+
     class AbstractDataType
     {
     public:
@@ -67,6 +100,40 @@ namespace ds::adt {
 
     //----------
 
+    template<typename Iterator, typename = void>
+    struct IsForwardIterator : std::false_type {};
+
+    template<typename Iterator>
+    struct IsForwardIterator<Iterator, std::void_t<typename std::iterator_traits<Iterator>::iterator_category>> :
+        std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category> {};
+
+    template<typename Iterator>
+    size_t knownRangeLength(Iterator first, Iterator last)
+    {
+        if constexpr (IsForwardIterator<Iterator>::value)
+        {
+            return static_cast<size_t>(std::distance(first, last));
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    template<typename T>
+    template<typename Function>
+    ElementFactory<T>::ElementFactory(const Function& function) :
+        function_(&function),
+        call_([](const void* function) -> T { return (*static_cast<const Function*>(function))(); })
+    {
+    }
+
+    template<typename T>
+    T ElementFactory<T>::operator()() const
+    {
+        return call_(function_);
+    }
+
     template<typename T>
     AbstractDataStructure<T>::AbstractDataStructure(amt::AMT* memoryStructure) :
         memoryStructure_(memoryStructure)
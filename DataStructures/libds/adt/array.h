@@ -2,6 +2,7 @@
 
 #include <libds/adt/abstract_data_type.h>
 #include <libds/amt/implicit_sequence.h>
+#include <utility>
 
 namespace ds::adt {
 
@@ -214,7 +215,7 @@ namespace ds::adt {
             throw std::out_of_range("Invalid index!");
         }
 
-        this->getSequence()->access(this->mapIndex(index))->data_ = element;
+        this->getSequence()->access(this->mapIndex(index))->data_ = std::move(element);
     }
 
     template <typename T>
@@ -342,7 +343,7 @@ namespace ds::adt {
             throw std::out_of_range("Invalid index!");
         }
         size_t mappedIndex = this->mapIndices(index1, index2);
-        this->getSequence()->access(mappedIndex)->data_ = element;
+        this->getSequence()->access(mappedIndex)->data_ = std::move(element);
     }
 
     template<typename T>
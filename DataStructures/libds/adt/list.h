@@ -3,6 +3,7 @@
 #include <libds/adt/abstract_data_type.h>
 #include <libds/amt/implicit_sequence.h>
 #include <libds/amt/explicit_sequence.h>
+#include <utility>
 
 namespace ds::adt {
 
@@ -58,6 +59,25 @@ namespace ds::adt {
 
         void set(size_t index, T element) override;
 
+        /**
+         * @brief Constructs the element from args right in its block of the list.
+         * @return Reference to the inserted element.
+         */
+        template<typename... Args>
+        T& emplaceFirst(Args&&... args);
+
+        template<typename... Args>
+        T& emplaceLast(Args&&... args);
+
+        template<typename... Args>
+        T& emplace(size_t index, Args&&... args);
+
+        /**
+         * @brief Appends all elements of [first, last). Implicit lists grow their capacity at most once.
+         */
+        template<typename InputIterator>
+        void insertRange(InputIterator first, InputIterator last);
+
         void removeFirst() override;
         void removeLast() override;
         void remove(size_t index) override;
@@ -199,13 +219,13 @@ namespace ds::adt {
     template<typename T, typename SequenceType>
     void GeneralList<T, SequenceType>::insertFirst(T element)
     {
-        this->getSequence()->insertFirst().data_ = element;
+        this->getSequence()->insertFirstFrom([&element]() { return std::move(element); });
     }
 
     template<typename T, typename SequenceType>
     void GeneralList<T, SequenceType>::insertLast(T element)
     {
-        this->getSequence()->insertLast().data_ = element;
+        this->getSequence()->insertLastFrom([&element]() { return std::move(element); });
     }
 
     template<typename T, typename SequenceType>
@@ -216,7 +236,7 @@ namespace ds::adt {
             throw std::out_of_range("Invalid index!");
         }
 
-        this->getSequence()->insert(index).data_ = element;
+        this->getSequence()->insertFrom(index, [&element]() { return std::move(element); });
     }
 
     template<typename T, typename SequenceType>
@@ -229,7 +249,53 @@ namespace ds::adt {
             throw std::out_of_range("Invalid index!");
         }
 
-        block->data_ = element;
+        block->data_ = std::move(element);
+    }
+
+    template<typename T, typename SequenceType>
+    template<typename... Args>
+    T& GeneralList<T, SequenceType>::emplaceFirst(Args&&... args)
+    {
+        return this->getSequence()->insertFirstFrom([&]() { return T(std::forward<Args>(args)...); }).data_;
+    }
+
+    template<typename T, typename SequenceType>
+    template<typename... Args>
+    T& GeneralList<T, SequenceType>::emplaceLast(Args&&... args)
+    {
+        return this->getSequence()->insertLastFrom([&]() { return T(std::forward<Args>(args)...); }).data_;
+    }
+
+    template<typename T, typename SequenceType>
+    template<typename... Args>
+    T& GeneralList<T, SequenceType>::emplace(size_t index, Args&&... args)
+    {
+        if (index > this->size())
+        {
+            throw std::out_of_range("Invalid index!");
+        }
+
+        return this->getSequence()->insertFrom(index, [&]() { return T(std::forward<Args>(args)...); }).data_;
+    }
+
+    template<typename T, typename SequenceType>
+    template<typename InputIterator>
+    void GeneralList<T, SequenceType>::insertRange(InputIterator first, InputIterator last)
+    {
+        SequenceType* sequence = this->getSequence();
+        if constexpr (std::is_base_of_v<amt::ImplicitAMS<T>, SequenceType>)
+        {
+            const size_t required = this->size() + knownRangeLength(first, last);
+            if (required > sequence->getCapacity())
+            {
+                sequence->changeCapacity(required);
+            }
+        }
+
+        for (; first != last; ++first)
+        {
+            sequence->insertLastFrom([&first]() { return *first; });
+        }
     }
 
     template<typename T, typename SequenceType>
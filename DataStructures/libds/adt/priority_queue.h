@@ -6,6 +6,7 @@
 #include <libds/amt/implicit_hierarchy.h>
 #include <cmath>
 #include <functional>
+#include <utility>
 
 namespace ds::adt {
 
@@ -208,7 +209,10 @@ namespace ds::adt {
 
     //----------
 
-    template<typename P, typename T>
+    /**
+     * @brief Binary heap stored in an implicit hierarchy, Layout is its layout policy (see amt::BreadthFirstLayout).
+     */
+    template<typename P, typename T, typename Layout = amt::BreadthFirstLayout>
     class BinaryHeap :
             public PriorityQueue<P, T>,
             public ADS<PQItem<P, T>> {
@@ -226,9 +230,10 @@ namespace ds::adt {
         T pop() override;
 
     private:
-        using HierarchyBlockType = typename amt::BinaryIH<PQItem<P, T>>::BlockType;
+        using HierarchyType = amt::BinaryIH<PQItem<P, T>, Layout>;
+        using HierarchyBlockType = typename HierarchyType::BlockType;
 
-        amt::BinaryIH<PQItem<P, T>> *getHierarchy();
+        HierarchyType *getHierarchy();
     };
 
     //----------
@@ -293,7 +298,7 @@ namespace ds::adt {
         }
 
         size_t index = this->indexOfHighestPriorityBlock();
-        T result = this->getSequence()->access(index)->data_.data_;
+        T result = std::move(this->getSequence()->access(index)->data_.data_);
         this->getSequence()->remove(index);
         return result;
     }
@@ -302,7 +307,7 @@ namespace ds::adt {
     void UnsortedImplicitSequencePriorityQueue<P, T>::push(P priority, T data) {
         PQItem<P, T> &queueData = this->getSequence()->insertLast().data_;
         queueData.priority_ = priority;
-        queueData.data_ = data;
+        queueData.data_ = std::move(data);
     }
 
     template<typename P, typename T>
@@ -312,7 +317,7 @@ namespace ds::adt {
         }
 
         SequenceBlockType *bestBlock = this->findHighestPriorityBlock();
-        T result = bestBlock->data_.data_;
+        T result = std::move(bestBlock->data_.data_);
         SequenceBlockType *lastBlock = this->getSequence()->accessLast();
         if (bestBlock != lastBlock) {
             using std::swap;
@@ -326,7 +331,7 @@ namespace ds::adt {
     void UnsortedExplicitSequencePriorityQueue<P, T>::push(P priority, T data) {
         PQItem<P, T> &queueData = this->getSequence()->insertFirst().data_;
         queueData.priority_ = priority;
-        queueData.data_ = data;
+        queueData.data_ = std::move(data);
     }
 
     template<typename P, typename T>
@@ -336,7 +341,7 @@ namespace ds::adt {
         }
 
         SequenceBlockType *bestBlock = this->findHighestPriorityBlock();
-        T result = bestBlock->data_.data_;
+        T result = std::move(bestBlock->data_.data_);
         SequenceBlockType *firstBlock = this->getSequence()->accessFirst();
         if (bestBlock != firstBlock) {
             using std::swap;
@@ -362,7 +367,7 @@ namespace ds::adt {
         }
 
         queueData->priority_ = priority;
-        queueData->data_ = data;
+        queueData->data_ = std::move(data);
     }
 
     template<typename P, typename T>
@@ -387,7 +392,7 @@ namespace ds::adt {
         }
 
         queueData->priority_ = priority;
-        queueData->data_ = data;
+        queueData->data_ = std::move(data);
     }
 
     template<typename P, typename T>
@@ -483,7 +488,7 @@ namespace ds::adt {
             queueData = &longSequence_->insertLast().data_;
         }
         queueData->priority_ = priority;
-        queueData->data_ = data;
+        queueData->data_ = std::move(data);
     }
 
     template<typename P, typename T>
@@ -501,7 +506,7 @@ namespace ds::adt {
         if (this->isEmpty()) {
             throw structure_error("Queue is empty!");
         }
-        T result = this->shortSequence_->accessLast()->data_.data_;
+        T result = std::move(this->shortSequence_->accessLast()->data_.data_);
         this->shortSequence_->removeLast();
         if (this->shortSequence_->size() == 0 && this->longSequence_->size() > 0) {
             LongSequenceType * oldLongSequence = this->longSequence_;
@@ -517,30 +522,30 @@ namespace ds::adt {
         return result;
     }
 
-    template<typename P, typename T>
-    BinaryHeap<P, T>::BinaryHeap() :
-        ADS<PQItem<P, T>>(new amt::BinaryIH<PQItem<P, T>>())
+    template<typename P, typename T, typename Layout>
+    BinaryHeap<P, T, Layout>::BinaryHeap() :
+        ADS<PQItem<P, T>>(new HierarchyType())
     {
     }
 
-    template<typename P, typename T>
-    BinaryHeap<P, T>::BinaryHeap(const BinaryHeap& other) :
-        ADS<PQItem<P, T>>(new amt::BinaryIH<PQItem<P, T>>(), other)
+    template<typename P, typename T, typename Layout>
+    BinaryHeap<P, T, Layout>::BinaryHeap(const BinaryHeap& other) :
+        ADS<PQItem<P, T>>(new HierarchyType(), other)
     {
     }
 
-    template<typename P, typename T>
-    inline bool BinaryHeap<P, T>::equals(const ADT& other)
+    template<typename P, typename T, typename Layout>
+    inline bool BinaryHeap<P, T, Layout>::equals(const ADT& other)
     {
         throw std::logic_error("Unsupported operation!");
     }
 
-    template<typename P, typename T>
-    void BinaryHeap<P, T>::push(P priority, T data)
+    template<typename P, typename T, typename Layout>
+    void BinaryHeap<P, T, Layout>::push(P priority, T data)
     {
         PQItem<P, T>& queueData = this->getHierarchy()->insertLastLeaf().data_;
         queueData.priority_ = priority;
-        queueData.data_ = data;
+        queueData.data_ = std::move(data);
 
         HierarchyBlockType* currentBlock = this->getHierarchy()->accessLastLeaf();
         HierarchyBlockType* blockParent = this->getHierarchy()->accessParent(*currentBlock);
@@ -555,8 +560,8 @@ namespace ds::adt {
         }
     }
 
-    template<typename P, typename T>
-    T& BinaryHeap<P, T>::peek()
+    template<typename P, typename T, typename Layout>
+    T& BinaryHeap<P, T, Layout>::peek()
     {
         if (this->isEmpty())
         {
@@ -566,8 +571,8 @@ namespace ds::adt {
         return this->getHierarchy()->accessRoot()->data_.data_;
     }
 
-    template<typename P, typename T>
-    T BinaryHeap<P, T>::pop()
+    template<typename P, typename T, typename Layout>
+    T BinaryHeap<P, T, Layout>::pop()
     {
         if (this->isEmpty())
         {
@@ -576,7 +581,7 @@ namespace ds::adt {
 
         HierarchyBlockType* currentBlock = this->getHierarchy()->accessRoot();
 
-        T result = currentBlock->data_.data_;
+        T result = std::move(currentBlock->data_.data_);
         using std::swap;
         swap(currentBlock->data_, this->getHierarchy()->accessLastLeaf()->data_);
         this->getHierarchy()->removeLastLeaf();
@@ -606,10 +611,10 @@ namespace ds::adt {
         return result;
     }
 
-    template<typename P, typename T>
-    amt::BinaryIH<PQItem<P, T>>* BinaryHeap<P, T>::getHierarchy()
+    template<typename P, typename T, typename Layout>
+    auto BinaryHeap<P, T, Layout>::getHierarchy() -> HierarchyType*
     {
-        return dynamic_cast<amt::BinaryIH<PQItem<P, T>>*>(this->memoryStructure_);
+        return dynamic_cast<HierarchyType*>(this->memoryStructure_);
     }
 
 }
\ No newline at end of file
@@ -3,6 +3,12 @@
 #include <libds/adt/abstract_data_type.h>
 #include <libds/amt/implicit_sequence.h>
 #include <libds/amt/explicit_sequence.h>
+#include <libds/amt/chunked_sequence.h>
+#include <libds/constants.h>
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+#include <utility>
 
 namespace ds::adt {
 
@@ -14,6 +20,27 @@ namespace ds::adt {
         virtual void push(T element) = 0;
         virtual T& peek() = 0;
         virtual T pop() = 0;
+
+        /**
+         * @brief Pushes the element constructed from args right where the queue keeps it.
+         */
+        template<typename... Args>
+        void emplace(Args&&... args);
+
+        template<typename InputIterator>
+        void pushRange(InputIterator first, InputIterator last);
+
+    protected:
+        /**
+         * @brief Pushes the element returned by factory. Queues override it to create the element in place,
+         * the default implementation moves it in by push.
+         */
+        virtual void pushFrom(const ElementFactory<T>& factory);
+
+        /**
+         * @brief Called by pushRange before it pushes count elements, count is 0 if the length is not known.
+         */
+        virtual void reserveRange(size_t count);
     };
 
     //----------
@@ -41,7 +68,18 @@ namespace ds::adt {
 
         static const int INIT_CAPACITY = 100;
 
+    protected:
+        void pushFrom(const ElementFactory<T>& factory) override;
+
+        /**
+         * @brief Throws if count more elements do not fit, so pushRange pushes all of them or none.
+         */
+        void reserveRange(size_t count) override;
+
     private:
+        template<typename Factory>
+        void pushWith(const Factory& factory);
+
         amt::CIS<T>* getSequence() const;
 
     private:
@@ -64,12 +102,215 @@ namespace ds::adt {
         T& peek() override;
         T pop() override;
 
+    protected:
+        void pushFrom(const ElementFactory<T>& factory) override;
+
     private:
         amt::SinglyLS<T>* getSequence() const;
     };
 
     //----------
 
+    /**
+     * @brief Queue stored in a chunked sequence: one allocation per ChunkSize elements instead of one per element.
+     */
+    template<typename T, size_t ChunkSize = 128>
+    class ChunkedQueue :
+        public Queue<T>,
+        public ADS<T>
+    {
+    public:
+        ChunkedQueue();
+        ChunkedQueue(const ChunkedQueue& other);
+        void push(T element) override;
+        T& peek() override;
+        T pop() override;
+
+    protected:
+        void pushFrom(const ElementFactory<T>& factory) override;
+
+    private:
+        amt::ChunkedSequence<T, ChunkSize>* getSequence() const;
+    };
+
+    //----------
+
+    /**
+     * @brief Smallest power of two (at least 2) that is not less than capacity.
+     */
+    inline size_t roundQueueCapacity(size_t capacity);
+
+    //----------
+
+    template<typename T>
+    struct ConcurrentQueueSlot
+    {
+        ConcurrentQueueSlot() : sequence_(0), data_() {}
+
+        std::atomic<size_t> sequence_;
+        T data_;
+    };
+
+    /**
+     * @brief Bounded multi-producer/multi-consumer queue (D. Vyukov).
+     *
+     * Each slot of the cyclic sequence carries a sequence number telling producers and consumers
+     * whether the slot is free for the current lap, so push and pop need a single CAS on the shared index.
+     * Capacity is rounded up to a power of two. Methods of the Queue interface, assign, equals and copy
+     * are meant for single-threaded use; concurrent code should use tryPush and tryPop.
+     * Slots hold atomics, which must not be moved by a memory manager, and the capacity never changes, so
+     * the slots are one array allocated in the constructor.
+     */
+    template<typename T>
+    class ConcurrentBoundedQueue :
+        public Queue<T>
+    {
+    public:
+        ConcurrentBoundedQueue();
+        ConcurrentBoundedQueue(const ConcurrentBoundedQueue& other);
+        ConcurrentBoundedQueue(size_t capacity);
+        ~ConcurrentBoundedQueue() override;
+
+        ConcurrentBoundedQueue& operator=(const ConcurrentBoundedQueue& other) = delete;
+
+        size_t getCapacity() const;
+
+        ADT& assign(const ADT& other) override;
+        void clear() override;
+        size_t size() const override;
+        bool isEmpty() const override;
+        bool equals(const ADT& other) override;
+
+        void push(T element) override;
+        T& peek() override;
+        T pop() override;
+
+        bool tryPush(const T& element);
+        bool tryPop(T& element);
+
+        static const int INIT_CAPACITY = 128;
+
+    protected:
+        void pushFrom(const ElementFactory<T>& factory) override;
+
+    private:
+        using SlotType = ConcurrentQueueSlot<T>;
+
+        /**
+         * @brief Moves element into a claimed slot. The element is created before the slot is claimed and
+         * moving it must not throw, because a claimed slot has to be published for the threads waiting for it.
+         */
+        bool tryPushCreated(T& element);
+
+        SlotType& accessSlot(size_t position) const;
+
+    private:
+        SlotType* slots_;
+        size_t mask_;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueuePosition_;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeuePosition_;
+    };
+
+    //----------
+
+    /**
+     * @brief Bounded single-producer/single-consumer ring queue.
+     *
+     * The producer owns the tail index and the consumer owns the head index, so both sides only load and store
+     * atomics (no read-modify-write). Each side keeps a cached copy of the other's index and rereads it only
+     * when the cached value says the queue is full/empty. pushBatch and popBatch move a whole run of elements
+     * and publish the new index once. Capacity is rounded up to a power of two. Methods of the Queue interface,
+     * assign, equals and copy are meant for single-threaded use.
+     */
+    template<typename T>
+    class SpscRingQueue :
+        public Queue<T>,
+        public ADS<T>
+    {
+    public:
+        SpscRingQueue();
+        SpscRingQueue(const SpscRingQueue& other);
+        SpscRingQueue(size_t capacity);
+
+        size_t getCapacity() const;
+
+        ADT& assign(const ADT& other) override;
+        void clear() override;
+        size_t size() const override;
+        bool equals(const ADT& other) override;
+
+        void push(T element) override;
+        T& peek() override;
+        T pop() override;
+
+        bool tryPush(const T& element);
+        bool tryPop(T& element);
+
+        /**
+         * @brief Pushes up to count elements; returns the number of elements that fitted. Producer only.
+         */
+        size_t pushBatch(const T* elements, size_t count);
+
+        /**
+         * @brief Pops up to maxCount elements into output; returns the number of popped elements. Consumer only.
+         */
+        size_t popBatch(T* output, size_t maxCount);
+
+        static const int INIT_CAPACITY = 128;
+
+    protected:
+        void pushFrom(const ElementFactory<T>& factory) override;
+
+    private:
+        using BlockType = amt::MemoryBlock<T>;
+
+        template<typename Factory>
+        bool tryPushWith(const Factory& factory);
+
+        amt::CIS<T>* getSequence() const;
+        size_t freeForProducer(size_t tail, size_t needed);
+        size_t availableForConsumer(size_t head, size_t needed);
+
+    private:
+        BlockType* elements_;
+        size_t mask_;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_;
+        size_t cachedHead_;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_;
+        size_t cachedTail_;
+    };
+
+    //----------
+
+    template<typename T>
+    template<typename... Args>
+    void Queue<T>::emplace(Args&&... args)
+    {
+        this->pushFrom(ElementFactory<T>([&]() { return T(std::forward<Args>(args)...); }));
+    }
+
+    template<typename T>
+    template<typename InputIterator>
+    void Queue<T>::pushRange(InputIterator first, InputIterator last)
+    {
+        this->reserveRange(knownRangeLength(first, last));
+        for (; first != last; ++first)
+        {
+            this->push(*first);
+        }
+    }
+
+    template<typename T>
+    void Queue<T>::pushFrom(const ElementFactory<T>& factory)
+    {
+        this->push(factory());
+    }
+
+    template<typename T>
+    void Queue<T>::reserveRange(size_t)
+    {
+    }
+
     template<typename T>
     ImplicitQueue<T>::ImplicitQueue():
         ImplicitQueue(INIT_CAPACITY)
@@ -164,15 +405,36 @@ namespace ds::adt {
 
     template<typename T>
     void ImplicitQueue<T>::push(T element)
+    {
+        this->pushWith([&element]() { return std::move(element); });
+    }
+
+    template<typename T>
+    void ImplicitQueue<T>::pushFrom(const ElementFactory<T>& factory)
+    {
+        this->pushWith(factory);
+    }
+
+    template<typename T>
+    template<typename Factory>
+    void ImplicitQueue<T>::pushWith(const Factory& factory)
     {
         if (size_ == this->getSequence()->size()) {
             throw structure_error("Queue is full!");
         }
-        this->getSequence()->access(insertionIndex_)->data_ = element;
+        placement_recreate(&this->getSequence()->access(insertionIndex_)->data_, factory);
         insertionIndex_ = this->getSequence()->indexOfNext(insertionIndex_);
         size_++;
     }
 
+    template<typename T>
+    void ImplicitQueue<T>::reserveRange(size_t count)
+    {
+        if (size_ + count > this->getCapacity()) {
+            throw structure_error("Queue is full!");
+        }
+    }
+
     template<typename T>
     T& ImplicitQueue<T>::peek()
     {
@@ -188,7 +450,7 @@ namespace ds::adt {
         if (this->isEmpty()) {
             throw structure_error("Queue is empty!");
         }
-        T result = this->getSequence()->access(removalIndex_)->data_;
+        T result = std::move(this->getSequence()->access(removalIndex_)->data_);
         removalIndex_ = this->getSequence()->indexOfNext(removalIndex_);
         size_--;
         return result;
@@ -215,7 +477,13 @@ namespace ds::adt {
     template<typename T>
     void ExplicitQueue<T>::push(T element)
     {
-        this->getSequence()->insertLast().data_ = element;
+        this->getSequence()->insertLastFrom([&element]() { return std::move(element); });
+    }
+
+    template<typename T>
+    void ExplicitQueue<T>::pushFrom(const ElementFactory<T>& factory)
+    {
+        this->getSequence()->insertLastFrom(factory);
     }
 
     template<typename T>
@@ -237,7 +505,7 @@ namespace ds::adt {
             throw std::out_of_range("Queue is empty!");
         }
 
-        T result = this->getSequence()->accessFirst()->data_;
+        T result = std::move(this->getSequence()->accessFirst()->data_);
         this->getSequence()->removeFirst();
         return result;
     }
@@ -247,4 +515,549 @@ namespace ds::adt {
     {
         return dynamic_cast<amt::SinglyLS<T>*>(this->memoryStructure_);
     }
-}
\ No newline at end of file
+
+    template<typename T, size_t ChunkSize>
+    ChunkedQueue<T, ChunkSize>::ChunkedQueue() :
+        ADS<T>(new amt::ChunkedSequence<T, ChunkSize>())
+    {
+    }
+
+    template<typename T, size_t ChunkSize>
+    ChunkedQueue<T, ChunkSize>::ChunkedQueue(const ChunkedQueue& other) :
+        ADS<T>(new amt::ChunkedSequence<T, ChunkSize>(), other)
+    {
+    }
+
+    template<typename T, size_t ChunkSize>
+    void ChunkedQueue<T, ChunkSize>::push(T element)
+    {
+        this->getSequence()->insertLastFrom([&element]() { return std::move(element); });
+    }
+
+    template<typename T, size_t ChunkSize>
+    void ChunkedQueue<T, ChunkSize>::pushFrom(const ElementFactory<T>& factory)
+    {
+        this->getSequence()->insertLastFrom(factory);
+    }
+
+    template<typename T, size_t ChunkSize>
+    T& ChunkedQueue<T, ChunkSize>::peek()
+    {
+        if (this->isEmpty())
+        {
+            throw std::out_of_range("Queue is empty!");
+        }
+
+        return this->getSequence()->accessFirst();
+    }
+
+    template<typename T, size_t ChunkSize>
+    T ChunkedQueue<T, ChunkSize>::pop()
+    {
+        if (this->isEmpty())
+        {
+            throw std::out_of_range("Queue is empty!");
+        }
+
+        T result = std::move(this->getSequence()->accessFirst());
+        this->getSequence()->removeFirst();
+        return result;
+    }
+
+    template<typename T, size_t ChunkSize>
+    amt::ChunkedSequence<T, ChunkSize>* ChunkedQueue<T, ChunkSize>::getSequence() const
+    {
+        return dynamic_cast<amt::ChunkedSequence<T, ChunkSize>*>(this->memoryStructure_);
+    }
+
+    inline size_t roundQueueCapacity(size_t capacity)
+    {
+        size_t result = 2;
+        while (result < capacity)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    template<typename T>
+    ConcurrentBoundedQueue<T>::ConcurrentBoundedQueue() :
+        ConcurrentBoundedQueue(INIT_CAPACITY)
+    {
+    }
+
+    template<typename T>
+    ConcurrentBoundedQueue<T>::ConcurrentBoundedQueue(size_t capacity) :
+        slots_(new SlotType[roundQueueCapacity(capacity)]),
+        mask_(roundQueueCapacity(capacity) - 1),
+        enqueuePosition_(0),
+        dequeuePosition_(0)
+    {
+        for (size_t i = 0; i <= mask_; ++i)
+        {
+            slots_[i].sequence_.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    template<typename T>
+    ConcurrentBoundedQueue<T>::ConcurrentBoundedQueue(const ConcurrentBoundedQueue& other) :
+        ConcurrentBoundedQueue(other.getCapacity())
+    {
+        this->assign(other);
+    }
+
+    template<typename T>
+    ConcurrentBoundedQueue<T>::~ConcurrentBoundedQueue()
+    {
+        delete[] slots_;
+    }
+
+    template<typename T>
+    size_t ConcurrentBoundedQueue<T>::getCapacity() const
+    {
+        return mask_ + 1;
+    }
+
+    template<typename T>
+    ADT& ConcurrentBoundedQueue<T>::assign(const ADT& other)
+    {
+        auto otherQueue = dynamic_cast<const ConcurrentBoundedQueue<T>*>(&other);
+        if (otherQueue == nullptr)
+        {
+            throw structure_error("Cannot assign different types!");
+        }
+        if (this != &other)
+        {
+            if (this->getCapacity() < otherQueue->size())
+            {
+                throw structure_error("Not enough capacity!");
+            }
+            this->clear();
+            const size_t otherEnd = otherQueue->enqueuePosition_.load(std::memory_order_relaxed);
+            for (size_t position = otherQueue->dequeuePosition_.load(std::memory_order_relaxed); position != otherEnd; ++position)
+            {
+                this->tryPush(otherQueue->accessSlot(position).data_);
+            }
+        }
+        return *this;
+    }
+
+    template<typename T>
+    void ConcurrentBoundedQueue<T>::clear()
+    {
+        const size_t end = enqueuePosition_.load(std::memory_order_relaxed);
+        size_t position = dequeuePosition_.load(std::memory_order_relaxed);
+        for (; position != end; ++position)
+        {
+            SlotType& slot = this->accessSlot(position);
+            slot.data_ = T();
+            slot.sequence_.store(position + mask_ + 1, std::memory_order_relaxed);
+        }
+        dequeuePosition_.store(position, std::memory_order_relaxed);
+    }
+
+    template<typename T>
+    size_t ConcurrentBoundedQueue<T>::size() const
+    {
+        const size_t dequeuePosition = dequeuePosition_.load(std::memory_order_relaxed);
+        const size_t enqueuePosition = enqueuePosition_.load(std::memory_order_relaxed);
+        return enqueuePosition > dequeuePosition ? enqueuePosition - dequeuePosition : 0;
+    }
+
+    template<typename T>
+    bool ConcurrentBoundedQueue<T>::isEmpty() const
+    {
+        return this->size() == 0;
+    }
+
+    template<typename T>
+    bool ConcurrentBoundedQueue<T>::equals(const ADT& other)
+    {
+        if (this == &other)
+        {
+            return true;
+        }
+        if (this->size() != other.size())
+        {
+            return false;
+        }
+        auto otherQueue = dynamic_cast<const ConcurrentBoundedQueue<T>*>(&other);
+        if (otherQueue == nullptr)
+        {
+            return false;
+        }
+        size_t myPosition = dequeuePosition_.load(std::memory_order_relaxed);
+        size_t otherPosition = otherQueue->dequeuePosition_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < this->size(); ++i)
+        {
+            if (!(this->accessSlot(myPosition).data_ == otherQueue->accessSlot(otherPosition).data_))
+            {
+                return false;
+            }
+            ++myPosition;
+            ++otherPosition;
+        }
+        return true;
+    }
+
+    template<typename T>
+    void ConcurrentBoundedQueue<T>::push(T element)
+    {
+        if (!this->tryPushCreated(element))
+        {
+            throw structure_error("Queue is full!");
+        }
+    }
+
+    template<typename T>
+    void ConcurrentBoundedQueue<T>::pushFrom(const ElementFactory<T>& factory)
+    {
+        T element = factory();
+        if (!this->tryPushCreated(element))
+        {
+            throw structure_error("Queue is full!");
+        }
+    }
+
+    template<typename T>
+    T& ConcurrentBoundedQueue<T>::peek()
+    {
+        if (this->isEmpty())
+        {
+            throw structure_error("Queue is empty!");
+        }
+        return this->accessSlot(dequeuePosition_.load(std::memory_order_relaxed)).data_;
+    }
+
+    template<typename T>
+    T ConcurrentBoundedQueue<T>::pop()
+    {
+        T result;
+        if (!this->tryPop(result))
+        {
+            throw structure_error("Queue is empty!");
+        }
+        return result;
+    }
+
+    template<typename T>
+    bool ConcurrentBoundedQueue<T>::tryPush(const T& element)
+    {
+        T copy = element;
+        return this->tryPushCreated(copy);
+    }
+
+    template<typename T>
+    bool ConcurrentBoundedQueue<T>::tryPushCreated(T& element)
+    {
+        static_assert(std::is_nothrow_move_assignable_v<T>, "Elements of ConcurrentBoundedQueue must be nothrow move assignable.");
+
+        SlotType* slot;
+        size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            slot = &this->accessSlot(position);
+            const size_t sequence = slot->sequence_.load(std::memory_order_acquire);
+            const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (difference == 0)
+            {
+                if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = enqueuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->data_ = std::move(element);
+        slot->sequence_.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename T>
+    bool ConcurrentBoundedQueue<T>::tryPop(T& element)
+    {
+        SlotType* slot;
+        size_t position = dequeuePosition_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            slot = &this->accessSlot(position);
+            const size_t sequence = slot->sequence_.load(std::memory_order_acquire);
+            const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+            if (difference == 0)
+            {
+                if (dequeuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = dequeuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+
+        element = std::move(slot->data_);
+        slot->sequence_.store(position + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename T>
+    auto ConcurrentBoundedQueue<T>::accessSlot(size_t position) const -> SlotType&
+    {
+        return slots_[position & mask_];
+    }
+
+    template<typename T>
+    SpscRingQueue<T>::SpscRingQueue() :
+        SpscRingQueue(INIT_CAPACITY)
+    {
+    }
+
+    template<typename T>
+    SpscRingQueue<T>::SpscRingQueue(size_t capacity) :
+        ADS<T>(new amt::CIS<T>(roundQueueCapacity(capacity), true)),
+        elements_(nullptr),
+        mask_(roundQueueCapacity(capacity) - 1),
+        tail_(0),
+        cachedHead_(0),
+        head_(0),
+        cachedTail_(0)
+    {
+        elements_ = this->getSequence()->accessFirst();
+    }
+
+    template<typename T>
+    SpscRingQueue<T>::SpscRingQueue(const SpscRingQueue& other) :
+        SpscRingQueue(other.getCapacity())
+    {
+        this->assign(other);
+    }
+
+    template<typename T>
+    size_t SpscRingQueue<T>::getCapacity() const
+    {
+        return mask_ + 1;
+    }
+
+    template<typename T>
+    ADT& SpscRingQueue<T>::assign(const ADT& other)
+    {
+        auto otherQueue = dynamic_cast<const SpscRingQueue<T>*>(&other);
+        if (otherQueue == nullptr)
+        {
+            throw structure_error("Cannot assign different types!");
+        }
+        if (this != &other)
+        {
+            if (this->getCapacity() < otherQueue->size())
+            {
+                throw structure_error("Not enough capacity!");
+            }
+            this->clear();
+            const size_t otherTail = otherQueue->tail_.load(std::memory_order_relaxed);
+            for (size_t position = otherQueue->head_.load(std::memory_order_relaxed); position != otherTail; ++position)
+            {
+                this->tryPush(otherQueue->elements_[position & otherQueue->mask_].data_);
+            }
+        }
+        return *this;
+    }
+
+    template<typename T>
+    void SpscRingQueue<T>::clear()
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        for (size_t position = head_.load(std::memory_order_relaxed); position != tail; ++position)
+        {
+            elements_[position & mask_].data_ = T();
+        }
+        head_.store(tail, std::memory_order_relaxed);
+        cachedHead_ = tail;
+        cachedTail_ = tail;
+    }
+
+    template<typename T>
+    size_t SpscRingQueue<T>::size() const
+    {
+        const size_t head = head_.load(std::memory_order_acquire);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    template<typename T>
+    bool SpscRingQueue<T>::equals(const ADT& other)
+    {
+        if (this == &other)
+        {
+            return true;
+        }
+        if (this->size() != other.size())
+        {
+            return false;
+        }
+        auto otherQueue = dynamic_cast<const SpscRingQueue<T>*>(&other);
+        if (otherQueue == nullptr)
+        {
+            return false;
+        }
+        size_t myPosition = head_.load(std::memory_order_relaxed);
+        size_t otherPosition = otherQueue->head_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < this->size(); ++i)
+        {
+            if (!(elements_[myPosition & mask_].data_ == otherQueue->elements_[otherPosition & otherQueue->mask_].data_))
+            {
+                return false;
+            }
+            ++myPosition;
+            ++otherPosition;
+        }
+        return true;
+    }
+
+    template<typename T>
+    void SpscRingQueue<T>::push(T element)
+    {
+        if (!this->tryPushWith([&element]() { return std::move(element); }))
+        {
+            throw structure_error("Queue is full!");
+        }
+    }
+
+    template<typename T>
+    void SpscRingQueue<T>::pushFrom(const ElementFactory<T>& factory)
+    {
+        if (!this->tryPushWith(factory))
+        {
+            throw structure_error("Queue is full!");
+        }
+    }
+
+    template<typename T>
+    T& SpscRingQueue<T>::peek()
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (this->availableForConsumer(head, 1) == 0)
+        {
+            throw structure_error("Queue is empty!");
+        }
+        return elements_[head & mask_].data_;
+    }
+
+    template<typename T>
+    T SpscRingQueue<T>::pop()
+    {
+        T result;
+        if (!this->tryPop(result))
+        {
+            throw structure_error("Queue is empty!");
+        }
+        return result;
+    }
+
+    template<typename T>
+    bool SpscRingQueue<T>::tryPush(const T& element)
+    {
+        return this->tryPushWith([&element]() { return element; });
+    }
+
+    template<typename T>
+    template<typename Factory>
+    bool SpscRingQueue<T>::tryPushWith(const Factory& factory)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (this->freeForProducer(tail, 1) == 0)
+        {
+            return false;
+        }
+        placement_recreate(&elements_[tail & mask_].data_, factory);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename T>
+    bool SpscRingQueue<T>::tryPop(T& element)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (this->availableForConsumer(head, 1) == 0)
+        {
+            return false;
+        }
+        element = std::move(elements_[head & mask_].data_);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename T>
+    size_t SpscRingQueue<T>::pushBatch(const T* elements, size_t count)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t toPush = std::min(count, this->freeForProducer(tail, count));
+        for (size_t i = 0; i < toPush; ++i)
+        {
+            elements_[(tail + i) & mask_].data_ = elements[i];
+        }
+        if (toPush > 0)
+        {
+            tail_.store(tail + toPush, std::memory_order_release);
+        }
+        return toPush;
+    }
+
+    template<typename T>
+    size_t SpscRingQueue<T>::popBatch(T* output, size_t maxCount)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t toPop = std::min(maxCount, this->availableForConsumer(head, maxCount));
+        for (size_t i = 0; i < toPop; ++i)
+        {
+            output[i] = std::move(elements_[(head + i) & mask_].data_);
+        }
+        if (toPop > 0)
+        {
+            head_.store(head + toPop, std::memory_order_release);
+        }
+        return toPop;
+    }
+
+    template<typename T>
+    amt::CIS<T>* SpscRingQueue<T>::getSequence() const
+    {
+        return dynamic_cast<amt::CIS<T>*>(this->memoryStructure_);
+    }
+
+    template<typename T>
+    size_t SpscRingQueue<T>::freeForProducer(size_t tail, size_t needed)
+    {
+        size_t free = this->getCapacity() - (tail - cachedHead_);
+        if (free < needed)
+        {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            free = this->getCapacity() - (tail - cachedHead_);
+        }
+        return free;
+    }
+
+    template<typename T>
+    size_t SpscRingQueue<T>::availableForConsumer(size_t head, size_t needed)
+    {
+        size_t available = cachedTail_ - head;
+        if (available < needed)
+        {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            available = cachedTail_ - head;
+        }
+        return available;
+    }
+}
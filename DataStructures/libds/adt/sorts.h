@@ -282,9 +282,9 @@ namespace ds::adt
     template<typename Key, typename T>
     void RadixSort<Key, T>::sort(amt::ImplicitSequence<T>& is, std::function<bool(const T&, const T&)> compare)
     {
-        ds::adt::Array<adt::ExplicitQueue<T>*> buckets = 10;
+        ds::adt::Array<adt::ChunkedQueue<T>*> buckets = 10;
         for (int i = 0; i < 10; ++i) {
-            buckets.set(new adt::ExplicitQueue<T>(), i);
+            buckets.set(new adt::ChunkedQueue<T>(), i);
         }
         int component = 1;
         bool existNextComponent = true;
@@ -3,6 +3,8 @@
 #include <libds/adt/abstract_data_type.h>
 #include <libds/amt/implicit_sequence.h>
 #include <libds/amt/explicit_sequence.h>
+#include <libds/amt/chunked_sequence.h>
+#include <utility>
 
 namespace ds::adt {
 
@@ -14,6 +16,27 @@ namespace ds::adt {
         virtual void push(T element) = 0;
         virtual T& peek() = 0;
         virtual T pop() = 0;
+
+        /**
+         * @brief Pushes the element constructed from args right where the stack keeps it.
+         */
+        template<typename... Args>
+        void emplace(Args&&... args);
+
+        template<typename InputIterator>
+        void pushRange(InputIterator first, InputIterator last);
+
+    protected:
+        /**
+         * @brief Pushes the element returned by factory. Stacks override it to create the element in place,
+         * the default implementation moves it in by push.
+         */
+        virtual void pushFrom(const ElementFactory<T>& factory);
+
+        /**
+         * @brief Called by pushRange before it pushes count elements, count is 0 if the length is not known.
+         */
+        virtual void reserveRange(size_t count);
     };
 
     //----------
@@ -31,6 +54,14 @@ namespace ds::adt {
         T& peek() override;
         T pop() override;
 
+    protected:
+        void pushFrom(const ElementFactory<T>& factory) override;
+
+        /**
+         * @brief Grows the capacity for count more elements, so pushRange grows it at most once.
+         */
+        void reserveRange(size_t count) override;
+
     private:
         amt::IS<T>* getSequence() const;
     };
@@ -50,12 +81,69 @@ namespace ds::adt {
         T& peek() override;
         T pop() override;
 
+    protected:
+        void pushFrom(const ElementFactory<T>& factory) override;
+
     private:
         amt::SinglyLS<T>* getSequence() const;
     };
 
     //----------
 
+    /**
+     * @brief Stack stored in a chunked sequence: one allocation per ChunkSize elements instead of one per element.
+     */
+    template<typename T, size_t ChunkSize = 128>
+    class ChunkedStack :
+        public Stack<T>,
+        public ADS<T>
+    {
+    public:
+        ChunkedStack();
+        ChunkedStack(const ChunkedStack& other);
+
+        void push(T element) override;
+        T& peek() override;
+        T pop() override;
+
+    protected:
+        void pushFrom(const ElementFactory<T>& factory) override;
+
+    private:
+        amt::ChunkedSequence<T, ChunkSize>* getSequence() const;
+    };
+
+    //----------
+
+    template<typename T>
+    template<typename... Args>
+    void Stack<T>::emplace(Args&&... args)
+    {
+        this->pushFrom(ElementFactory<T>([&]() { return T(std::forward<Args>(args)...); }));
+    }
+
+    template<typename T>
+    template<typename InputIterator>
+    void Stack<T>::pushRange(InputIterator first, InputIterator last)
+    {
+        this->reserveRange(knownRangeLength(first, last));
+        for (; first != last; ++first)
+        {
+            this->push(*first);
+        }
+    }
+
+    template<typename T>
+    void Stack<T>::pushFrom(const ElementFactory<T>& factory)
+    {
+        this->push(factory());
+    }
+
+    template<typename T>
+    void Stack<T>::reserveRange(size_t)
+    {
+    }
+
     template<typename T>
     ImplicitStack<T>::ImplicitStack() :
         ADS<T>(new amt::IS<T>())
@@ -71,7 +159,23 @@ namespace ds::adt {
     template<typename T>
     void ImplicitStack<T>::push(T element)
     {
-        this->getSequence()->insertLast().data_ = element;
+        this->getSequence()->insertLastFrom([&element]() { return std::move(element); });
+    }
+
+    template<typename T>
+    void ImplicitStack<T>::pushFrom(const ElementFactory<T>& factory)
+    {
+        this->getSequence()->insertLastFrom(factory);
+    }
+
+    template<typename T>
+    void ImplicitStack<T>::reserveRange(size_t count)
+    {
+        const size_t required = this->size() + count;
+        if (required > this->getSequence()->getCapacity())
+        {
+            this->getSequence()->changeCapacity(required);
+        }
     }
 
     template<typename T>
@@ -93,7 +197,7 @@ namespace ds::adt {
             throw std::out_of_range("Stack is empty!");
         }
 
-        T result = this->getSequence()->accessLast()->data_;
+        T result = std::move(this->getSequence()->accessLast()->data_);
         this->getSequence()->removeLast();
         return result;
     }
@@ -119,7 +223,13 @@ namespace ds::adt {
     template<typename T>
     void ExplicitStack<T>::push(T element)
     {
-        this->getSequence()->insertFirst().data_ = element;
+        this->getSequence()->insertFirstFrom([&element]() { return std::move(element); });
+    }
+
+    template<typename T>
+    void ExplicitStack<T>::pushFrom(const ElementFactory<T>& factory)
+    {
+        this->getSequence()->insertFirstFrom(factory);
     }
 
     template<typename T>
@@ -141,7 +251,7 @@ namespace ds::adt {
             throw std::out_of_range("Stack is empty!");
         }
 
-        T result = this->getSequence()->accessFirst()->data_;
+        T result = std::move(this->getSequence()->accessFirst()->data_);
         this->getSequence()->removeFirst();
         return result;
     }
@@ -151,5 +261,58 @@ namespace ds::adt {
     {
         return dynamic_cast<amt::SinglyLS<T>*>(this->memoryStructure_);
     }
-}
 
+    template<typename T, size_t ChunkSize>
+    ChunkedStack<T, ChunkSize>::ChunkedStack() :
+        ADS<T>(new amt::ChunkedSequence<T, ChunkSize>())
+    {
+    }
+
+    template<typename T, size_t ChunkSize>
+    ChunkedStack<T, ChunkSize>::ChunkedStack(const ChunkedStack& other) :
+        ADS<T>(new amt::ChunkedSequence<T, ChunkSize>(), other)
+    {
+    }
+
+    template<typename T, size_t ChunkSize>
+    void ChunkedStack<T, ChunkSize>::push(T element)
+    {
+        this->getSequence()->insertFirstFrom([&element]() { return std::move(element); });
+    }
+
+    template<typename T, size_t ChunkSize>
+    void ChunkedStack<T, ChunkSize>::pushFrom(const ElementFactory<T>& factory)
+    {
+        this->getSequence()->insertFirstFrom(factory);
+    }
+
+    template<typename T, size_t ChunkSize>
+    T& ChunkedStack<T, ChunkSize>::peek()
+    {
+        if (this->isEmpty())
+        {
+            throw std::out_of_range("Stack is empty!");
+        }
+
+        return this->getSequence()->accessFirst();
+    }
+
+    template<typename T, size_t ChunkSize>
+    T ChunkedStack<T, ChunkSize>::pop()
+    {
+        if (this->isEmpty())
+        {
+            throw std::out_of_range("Stack is empty!");
+        }
+
+        T result = std::move(this->getSequence()->accessFirst());
+        this->getSequence()->removeFirst();
+        return result;
+    }
+
+    template<typename T, size_t ChunkSize>
+    amt::ChunkedSequence<T, ChunkSize>* ChunkedStack<T, ChunkSize>::getSequence() const
+    {
+        return dynamic_cast<amt::ChunkedSequence<T, ChunkSize>*>(this->memoryStructure_);
+    }
+}
@@ -6,6 +6,8 @@
 #include <functional>
 #include <limits>
 #include <random>
+#include <type_traits>
+#include <utility>
 
 namespace ds::adt {
 
@@ -34,12 +36,25 @@ namespace ds::adt {
     {
     public:
         virtual void insert(const K& key, T data) = 0;
+
+        /**
+         * @brief Inserts the data constructed from args right where the table keeps it.
+         */
+        template<typename... Args>
+        void emplace(const K& key, Args&&... args);
+
         virtual T& find(const K& key);
         virtual bool tryFind(const K& key, T*& data) const = 0;
         virtual bool contains(const K& key) const;
         virtual T remove(const K& key) = 0;
 
     protected:
+        /**
+         * @brief Inserts the data returned by factory. Tables override it to create the data in place,
+         * the default implementation moves it in by insert.
+         */
+        virtual void insertFrom(const K& key, const ElementFactory<T>& factory);
+
         template<class TableT>
         bool areEqual(TableT& table1, const ADT& table2);
     };
@@ -97,8 +112,14 @@ namespace ds::adt {
 
         bool equals(const ADT& other) override;
 
+    protected:
+        void insertFrom(const K& key, const ElementFactory<T>& factory) override;
+
     private:
         using BlockType = typename amt::IS<TableItem<K, T>>::BlockType;
+
+        template<typename Factory>
+        void insertWith(const K& key, const Factory& factory);
     };
 
     template <typename K, typename T>
@@ -116,8 +137,14 @@ namespace ds::adt {
 
         bool equals(const ADT& other) override;
 
+    protected:
+        void insertFrom(const K& key, const ElementFactory<T>& factory) override;
+
     private:
         using BlockType = typename amt::SinglyLS<TableItem<K, T>>::BlockType;
+
+        template<typename Factory>
+        void insertWith(const K& key, const Factory& factory);
     };
 
     template <typename K, typename T>
@@ -137,9 +164,13 @@ namespace ds::adt {
     protected:
         using BlockType = typename amt::IS<TableItem<K, T>>::BlockType;
 
+        void insertFrom(const K& key, const ElementFactory<T>& factory) override;
         BlockType* findBlockWithKey(const K& key) const override;
 
     private:
+        template<typename Factory>
+        void insertWith(const K& key, const Factory& factory);
+
         bool tryFindBlockWithKey(const K& key, size_t firstIndex, size_t lastIndex, BlockType*& lastBlock) const;
     };
 
@@ -238,6 +269,8 @@ namespace ds::adt {
 
         amt::BinaryEH<ItemType>* getHierarchy() const;
 
+        void insertFrom(const K& key, const ElementFactory<T>& factory) override;
+
         virtual void removeNode(BSTNodeType* node);
         virtual void balanceTree(BSTNodeType* node) { }
 
@@ -246,6 +279,10 @@ namespace ds::adt {
         void rotateLeft(BSTNodeType* node);
         void rotateRight(BSTNodeType* node);
 
+    private:
+        template<typename Factory>
+        void insertWith(const K& key, const Factory& factory);
+
     private:
         size_t size_;
     };
@@ -322,6 +359,19 @@ namespace ds::adt {
 
     //----------
 
+    template<typename K, typename T>
+    template<typename... Args>
+    void Table<K, T>::emplace(const K& key, Args&&... args)
+    {
+        this->insertFrom(key, ElementFactory<T>([&]() { return T(std::forward<Args>(args)...); }));
+    }
+
+    template<typename K, typename T>
+    void Table<K, T>::insertFrom(const K& key, const ElementFactory<T>& factory)
+    {
+        this->insert(key, factory());
+    }
+
     template<typename K, typename T>
     T& Table<K, T>::find(const K& key)
     {
@@ -399,15 +449,26 @@ namespace ds::adt {
 
     template<typename K, typename T>
     void UnsortedImplicitSequenceTable<K, T>::insert(const K& key, T data)
+    {
+        this->insertWith(key, [&data]() { return std::move(data); });
+    }
+
+    template<typename K, typename T>
+    void UnsortedImplicitSequenceTable<K, T>::insertFrom(const K& key, const ElementFactory<T>& factory)
+    {
+        this->insertWith(key, factory);
+    }
+
+    template<typename K, typename T>
+    template<typename Factory>
+    void UnsortedImplicitSequenceTable<K, T>::insertWith(const K& key, const Factory& factory)
     {
         if (this->contains(key))
         {
             throw std::logic_error("Table already contains element associated with given key!");
         }
 
-        TableItem<K, T>& tableItem = this->getSequence()->insertLast().data_;
-        tableItem.key_ = key;
-        tableItem.data_ = data;
+        this->getSequence()->insertLastFrom([&key, &factory]() { return TableItem<K, T>{ key, factory() }; });
     }
 
     template<typename K, typename T>
@@ -420,7 +481,7 @@ namespace ds::adt {
             throw std::out_of_range("No such key!");
         }
 
-        T result = blockWithKey->data_.data_;
+        T result = std::move(blockWithKey->data_.data_);
         BlockType* lastBlock = this->getSequence()->accessLast();
         if (blockWithKey != lastBlock)
         {
@@ -440,15 +501,26 @@ namespace ds::adt {
 
     template<typename K, typename T>
     void UnsortedExplicitSequenceTable<K, T>::insert(const K& key, T data)
+    {
+        this->insertWith(key, [&data]() { return std::move(data); });
+    }
+
+    template<typename K, typename T>
+    void UnsortedExplicitSequenceTable<K, T>::insertFrom(const K& key, const ElementFactory<T>& factory)
+    {
+        this->insertWith(key, factory);
+    }
+
+    template<typename K, typename T>
+    template<typename Factory>
+    void UnsortedExplicitSequenceTable<K, T>::insertWith(const K& key, const Factory& factory)
     {
         if (this->contains(key))
         {
             throw std::logic_error("Table already contains element associated with given key!");
         }
 
-        TableItem<K, T>& tableItem = this->getSequence()->insertFirst().data_;
-        tableItem.key_ = key;
-        tableItem.data_ = data;
+        this->getSequence()->insertFirstFrom([&key, &factory]() { return TableItem<K, T>{ key, factory() }; });
     }
 
     template<typename K, typename T>
@@ -461,7 +533,7 @@ namespace ds::adt {
             throw std::out_of_range("No such key!");
         }
 
-        T result = blockWithKey->data_.data_;
+        T result = std::move(blockWithKey->data_.data_);
         BlockType* firstBlock = this->getSequence()->accessFirst();
         if (blockWithKey != firstBlock)
         {
@@ -483,11 +555,24 @@ namespace ds::adt {
     template<typename K, typename T>
     void SortedSequenceTable<K, T>::insert(const K& key, T data)
     {
-        TableItem<K, T>* tableItem;
+        this->insertWith(key, [&data]() { return std::move(data); });
+    }
+
+    template<typename K, typename T>
+    void SortedSequenceTable<K, T>::insertFrom(const K& key, const ElementFactory<T>& factory)
+    {
+        this->insertWith(key, factory);
+    }
+
+    template<typename K, typename T>
+    template<typename Factory>
+    void SortedSequenceTable<K, T>::insertWith(const K& key, const Factory& factory)
+    {
+        auto tableItem = [&key, &factory]() { return TableItem<K, T>{ key, factory() }; };
 
         if (this->isEmpty())
         {
-            tableItem = &this->getSequence()->insertFirst().data_;
+            this->getSequence()->insertFirstFrom(tableItem);
         }
         else
         {
@@ -496,13 +581,9 @@ namespace ds::adt {
             {
                 throw std::logic_error("Duplicate key!");
             }
-            tableItem = key > blok->data_.key_
-                ? &this->getSequence()->insertAfter(*blok).data_
-                : &this->getSequence()->insertBefore(*blok).data_;
+            const size_t index = this->getSequence()->calculateIndex(*blok);
+            this->getSequence()->insertFrom(key > blok->data_.key_ ? index + 1 : index, tableItem);
         }
-
-        tableItem->key_ = key;
-        tableItem->data_ = data;
     }
 
     template<typename K, typename T>
@@ -514,7 +595,7 @@ namespace ds::adt {
             throw std::out_of_range("No such key!");
         }
 
-        T result = blockWithKey->data_.data_;
+        T result = std::move(blockWithKey->data_.data_);
         if (this->getSequence()->accessFirst() == blockWithKey)
         {
             this->getSequence()->removeFirst();
@@ -805,10 +886,35 @@ namespace ds::adt {
     template<typename K, typename T, typename ItemType>
     void GeneralBinarySearchTree<K, T, ItemType>::insert(const K& key, T data)
     {
+        this->insertWith(key, [&data]() { return std::move(data); });
+    }
+
+    template<typename K, typename T, typename ItemType>
+    void GeneralBinarySearchTree<K, T, ItemType>::insertFrom(const K& key, const ElementFactory<T>& factory)
+    {
+        this->insertWith(key, factory);
+    }
+
+    template<typename K, typename T, typename ItemType>
+    template<typename Factory>
+    void GeneralBinarySearchTree<K, T, ItemType>::insertWith(const K& key, const Factory& factory)
+    {
+        auto item = [&key, &factory]()
+        {
+            if constexpr (std::is_same_v<ItemType, TableItem<K, T>>)
+            {
+                return ItemType{ key, factory() };
+            }
+            else
+            {
+                return ItemType{ { key, factory() }, 0 };
+            }
+        };
+
         BSTNodeType* newNode = nullptr;
         if (this->isEmpty())
         {
-            newNode = &this->getHierarchy()->emplaceRoot();
+            newNode = &this->getHierarchy()->emplaceRootFrom(item);
         }
         else
         {
@@ -818,13 +924,10 @@ namespace ds::adt {
                 throw std::logic_error("Table already contains an element associated with given key!");
             }
             newNode = key > parent->data_.key_
-                ? &this->getHierarchy()->insertRightSon(*parent)
-                : &this->getHierarchy()->insertLeftSon(*parent);
+                ? &this->getHierarchy()->insertRightSonFrom(*parent, item)
+                : &this->getHierarchy()->insertLeftSonFrom(*parent, item);
         }
 
-        newNode->data_.key_ = key;
-        newNode->data_.data_ = data;
-
         ++size_;
         this->balanceTree(newNode);
     }
@@ -850,7 +953,7 @@ namespace ds::adt {
             throw std::out_of_range("No such key!");
         }
 
-        T result = nodeWithKey->data_.data_;
+        T result = std::move(nodeWithKey->data_.data_);
         this->removeNode(nodeWithKey);
         size_--;
         return result;
@@ -23,10 +23,24 @@ namespace ds::amt {
 
 	//----------
 
+	/**
+	 * @brief Selects block constructors that initialise data with the result of a factory, so the data is
+	 * constructed right in the block.
+	 */
+	struct FactoryTag {};
+
+	//----------
+
 	template<typename DataType>
 	struct MemoryBlock
 	{
 		using DataT = DataType;
+
+		MemoryBlock() = default;
+
+		template<typename Factory>
+		MemoryBlock(FactoryTag, const Factory& factory) : data_(factory()) {}
+
 		DataType data_;
 	};
 
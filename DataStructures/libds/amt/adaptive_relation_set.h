@@ -0,0 +1,331 @@
+#pragma once
+
+#include <libds/amt/abstract_memory_type.h>
+#include <libds/amt/implicit_sequence.h>
+#include <cstdint>
+#include <functional>
+
+namespace ds::amt {
+
+    /**
+     * @brief Set of relations (neighbour pointers) of a network node.
+     *
+     * Up to INLINE_CAPACITY relations are kept in an array inside the set, so nodes of low degree need no further
+     * allocation. Once the set grows beyond it, relations move to an implicit sequence indexed by an open-addressing
+     * hash table (linear probing, backward-shift deletion), so insert, contains and remove take expected O(1).
+     * Relations stay contiguous in both modes; remove fills the gap with the last relation, so order is not kept.
+     * Inserting a relation that is already present has no effect.
+     */
+    template<typename DataType>
+    class AdaptiveRelationSet
+    {
+    public:
+        using BlockType = MemoryBlock<DataType>;
+
+        AdaptiveRelationSet();
+        AdaptiveRelationSet(const AdaptiveRelationSet& other) = delete;
+        ~AdaptiveRelationSet();
+
+        size_t size() const;
+        bool isEmpty() const;
+        void clear();
+
+        BlockType* accessFirst() const;
+        BlockType* accessLast() const;
+        BlockType* access(size_t index) const;
+        BlockType* accessNext(const BlockType& block) const;
+
+        void processAllBlocksForward(std::function<void(BlockType*)> operation) const;
+
+        bool contains(const DataType& data) const;
+
+        /**
+         * @return false if data was already present.
+         */
+        bool insert(const DataType& data);
+
+        /**
+         * @return false if data was not present.
+         */
+        bool remove(const DataType& data);
+
+        bool isHashed() const;
+
+        static const size_t INLINE_CAPACITY = 8;
+
+    private:
+        static const size_t EMPTY_SLOT = 0;
+
+        BlockType* accessBlocks() const;
+        size_t slotOf(const DataType& data) const;
+        size_t findSlot(const DataType& data) const;
+        void placeInSlot(const DataType& data, size_t position);
+        void removeSlot(size_t slot);
+        void rehash(size_t slotCount);
+
+    private:
+        BlockType inline_[INLINE_CAPACITY];
+        size_t inlineSize_;
+
+        // Slots hold position + 1 of a relation in relations_; EMPTY_SLOT marks a free slot.
+        IS<DataType>* relations_;
+        IS<size_t>* slots_;
+        size_t slotShift_;
+    };
+
+    //----------
+
+    template<typename DataType>
+    AdaptiveRelationSet<DataType>::AdaptiveRelationSet() :
+        inline_(),
+        inlineSize_(0),
+        relations_(nullptr),
+        slots_(nullptr),
+        slotShift_(0)
+    {
+    }
+
+    template<typename DataType>
+    AdaptiveRelationSet<DataType>::~AdaptiveRelationSet()
+    {
+        this->clear();
+    }
+
+    template<typename DataType>
+    size_t AdaptiveRelationSet<DataType>::size() const
+    {
+        return relations_ != nullptr ? relations_->size() : inlineSize_;
+    }
+
+    template<typename DataType>
+    bool AdaptiveRelationSet<DataType>::isEmpty() const
+    {
+        return this->size() == 0;
+    }
+
+    template<typename DataType>
+    void AdaptiveRelationSet<DataType>::clear()
+    {
+        delete relations_;
+        delete slots_;
+        relations_ = nullptr;
+        slots_ = nullptr;
+        slotShift_ = 0;
+        inlineSize_ = 0;
+    }
+
+    template<typename DataType>
+    auto AdaptiveRelationSet<DataType>::accessFirst() const -> BlockType*
+    {
+        return this->size() > 0 ? this->accessBlocks() : nullptr;
+    }
+
+    template<typename DataType>
+    auto AdaptiveRelationSet<DataType>::accessLast() const -> BlockType*
+    {
+        return this->size() > 0 ? this->accessBlocks() + this->size() - 1 : nullptr;
+    }
+
+    template<typename DataType>
+    auto AdaptiveRelationSet<DataType>::access(size_t index) const -> BlockType*
+    {
+        return index < this->size() ? this->accessBlocks() + index : nullptr;
+    }
+
+    template<typename DataType>
+    auto AdaptiveRelationSet<DataType>::accessNext(const BlockType& block) const -> BlockType*
+    {
+        return this->access(static_cast<size_t>(&block - this->accessBlocks()) + 1);
+    }
+
+    template<typename DataType>
+    void AdaptiveRelationSet<DataType>::processAllBlocksForward(std::function<void(BlockType*)> operation) const
+    {
+        BlockType* blocks = this->accessBlocks();
+        const size_t size = this->size();
+        for (size_t i = 0; i < size; ++i)
+        {
+            operation(blocks + i);
+        }
+    }
+
+    template<typename DataType>
+    bool AdaptiveRelationSet<DataType>::contains(const DataType& data) const
+    {
+        if (relations_ == nullptr)
+        {
+            for (size_t i = 0; i < inlineSize_; ++i)
+            {
+                if (inline_[i].data_ == data)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        return this->findSlot(data) != slots_->size();
+    }
+
+    template<typename DataType>
+    bool AdaptiveRelationSet<DataType>::insert(const DataType& data)
+    {
+        if (this->contains(data))
+        {
+            return false;
+        }
+
+        if (relations_ == nullptr)
+        {
+            if (inlineSize_ < INLINE_CAPACITY)
+            {
+                inline_[inlineSize_++].data_ = data;
+                return true;
+            }
+
+            relations_ = new IS<DataType>(INLINE_CAPACITY * 4, false);
+            for (size_t i = 0; i < inlineSize_; ++i)
+            {
+                relations_->insertLast().data_ = inline_[i].data_;
+            }
+            inlineSize_ = 0;
+            this->rehash(INLINE_CAPACITY * 8);
+        }
+        else if (2 * (relations_->size() + 1) > slots_->size())
+        {
+            this->rehash(slots_->size() * 2);
+        }
+
+        relations_->insertLast().data_ = data;
+        this->placeInSlot(data, relations_->size() - 1);
+        return true;
+    }
+
+    template<typename DataType>
+    bool AdaptiveRelationSet<DataType>::remove(const DataType& data)
+    {
+        if (relations_ == nullptr)
+        {
+            for (size_t i = 0; i < inlineSize_; ++i)
+            {
+                if (inline_[i].data_ == data)
+                {
+                    inline_[i].data_ = inline_[--inlineSize_].data_;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        const size_t slot = this->findSlot(data);
+        if (slot == slots_->size())
+        {
+            return false;
+        }
+
+        const size_t position = slots_->access(slot)->data_ - 1;
+        const size_t lastPosition = relations_->size() - 1;
+        this->removeSlot(slot);
+        if (position != lastPosition)
+        {
+            const DataType& moved = relations_->access(lastPosition)->data_;
+            slots_->access(this->findSlot(moved))->data_ = position + 1;
+            relations_->access(position)->data_ = moved;
+        }
+        relations_->removeLast();
+        return true;
+    }
+
+    template<typename DataType>
+    bool AdaptiveRelationSet<DataType>::isHashed() const
+    {
+        return relations_ != nullptr;
+    }
+
+    template<typename DataType>
+    auto AdaptiveRelationSet<DataType>::accessBlocks() const -> BlockType*
+    {
+        return relations_ != nullptr ? relations_->accessFirst() : const_cast<BlockType*>(inline_);
+    }
+
+    template<typename DataType>
+    size_t AdaptiveRelationSet<DataType>::slotOf(const DataType& data) const
+    {
+        // Fibonacci hashing: the multiplication mixes the low bits of aligned pointers into the top bits.
+        const std::uint64_t key = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(data));
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> slotShift_);
+    }
+
+    template<typename DataType>
+    size_t AdaptiveRelationSet<DataType>::findSlot(const DataType& data) const
+    {
+        const size_t mask = slots_->size() - 1;
+        for (size_t slot = this->slotOf(data); ; slot = (slot + 1) & mask)
+        {
+            const size_t entry = slots_->access(slot)->data_;
+            if (entry == EMPTY_SLOT)
+            {
+                return slots_->size();
+            }
+            if (relations_->access(entry - 1)->data_ == data)
+            {
+                return slot;
+            }
+        }
+    }
+
+    template<typename DataType>
+    void AdaptiveRelationSet<DataType>::placeInSlot(const DataType& data, size_t position)
+    {
+        const size_t mask = slots_->size() - 1;
+        size_t slot = this->slotOf(data);
+        while (slots_->access(slot)->data_ != EMPTY_SLOT)
+        {
+            slot = (slot + 1) & mask;
+        }
+        slots_->access(slot)->data_ = position + 1;
+    }
+
+    template<typename DataType>
+    void AdaptiveRelationSet<DataType>::removeSlot(size_t slot)
+    {
+        // Backward-shift deletion: later entries of the probe run move into the gap, so no tombstones are needed.
+        const size_t mask = slots_->size() - 1;
+        size_t gap = slot;
+        for (size_t next = (gap + 1) & mask; ; next = (next + 1) & mask)
+        {
+            const size_t entry = slots_->access(next)->data_;
+            if (entry == EMPTY_SLOT)
+            {
+                break;
+            }
+
+            const size_t home = this->slotOf(relations_->access(entry - 1)->data_);
+            // The entry may move into the gap unless its home lies cyclically in (gap, next].
+            const bool homeInRange = gap <= next ? (gap < home && home <= next) : (gap < home || home <= next);
+            if (!homeInRange)
+            {
+                slots_->access(gap)->data_ = entry;
+                gap = next;
+            }
+        }
+        slots_->access(gap)->data_ = EMPTY_SLOT;
+    }
+
+    template<typename DataType>
+    void AdaptiveRelationSet<DataType>::rehash(size_t slotCount)
+    {
+        delete slots_;
+        slots_ = new IS<size_t>(slotCount, true);
+        slotShift_ = 64;
+        for (size_t count = slotCount; count > 1; count >>= 1)
+        {
+            --slotShift_;
+        }
+
+        for (size_t position = 0; position < relations_->size(); ++position)
+        {
+            this->placeInSlot(relations_->access(position)->data_, position);
+        }
+    }
+}
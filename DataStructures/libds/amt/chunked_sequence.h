@@ -0,0 +1,409 @@
+#pragma once
+
+#include <libds/amt/abstract_memory_type.h>
+
+namespace ds::amt {
+
+    /**
+     * @brief Node of a chunked sequence holding a run of up to ChunkSize elements.
+     * Occupied elements are data_[begin_] ... data_[end_ - 1].
+     */
+    template<typename DataType, size_t ChunkSize>
+    struct ChunkedSequenceBlock
+    {
+        DataType data_[ChunkSize];
+        size_t begin_ = 0;
+        size_t end_ = 0;
+        ChunkedSequenceBlock* next_ = nullptr;
+    };
+
+    //----------
+
+    /**
+     * @brief Singly linked list of chunks (unrolled list).
+     *
+     * Elements can be inserted at both ends and removed from the front, which is enough for queues and stacks.
+     * One chunk is allocated per ChunkSize insertions and emptied chunks are kept in a small free list,
+     * so a structure that keeps growing and shrinking does not go back to the allocator.
+     */
+    template<typename DataType, size_t ChunkSize = 128>
+    class ChunkedSequence :
+            public ExplicitAMS<ChunkedSequenceBlock<DataType, ChunkSize>>
+    {
+        static_assert(ChunkSize >= 2, "Chunk must hold at least two elements.");
+
+    public:
+        using BlockType = ChunkedSequenceBlock<DataType, ChunkSize>;
+
+        ChunkedSequence();
+        ChunkedSequence(const ChunkedSequence& other);
+        ~ChunkedSequence() override;
+
+        AMT& assign(const AMT& other) override;
+        void clear() override;
+        size_t size() const override;
+        bool equals(const AMT& other) override;
+
+        DataType& accessFirst() const;
+        DataType& accessLast() const;
+
+        DataType& insertFirst();
+        DataType& insertLast();
+
+        /**
+         * @brief Inserts the result of @p factory, constructed right in its place in a chunk.
+         */
+        template<typename Factory>
+        DataType& insertFirstFrom(const Factory& factory);
+        template<typename Factory>
+        DataType& insertLastFrom(const Factory& factory);
+
+        void removeFirst();
+
+        static const size_t FREE_CHUNK_LIMIT = 4;
+
+    private:
+        BlockType* acquireChunk(size_t start);
+        void releaseChunk(BlockType* chunk);
+
+    private:
+        BlockType* first_;
+        BlockType* last_;
+        BlockType* freeChunks_;
+        size_t freeChunkCount_;
+        size_t size_;
+
+    public:
+        class ChunkedSequenceIterator
+        {
+        public:
+            ChunkedSequenceIterator(BlockType* chunk, size_t index);
+            ChunkedSequenceIterator& operator++();
+            bool operator==(const ChunkedSequenceIterator& other) const;
+            bool operator!=(const ChunkedSequenceIterator& other) const;
+            DataType& operator*();
+
+        private:
+            BlockType* chunk_;
+            size_t index_;
+        };
+
+        ChunkedSequenceIterator begin() const;
+        ChunkedSequenceIterator end() const;
+
+        using IteratorType = ChunkedSequenceIterator;
+    };
+
+    //----------
+
+    template<typename DataType, size_t ChunkSize>
+    ChunkedSequence<DataType, ChunkSize>::ChunkedSequence() :
+        first_(nullptr),
+        last_(nullptr),
+        freeChunks_(nullptr),
+        freeChunkCount_(0),
+        size_(0)
+    {
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    ChunkedSequence<DataType, ChunkSize>::ChunkedSequence(const ChunkedSequence& other) :
+        ChunkedSequence()
+    {
+        this->assign(other);
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    ChunkedSequence<DataType, ChunkSize>::~ChunkedSequence()
+    {
+        ChunkedSequence<DataType, ChunkSize>::clear();
+        while (freeChunks_ != nullptr)
+        {
+            BlockType* next = freeChunks_->next_;
+            this->memoryManager_->releaseMemory(freeChunks_);
+            freeChunks_ = next;
+        }
+        freeChunkCount_ = 0;
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    AMT& ChunkedSequence<DataType, ChunkSize>::assign(const AMT& other)
+    {
+        if (this != &other)
+        {
+            this->clear();
+
+            const ChunkedSequence& otherSequence = dynamic_cast<const ChunkedSequence&>(other);
+            for (DataType& data : otherSequence)
+            {
+                this->insertLast() = data;
+            }
+        }
+
+        return *this;
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    void ChunkedSequence<DataType, ChunkSize>::clear()
+    {
+        while (first_ != nullptr)
+        {
+            BlockType* next = first_->next_;
+            for (size_t i = first_->begin_; i < first_->end_; ++i)
+            {
+                first_->data_[i] = DataType();
+            }
+            this->releaseChunk(first_);
+            first_ = next;
+        }
+        last_ = nullptr;
+        size_ = 0;
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    size_t ChunkedSequence<DataType, ChunkSize>::size() const
+    {
+        return size_;
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    bool ChunkedSequence<DataType, ChunkSize>::equals(const AMT& other)
+    {
+        if (this == &other)
+        {
+            return true;
+        }
+
+        if (this->size() != other.size())
+        {
+            return false;
+        }
+
+        const ChunkedSequence* otherSequence = dynamic_cast<const ChunkedSequence*>(&other);
+        if (otherSequence == nullptr)
+        {
+            return false;
+        }
+
+        ChunkedSequenceIterator myIt = this->begin();
+        ChunkedSequenceIterator otherIt = otherSequence->begin();
+        while (myIt != this->end())
+        {
+            if (!(*myIt == *otherIt))
+            {
+                return false;
+            }
+            ++myIt;
+            ++otherIt;
+        }
+
+        return true;
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    DataType& ChunkedSequence<DataType, ChunkSize>::accessFirst() const
+    {
+        return first_->data_[first_->begin_];
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    DataType& ChunkedSequence<DataType, ChunkSize>::accessLast() const
+    {
+        return last_->data_[last_->end_ - 1];
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    DataType& ChunkedSequence<DataType, ChunkSize>::insertFirst()
+    {
+        if (first_ == nullptr || first_->begin_ == 0)
+        {
+            BlockType* chunk = this->acquireChunk(ChunkSize);
+            chunk->next_ = first_;
+            first_ = chunk;
+            if (last_ == nullptr)
+            {
+                last_ = chunk;
+            }
+        }
+
+        ++size_;
+        return first_->data_[--first_->begin_];
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    DataType& ChunkedSequence<DataType, ChunkSize>::insertLast()
+    {
+        if (last_ == nullptr || last_->end_ == ChunkSize)
+        {
+            BlockType* chunk = this->acquireChunk(0);
+            if (last_ == nullptr)
+            {
+                first_ = chunk;
+            }
+            else
+            {
+                last_->next_ = chunk;
+            }
+            last_ = chunk;
+        }
+
+        ++size_;
+        return last_->data_[last_->end_++];
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    template<typename Factory>
+    DataType& ChunkedSequence<DataType, ChunkSize>::insertFirstFrom(const Factory& factory)
+    {
+        DataType& data = this->insertFirst();
+        try
+        {
+            placement_recreate(&data, factory);
+        }
+        catch (...)
+        {
+            this->removeFirst();
+            throw;
+        }
+        return data;
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    template<typename Factory>
+    DataType& ChunkedSequence<DataType, ChunkSize>::insertLastFrom(const Factory& factory)
+    {
+        if (last_ != nullptr && last_->end_ < ChunkSize)
+        {
+            placement_recreate(&last_->data_[last_->end_], factory);
+            ++size_;
+            return last_->data_[last_->end_++];
+        }
+
+        // A new chunk is linked only once the element is created in it.
+        BlockType* chunk = this->acquireChunk(0);
+        try
+        {
+            placement_recreate(&chunk->data_[0], factory);
+        }
+        catch (...)
+        {
+            this->releaseChunk(chunk);
+            throw;
+        }
+        if (last_ == nullptr)
+        {
+            first_ = chunk;
+        }
+        else
+        {
+            last_->next_ = chunk;
+        }
+        last_ = chunk;
+        ++size_;
+        return last_->data_[last_->end_++];
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    void ChunkedSequence<DataType, ChunkSize>::removeFirst()
+    {
+        first_->data_[first_->begin_] = DataType();
+        ++first_->begin_;
+        --size_;
+
+        if (first_->begin_ == first_->end_)
+        {
+            BlockType* emptied = first_;
+            first_ = first_->next_;
+            if (first_ == nullptr)
+            {
+                last_ = nullptr;
+            }
+            this->releaseChunk(emptied);
+        }
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    auto ChunkedSequence<DataType, ChunkSize>::acquireChunk(size_t start) -> BlockType*
+    {
+        BlockType* chunk;
+        if (freeChunks_ != nullptr)
+        {
+            chunk = freeChunks_;
+            freeChunks_ = chunk->next_;
+            --freeChunkCount_;
+        }
+        else
+        {
+            chunk = this->memoryManager_->allocateMemory();
+        }
+
+        chunk->begin_ = start;
+        chunk->end_ = start;
+        chunk->next_ = nullptr;
+        return chunk;
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    void ChunkedSequence<DataType, ChunkSize>::releaseChunk(BlockType* chunk)
+    {
+        if (freeChunkCount_ < FREE_CHUNK_LIMIT)
+        {
+            chunk->next_ = freeChunks_;
+            freeChunks_ = chunk;
+            ++freeChunkCount_;
+        }
+        else
+        {
+            this->memoryManager_->releaseMemory(chunk);
+        }
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    ChunkedSequence<DataType, ChunkSize>::ChunkedSequenceIterator::ChunkedSequenceIterator(BlockType* chunk, size_t index) :
+        chunk_(chunk),
+        index_(index)
+    {
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    auto ChunkedSequence<DataType, ChunkSize>::ChunkedSequenceIterator::operator++() -> ChunkedSequenceIterator&
+    {
+        ++index_;
+        if (index_ == chunk_->end_)
+        {
+            chunk_ = chunk_->next_;
+            index_ = chunk_ != nullptr ? chunk_->begin_ : 0;
+        }
+        return *this;
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    bool ChunkedSequence<DataType, ChunkSize>::ChunkedSequenceIterator::operator==(const ChunkedSequenceIterator& other) const
+    {
+        return chunk_ == other.chunk_ && index_ == other.index_;
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    bool ChunkedSequence<DataType, ChunkSize>::ChunkedSequenceIterator::operator!=(const ChunkedSequenceIterator& other) const
+    {
+        return !(*this == other);
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    DataType& ChunkedSequence<DataType, ChunkSize>::ChunkedSequenceIterator::operator*()
+    {
+        return chunk_->data_[index_];
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    auto ChunkedSequence<DataType, ChunkSize>::begin() const -> ChunkedSequenceIterator
+    {
+        return ChunkedSequenceIterator(first_, first_ != nullptr ? first_->begin_ : 0);
+    }
+
+    template<typename DataType, size_t ChunkSize>
+    auto ChunkedSequence<DataType, ChunkSize>::end() const -> ChunkedSequenceIterator
+    {
+        return ChunkedSequenceIterator(nullptr, 0);
+    }
+}
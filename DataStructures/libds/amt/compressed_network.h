@@ -0,0 +1,262 @@
+#pragma once
+
+#include <libds/amt/abstract_memory_type.h>
+#include <libds/amt/network.h>
+#include <libds/amt/implicit_sequence.h>
+#include <algorithm>
+
+namespace ds::amt {
+
+    /**
+     * @brief Immutable network in the compressed sparse row format.
+     *
+     * Nodes are stored contiguously; neighbours of node i are the node indices
+     * neighbours_[offsets_[i]] ... neighbours_[offsets_[i + 1] - 1], sorted in ascending order.
+     * Degree is O(1), relationExists is a binary search and copying is linear.
+     * Networks of this type are created by @c ExplicitNetwork::freeze ; operations that modify
+     * the structure of the network throw @c unavailable_function_call .
+     */
+    template<typename DataType>
+    class CompressedNetwork :
+        public Network<MemoryBlock<DataType>>
+    {
+    public:
+        using BlockType = MemoryBlock<DataType>;
+
+        CompressedNetwork();
+        CompressedNetwork(size_t nodeCount, size_t relationCount);
+        CompressedNetwork(const CompressedNetwork& other);
+        ~CompressedNetwork() override;
+
+        AMT& assign(const AMT& other) override;
+        void clear() override;
+        size_t size() const override;
+        bool isEmpty() const override;
+        bool equals(const AMT& other) override;
+
+        size_t relationCount() const override;
+        size_t degree(const BlockType& node) const override;
+
+        BlockType* accessNodeFromGate(size_t order) const override;
+        BlockType* accessNodeFromNode(const BlockType& node, size_t order) const override;
+
+        bool relationExists(const BlockType& nodeA, const BlockType& nodeB) const override;
+
+        BlockType& insert() override;
+        void remove(BlockType* node) override;
+
+        void connect(BlockType& nodeA, BlockType& nodeB) override;
+        void disconnect(BlockType& nodeA, BlockType& nodeB) override;
+
+        size_t calculateIndex(const BlockType& node) const;
+        size_t degreeAt(size_t index) const;
+
+        /**
+         * @brief Sorted indices of neighbours of the node with given index; there are degreeAt(index) of them.
+         */
+        const size_t* accessNeighbourIndices(size_t index) const;
+
+        /**
+         * @brief Raw arrays used by @c ExplicitNetwork::freeze to fill the network.
+         */
+        BlockType* accessNodes() const;
+        size_t* accessOffsets() const;
+        size_t* accessNeighbours() const;
+
+    private:
+        IS<DataType>* nodes_;
+        IS<size_t>* offsets_;
+        IS<size_t>* neighbours_;
+    };
+
+    //----------
+
+    template<typename DataType>
+    CompressedNetwork<DataType>::CompressedNetwork() :
+        CompressedNetwork(0, 0)
+    {
+    }
+
+    template<typename DataType>
+    CompressedNetwork<DataType>::CompressedNetwork(size_t nodeCount, size_t relationCount) :
+        nodes_(new IS<DataType>(nodeCount, true)),
+        offsets_(new IS<size_t>(nodeCount + 1, true)),
+        neighbours_(new IS<size_t>(relationCount, true))
+    {
+    }
+
+    template<typename DataType>
+    CompressedNetwork<DataType>::CompressedNetwork(const CompressedNetwork& other) :
+        nodes_(new IS<DataType>(*other.nodes_)),
+        offsets_(new IS<size_t>(*other.offsets_)),
+        neighbours_(new IS<size_t>(*other.neighbours_))
+    {
+    }
+
+    template<typename DataType>
+    CompressedNetwork<DataType>::~CompressedNetwork()
+    {
+        delete nodes_;
+        delete offsets_;
+        delete neighbours_;
+        nodes_ = nullptr;
+        offsets_ = nullptr;
+        neighbours_ = nullptr;
+    }
+
+    template<typename DataType>
+    AMT& CompressedNetwork<DataType>::assign(const AMT& other)
+    {
+        if (this != &other)
+        {
+            const CompressedNetwork<DataType>& otherNetwork = dynamic_cast<const CompressedNetwork<DataType>&>(other);
+            nodes_->assign(*otherNetwork.nodes_);
+            offsets_->assign(*otherNetwork.offsets_);
+            neighbours_->assign(*otherNetwork.neighbours_);
+        }
+        return *this;
+    }
+
+    template<typename DataType>
+    void CompressedNetwork<DataType>::clear()
+    {
+        nodes_->clear();
+        neighbours_->clear();
+        offsets_->clear();
+        offsets_->insertLast().data_ = 0;
+    }
+
+    template<typename DataType>
+    size_t CompressedNetwork<DataType>::size() const
+    {
+        return nodes_->size();
+    }
+
+    template<typename DataType>
+    bool CompressedNetwork<DataType>::isEmpty() const
+    {
+        return this->size() == 0;
+    }
+
+    template<typename DataType>
+    bool CompressedNetwork<DataType>::equals(const AMT& other)
+    {
+        if (this == &other)
+        {
+            return true;
+        }
+
+        const CompressedNetwork<DataType>* otherNetwork = dynamic_cast<const CompressedNetwork<DataType>*>(&other);
+        if (otherNetwork == nullptr)
+        {
+            return false;
+        }
+
+        return nodes_->equals(*otherNetwork->nodes_)
+            && offsets_->equals(*otherNetwork->offsets_)
+            && neighbours_->equals(*otherNetwork->neighbours_);
+    }
+
+    template<typename DataType>
+    size_t CompressedNetwork<DataType>::relationCount() const
+    {
+        return neighbours_->size();
+    }
+
+    template<typename DataType>
+    size_t CompressedNetwork<DataType>::degree(const BlockType& node) const
+    {
+        return this->degreeAt(this->calculateIndex(node));
+    }
+
+    template<typename DataType>
+    auto CompressedNetwork<DataType>::accessNodeFromGate(size_t order) const -> BlockType*
+    {
+        return order < this->size() ? this->accessNodes() + order : nullptr;
+    }
+
+    template<typename DataType>
+    auto CompressedNetwork<DataType>::accessNodeFromNode(const BlockType& node, size_t order) const -> BlockType*
+    {
+        const size_t index = this->calculateIndex(node);
+        return order < this->degreeAt(index)
+            ? this->accessNodes() + this->accessNeighbourIndices(index)[order]
+            : nullptr;
+    }
+
+    template<typename DataType>
+    bool CompressedNetwork<DataType>::relationExists(const BlockType& nodeA, const BlockType& nodeB) const
+    {
+        size_t indexFrom = this->calculateIndex(nodeA);
+        size_t indexTo = this->calculateIndex(nodeB);
+        if (this->degreeAt(indexFrom) > this->degreeAt(indexTo))
+        {
+            std::swap(indexFrom, indexTo);
+        }
+
+        const size_t* first = this->accessNeighbourIndices(indexFrom);
+        return std::binary_search(first, first + this->degreeAt(indexFrom), indexTo);
+    }
+
+    template<typename DataType>
+    auto CompressedNetwork<DataType>::insert() -> BlockType&
+    {
+        throw unavailable_function_call("Compressed network is immutable!");
+    }
+
+    template<typename DataType>
+    void CompressedNetwork<DataType>::remove(BlockType*)
+    {
+        throw unavailable_function_call("Compressed network is immutable!");
+    }
+
+    template<typename DataType>
+    void CompressedNetwork<DataType>::connect(BlockType&, BlockType&)
+    {
+        throw unavailable_function_call("Compressed network is immutable!");
+    }
+
+    template<typename DataType>
+    void CompressedNetwork<DataType>::disconnect(BlockType&, BlockType&)
+    {
+        throw unavailable_function_call("Compressed network is immutable!");
+    }
+
+    template<typename DataType>
+    size_t CompressedNetwork<DataType>::calculateIndex(const BlockType& node) const
+    {
+        return static_cast<size_t>(&node - this->accessNodes());
+    }
+
+    template<typename DataType>
+    size_t CompressedNetwork<DataType>::degreeAt(size_t index) const
+    {
+        const size_t* offsets = this->accessOffsets();
+        return offsets[index + 1] - offsets[index];
+    }
+
+    template<typename DataType>
+    const size_t* CompressedNetwork<DataType>::accessNeighbourIndices(size_t index) const
+    {
+        return this->accessNeighbours() + this->accessOffsets()[index];
+    }
+
+    template<typename DataType>
+    auto CompressedNetwork<DataType>::accessNodes() const -> BlockType*
+    {
+        return nodes_->accessFirst();
+    }
+
+    template<typename DataType>
+    size_t* CompressedNetwork<DataType>::accessOffsets() const
+    {
+        // MemoryBlock<size_t> has the layout of size_t, so the implicit sequence can be used as a plain array.
+        return reinterpret_cast<size_t*>(offsets_->accessFirst());
+    }
+
+    template<typename DataType>
+    size_t* CompressedNetwork<DataType>::accessNeighbours() const
+    {
+        return reinterpret_cast<size_t*>(neighbours_->accessFirst());
+    }
+}
@@ -3,7 +3,16 @@
 #include <libds/amt/abstract_memory_type.h>
 #include <libds/amt/hierarchy.h>
 #include <libds/amt/implicit_sequence.h>
+#include <libds/mm/pool_memory_manager.h>
+#include <libds/bits.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace ds::amt {
 
@@ -12,6 +21,8 @@ namespace ds::amt {
         public MemoryBlock<DataType>
     {
         ExplicitHierarchyBlock() : parent_(nullptr) {}
+        template<typename Factory>
+        ExplicitHierarchyBlock(FactoryTag tag, const Factory& factory) : MemoryBlock<DataType>(tag, factory), parent_(nullptr) {}
         ~ExplicitHierarchyBlock() { parent_ = nullptr; }
 
         ExplicitHierarchyBlock<DataType>* parent_;
@@ -41,7 +52,15 @@ namespace ds::amt {
         BlockType& emplaceRoot() override;
         void changeRoot(BlockType* newRoot) override;
 
+        /**
+         * @brief Creates the root whose data is the result of @p factory, constructed right in the block.
+         */
+        template<typename Factory>
+        BlockType& emplaceRootFrom(const Factory& factory);
+
     protected:
+        explicit ExplicitHierarchy(mm::MemoryManager<BlockType>* memoryManager);
+
         BlockType* root_;
     };
 
@@ -88,6 +107,138 @@ namespace ds::amt {
 
     //----------
 
+    /**
+     * @brief Aggregate of nodes of a hierarchy that aggregates nothing.
+     *
+     * An aggregate is a monoid over data of nodes: values of ValueType, identity(), of(data) mapping data of a node
+     * to a value and an associative combine(a, b) whose neutral element is identity().
+     */
+    template<typename DataType>
+    struct NoAggregate
+    {
+        struct ValueType {};
+
+        static ValueType identity() { return ValueType(); }
+        static ValueType of(const DataType&) { return ValueType(); }
+        static ValueType combine(const ValueType&, const ValueType&) { return ValueType(); }
+    };
+
+    /**
+     * @brief Block of a multi-way hierarchy that keeps up to INLINE_SON_COUNT sons inside the block.
+     *
+     * Sons are stored in the inline array until it is full, then in an array on the heap which doubles when needed.
+     * Leaves and nodes with few sons therefore need no allocation besides the block itself.
+     * The block also caches its depth, the node count of its subtree and the Aggregate of its subtree.
+     */
+    template<typename DataType, typename Aggregate = NoAggregate<DataType>>
+    struct PooledMultiWayExplicitHierarchyBlock :
+        public ExplicitHierarchyBlock<DataType>
+    {
+        PooledMultiWayExplicitHierarchyBlock() :
+            sons_(inlineSons_), degree_(0), capacity_(INLINE_SON_COUNT), inlineSons_(),
+            depth_(0), subtreeSize_(1), aggregate_(Aggregate::identity()) {}
+        PooledMultiWayExplicitHierarchyBlock(const PooledMultiWayExplicitHierarchyBlock<DataType, Aggregate>& other) = delete;
+        ~PooledMultiWayExplicitHierarchyBlock() { if (sons_ != inlineSons_) { delete[] sons_; } sons_ = nullptr; degree_ = 0; }
+
+        static const size_t INLINE_SON_COUNT = 4;
+
+        PooledMultiWayExplicitHierarchyBlock<DataType, Aggregate>** sons_;
+        size_t degree_;
+        size_t capacity_;
+        PooledMultiWayExplicitHierarchyBlock<DataType, Aggregate>* inlineSons_[INLINE_SON_COUNT];
+
+        size_t depth_;
+        size_t subtreeSize_;
+        typename Aggregate::ValueType aggregate_;
+    };
+
+    template<typename DataType, typename Aggregate = NoAggregate<DataType>>
+    using PMWEHBlock = PooledMultiWayExplicitHierarchyBlock<DataType, Aggregate>;
+
+    /**
+     * @brief Multi-way hierarchy whose blocks are allocated from a pool and keep their sons inline.
+     *
+     * Has the same interface and son order semantics as MultiWayExplicitHierarchy, but creating a leaf costs
+     * no heap allocation in most cases: the block comes from a chunk of mm::PoolMemoryManager and has no
+     * separate sequence of sons.
+     *
+     * Depth and subtree size of every node are maintained by emplaceSon, changeSon and removeSon, so level,
+     * nodeCount and size take O(1). Moving a subtree by changeSon or changeRoot renumbers depths within it.
+     * Aggregate (see NoAggregate) of a subtree is available by aggregate(node) without traversal. Since data
+     * of nodes is written directly, refresh(node) must be called after data of node changed.
+     */
+    template<typename DataType, typename Aggregate = NoAggregate<DataType>>
+    class PooledMultiWayExplicitHierarchy :
+        public ExplicitHierarchy<PooledMultiWayExplicitHierarchyBlock<DataType, Aggregate>>
+    {
+    public:
+        using BlockType = PooledMultiWayExplicitHierarchyBlock<DataType, Aggregate>;
+        using AggregateType = typename Aggregate::ValueType;
+
+        PooledMultiWayExplicitHierarchy();
+        PooledMultiWayExplicitHierarchy(const PooledMultiWayExplicitHierarchy& other);
+        ~PooledMultiWayExplicitHierarchy() override;
+
+        AMT& assign(const AMT& other) override;
+        size_t size() const override;
+
+        size_t level(const BlockType& node) const override;
+        size_t degree(const BlockType& node) const override;
+        // Overload with one parameter hides overload with no parameter. We need to explicitly 'include' it.
+        using Hierarchy<BlockType>::nodeCount;
+        size_t nodeCount(const BlockType& node) const override;
+
+        /**
+         * @return Aggregate of data of all nodes in the subtree of node, in pre-order.
+         */
+        const AggregateType& aggregate(const BlockType& node) const;
+
+        /**
+         * @brief Updates aggregates of node and its ancestors after data of node changed.
+         */
+        void refresh(BlockType& node);
+
+        /**
+         * @brief Stops recomputing aggregates of ancestors on every change, for building a hierarchy from many nodes.
+         * Depths and subtree sizes are still maintained. Aggregates are stale until resumeAggregates is called.
+         */
+        void deferAggregates();
+
+        /**
+         * @brief Recomputes aggregates of all nodes in one post-order pass and maintains them on every change again.
+         */
+        void resumeAggregates();
+
+        BlockType* accessSon(const BlockType& node, size_t sonOrder) const override;
+
+        BlockType& emplaceRoot() override;
+        void changeRoot(BlockType* newRoot) override;
+
+        BlockType& emplaceSon(BlockType& parent, size_t sonOrder) override;
+        void changeSon(BlockType& parent, size_t sonOrder, BlockType* newSon) override;
+        void removeSon(BlockType& parent, size_t sonOrder) override;
+
+    private:
+        static constexpr bool HAS_AGGREGATE = !std::is_same_v<Aggregate, NoAggregate<DataType>>;
+
+        static void ensureSonCapacity(BlockType& parent);
+        static void updateAggregate(BlockType& node);
+        void renumberDepths(BlockType& subtreeRoot, size_t depth);
+
+        /**
+         * @brief Adds sizeDifference to subtree sizes of node and its ancestors and recomputes their aggregates.
+         */
+        void updateAncestors(BlockType* node, std::ptrdiff_t sizeDifference);
+
+    private:
+        bool aggregatesDeferred_;
+    };
+
+    template<typename DataType, typename Aggregate = NoAggregate<DataType>>
+    using PooledMultiWayEH = PooledMultiWayExplicitHierarchy<DataType, Aggregate>;
+
+    //----------
+
     template<typename DataType, size_t K>
     struct KWayExplicitHierarchyBlock :
         public ExplicitHierarchyBlock<DataType>
@@ -127,11 +278,123 @@ namespace ds::amt {
 
     //----------
 
+    /**
+     * @brief Sons of a K-way block kept in an array of K slots inside the block.
+     */
+    template<typename BlockType, size_t K>
+    struct DenseKWaySons
+    {
+        DenseKWaySons() : sons_(), degree_(0) {}
+
+        BlockType* access(size_t sonOrder) const { return sonOrder < K ? sons_[sonOrder] : nullptr; }
+
+        /**
+         * @brief Puts son (or nullptr) to slot sonOrder.
+         * @return Previous son in the slot.
+         */
+        BlockType* exchange(size_t sonOrder, BlockType* son);
+
+        std::array<BlockType*, K> sons_;
+        size_t degree_;
+    };
+
+    /**
+     * @brief Sons of a K-way block kept as a bitmap of present orders and a packed array of present sons.
+     *
+     * Son with order sonOrder is at the position given by the number of present sons with a lower order, so an
+     * access costs a few popcounts. The packed array is allocated when the first son is added and doubles when
+     * needed, a leaf therefore carries only the bitmap.
+     */
+    template<typename BlockType, size_t K>
+    struct SparseKWaySons
+    {
+        SparseKWaySons() : present_(), sons_(nullptr), degree_(0), capacity_(0) {}
+        SparseKWaySons(const SparseKWaySons<BlockType, K>& other) = delete;
+        ~SparseKWaySons() { delete[] sons_; sons_ = nullptr; degree_ = 0; }
+
+        static const size_t WORD_COUNT = (K + 63) / 64;
+
+        BlockType* access(size_t sonOrder) const;
+
+        /**
+         * @brief Puts son (or nullptr) to order sonOrder.
+         * @return Previous son with the order.
+         */
+        BlockType* exchange(size_t sonOrder, BlockType* son);
+
+        bool isPresent(size_t sonOrder) const { return (present_[sonOrder / 64] >> (sonOrder % 64)) & 1; }
+        size_t rank(size_t sonOrder) const;
+
+        std::array<uint64_t, WORD_COUNT> present_;
+        BlockType** sons_;
+        size_t degree_;
+        size_t capacity_;
+    };
+
+    /**
+     * @brief Block of a K-way hierarchy that keeps its sons inside the block.
+     *
+     * Up to DENSE_SON_LIMIT sons are stored in an array of K slots, larger K use a bitmap and a packed array
+     * (see SparseKWaySons), so a block with K = 256 does not carry 2 kB of mostly empty slots.
+     */
+    template<typename DataType, size_t K>
+    struct InlineKWayExplicitHierarchyBlock :
+        public ExplicitHierarchyBlock<DataType>
+    {
+        static const size_t DENSE_SON_LIMIT = 16;
+
+        using SonsType = std::conditional_t<
+            K <= DENSE_SON_LIMIT,
+            DenseKWaySons<InlineKWayExplicitHierarchyBlock<DataType, K>, K>,
+            SparseKWaySons<InlineKWayExplicitHierarchyBlock<DataType, K>, K>
+        >;
+
+        SonsType sons_;
+    };
+
+    template<typename DataType, size_t K>
+    using IKWEHBlock = InlineKWayExplicitHierarchyBlock<DataType, K>;
+
+    /**
+     * @brief K-way hierarchy whose blocks are allocated from a pool and keep their sons inline.
+     *
+     * Has the same son order semantics as KWayExplicitHierarchy, but a node is a single allocation from a chunk
+     * of mm::PoolMemoryManager instead of a block, a sequence and its array, and accessing a son follows one
+     * pointer instead of three. Degree is kept in the block, so degree takes O(1).
+     */
+    template<typename DataType, size_t K>
+    class InlineKWayExplicitHierarchy :
+        public KWayHierarchy<InlineKWayExplicitHierarchyBlock<DataType, K>, K>,
+        public ExplicitHierarchy<InlineKWayExplicitHierarchyBlock<DataType, K>>
+    {
+    public:
+        using BlockType = InlineKWayExplicitHierarchyBlock<DataType, K>;
+
+        InlineKWayExplicitHierarchy();
+        InlineKWayExplicitHierarchy(const InlineKWayExplicitHierarchy& other);
+        ~InlineKWayExplicitHierarchy() override;
+
+        size_t degree(const BlockType& node) const override;
+
+        BlockType* accessSon(const BlockType& node, size_t sonOrder) const override;
+
+        BlockType& emplaceSon(BlockType& parent, size_t sonOrder) override;
+        void changeSon(BlockType& parent, size_t sonOrder, BlockType* newSon) override;
+        void removeSon(BlockType& parent, size_t sonOrder) override;
+    };
+
+    template<typename DataType, size_t K>
+    using InlineKWayEH = InlineKWayExplicitHierarchy<DataType, K>;
+
+    //----------
+
     template<typename DataType>
     struct BinaryExplicitHierarchyBlock :
         public ExplicitHierarchyBlock<DataType>
     {
         BinaryExplicitHierarchyBlock() : left_(nullptr), right_(nullptr) {}
+        template<typename Factory>
+        BinaryExplicitHierarchyBlock(FactoryTag tag, const Factory& factory) : ExplicitHierarchyBlock<DataType>(tag, factory), left_(nullptr), right_(nullptr) {}
         ~BinaryExplicitHierarchyBlock() { left_ = nullptr; right_ = nullptr; }
 
         BinaryExplicitHierarchyBlock<DataType>* left_;
@@ -173,6 +436,14 @@ namespace ds::amt {
         BlockType& insertLeftSon(BlockType& parent);
         BlockType& insertRightSon(BlockType& parent);
 
+        /**
+         * @brief Inserts a son whose data is the result of @p factory, constructed right in the block.
+         */
+        template<typename Factory>
+        BlockType& insertLeftSonFrom(BlockType& parent, const Factory& factory);
+        template<typename Factory>
+        BlockType& insertRightSonFrom(BlockType& parent, const Factory& factory);
+
         void changeLeftSon(BlockType& parent, BlockType* newSon);
         void changeRightSon(BlockType& parent, BlockType* newSon);
 
@@ -191,6 +462,13 @@ namespace ds::amt {
     {
     }
 
+    template<typename BlockType>
+    ExplicitHierarchy<BlockType>::ExplicitHierarchy(mm::MemoryManager<BlockType>* memoryManager) :
+        ExplicitAMS<BlockType>(memoryManager),
+        root_(nullptr)
+    {
+    }
+
     template<typename BlockType>
     ExplicitHierarchy<BlockType>::ExplicitHierarchy(const ExplicitHierarchy& other) :
         ExplicitHierarchy()
@@ -329,6 +607,14 @@ namespace ds::amt {
         return *root_;
     }
 
+    template<typename BlockType>
+    template<typename Factory>
+    BlockType& ExplicitHierarchy<BlockType>::emplaceRootFrom(const Factory& factory)
+    {
+        root_ = AMS<BlockType>::memoryManager_->emplaceMemory(FactoryTag(), factory);
+        return *root_;
+    }
+
     template<typename BlockType>
     void ExplicitHierarchy<BlockType>::changeRoot(BlockType* newRoot)
     {
@@ -407,6 +693,264 @@ namespace ds::amt {
         parent.sons_->remove(sonOrder);
     }
 
+    template<typename DataType, typename Aggregate>
+    PooledMultiWayExplicitHierarchy<DataType, Aggregate>::PooledMultiWayExplicitHierarchy() :
+        ExplicitHierarchy<PooledMultiWayExplicitHierarchyBlock<DataType, Aggregate>>(new mm::PoolMemoryManager<BlockType>()),
+        aggregatesDeferred_(false)
+    {
+    }
+
+    template<typename DataType, typename Aggregate>
+    PooledMultiWayExplicitHierarchy<DataType, Aggregate>::PooledMultiWayExplicitHierarchy(const PooledMultiWayExplicitHierarchy& other) :
+        PooledMultiWayExplicitHierarchy()
+    {
+        this->assign(other);
+    }
+
+    template<typename DataType, typename Aggregate>
+    PooledMultiWayExplicitHierarchy<DataType, Aggregate>::~PooledMultiWayExplicitHierarchy()
+    {
+        this->clear();
+    }
+
+    template<typename DataType, typename Aggregate>
+    AMT& PooledMultiWayExplicitHierarchy<DataType, Aggregate>::assign(const AMT& other)
+    {
+        // Data is copied after sons are emplaced, so aggregates are computed once the copy is complete.
+        const bool wasDeferred = aggregatesDeferred_;
+        this->deferAggregates();
+        ExplicitHierarchy<BlockType>::assign(other);
+        if (!wasDeferred)
+        {
+            this->resumeAggregates();
+        }
+        return *this;
+    }
+
+    template<typename DataType, typename Aggregate>
+    size_t PooledMultiWayExplicitHierarchy<DataType, Aggregate>::size() const
+    {
+        return this->root_ != nullptr ? this->root_->subtreeSize_ : 0;
+    }
+
+    template<typename DataType, typename Aggregate>
+    size_t PooledMultiWayExplicitHierarchy<DataType, Aggregate>::level(const BlockType& node) const
+    {
+        return node.depth_;
+    }
+
+    template<typename DataType, typename Aggregate>
+    size_t PooledMultiWayExplicitHierarchy<DataType, Aggregate>::degree(const BlockType& node) const
+    {
+        return node.degree_;
+    }
+
+    template<typename DataType, typename Aggregate>
+    size_t PooledMultiWayExplicitHierarchy<DataType, Aggregate>::nodeCount(const BlockType& node) const
+    {
+        return node.subtreeSize_;
+    }
+
+    template<typename DataType, typename Aggregate>
+    auto PooledMultiWayExplicitHierarchy<DataType, Aggregate>::aggregate(const BlockType& node) const -> const AggregateType&
+    {
+        return node.aggregate_;
+    }
+
+    template<typename DataType, typename Aggregate>
+    void PooledMultiWayExplicitHierarchy<DataType, Aggregate>::refresh(BlockType& node)
+    {
+        this->updateAncestors(&node, 0);
+    }
+
+    template<typename DataType, typename Aggregate>
+    void PooledMultiWayExplicitHierarchy<DataType, Aggregate>::deferAggregates()
+    {
+        aggregatesDeferred_ = true;
+    }
+
+    template<typename DataType, typename Aggregate>
+    void PooledMultiWayExplicitHierarchy<DataType, Aggregate>::resumeAggregates()
+    {
+        aggregatesDeferred_ = false;
+        if constexpr (HAS_AGGREGATE)
+        {
+            Hierarchy<BlockType>::processPostOrder(this->root_, [](BlockType* node)
+            {
+                updateAggregate(*node);
+            });
+        }
+    }
+
+    template<typename DataType, typename Aggregate>
+    auto PooledMultiWayExplicitHierarchy<DataType, Aggregate>::accessSon(const BlockType& node, size_t sonOrder) const -> BlockType*
+    {
+        return sonOrder < node.degree_ ? node.sons_[sonOrder] : nullptr;
+    }
+
+    template<typename DataType, typename Aggregate>
+    auto PooledMultiWayExplicitHierarchy<DataType, Aggregate>::emplaceRoot() -> BlockType&
+    {
+        BlockType& root = ExplicitHierarchy<BlockType>::emplaceRoot();
+        updateAggregate(root);
+        return root;
+    }
+
+    template<typename DataType, typename Aggregate>
+    void PooledMultiWayExplicitHierarchy<DataType, Aggregate>::changeRoot(BlockType* newRoot)
+    {
+        ExplicitHierarchy<BlockType>::changeRoot(newRoot);
+        if (newRoot != nullptr)
+        {
+            this->renumberDepths(*newRoot, 0);
+        }
+    }
+
+    template<typename DataType, typename Aggregate>
+    auto PooledMultiWayExplicitHierarchy<DataType, Aggregate>::emplaceSon(BlockType& parent, size_t sonOrder) -> BlockType&
+    {
+        if (sonOrder > parent.degree_)
+        {
+            throw std::out_of_range("Invalid son order!");
+        }
+
+        ensureSonCapacity(parent);
+        BlockType* newSon = AbstractMemoryStructure<BlockType>::memoryManager_->allocateMemory();
+        for (size_t i = parent.degree_; i > sonOrder; --i)
+        {
+            parent.sons_[i] = parent.sons_[i - 1];
+        }
+        parent.sons_[sonOrder] = newSon;
+        ++parent.degree_;
+        newSon->parent_ = &parent;
+        newSon->depth_ = parent.depth_ + 1;
+        updateAggregate(*newSon);
+        this->updateAncestors(&parent, 1);
+        return *newSon;
+    }
+
+    template<typename DataType, typename Aggregate>
+    void PooledMultiWayExplicitHierarchy<DataType, Aggregate>::changeSon(BlockType& parent, size_t sonOrder, BlockType* newSon)
+    {
+        if (sonOrder >= parent.degree_)
+        {
+            throw std::out_of_range("Invalid son order!");
+        }
+
+        BlockType* oldSon = parent.sons_[sonOrder];
+        parent.sons_[sonOrder] = newSon;
+
+        std::ptrdiff_t sizeDifference = 0;
+        if (oldSon != nullptr)
+        {
+            oldSon->parent_ = nullptr;
+            sizeDifference -= static_cast<std::ptrdiff_t>(oldSon->subtreeSize_);
+        }
+        if (newSon != nullptr)
+        {
+            newSon->parent_ = &parent;
+            sizeDifference += static_cast<std::ptrdiff_t>(newSon->subtreeSize_);
+            if (newSon->depth_ != parent.depth_ + 1)
+            {
+                this->renumberDepths(*newSon, parent.depth_ + 1);
+            }
+        }
+        this->updateAncestors(&parent, sizeDifference);
+    }
+
+    template<typename DataType, typename Aggregate>
+    void PooledMultiWayExplicitHierarchy<DataType, Aggregate>::removeSon(BlockType& parent, size_t sonOrder)
+    {
+        if (sonOrder >= parent.degree_)
+        {
+            throw std::out_of_range("Invalid son order!");
+        }
+
+        BlockType* removedSon = parent.sons_[sonOrder];
+        const std::ptrdiff_t removedSize = removedSon != nullptr ? static_cast<std::ptrdiff_t>(removedSon->subtreeSize_) : 0;
+
+        Hierarchy<BlockType>::processPostOrder(removedSon, [&](BlockType* b)
+        {
+            AbstractMemoryStructure<BlockType>::memoryManager_->releaseMemory(b);
+        });
+
+        --parent.degree_;
+        for (size_t i = sonOrder; i < parent.degree_; ++i)
+        {
+            parent.sons_[i] = parent.sons_[i + 1];
+        }
+        this->updateAncestors(&parent, -removedSize);
+    }
+
+    template<typename DataType, typename Aggregate>
+    void PooledMultiWayExplicitHierarchy<DataType, Aggregate>::ensureSonCapacity(BlockType& parent)
+    {
+        if (parent.degree_ < parent.capacity_)
+        {
+            return;
+        }
+
+        BlockType** sons = new BlockType*[2 * parent.capacity_];
+        for (size_t i = 0; i < parent.degree_; ++i)
+        {
+            sons[i] = parent.sons_[i];
+        }
+        if (parent.sons_ != parent.inlineSons_)
+        {
+            delete[] parent.sons_;
+        }
+        parent.sons_ = sons;
+        parent.capacity_ *= 2;
+    }
+
+    template<typename DataType, typename Aggregate>
+    void PooledMultiWayExplicitHierarchy<DataType, Aggregate>::updateAggregate(BlockType& node)
+    {
+        if constexpr (HAS_AGGREGATE)
+        {
+            AggregateType aggregate = Aggregate::of(node.data_);
+            for (size_t i = 0; i < node.degree_; ++i)
+            {
+                if (node.sons_[i] != nullptr)
+                {
+                    aggregate = Aggregate::combine(aggregate, node.sons_[i]->aggregate_);
+                }
+            }
+            node.aggregate_ = std::move(aggregate);
+        }
+    }
+
+    template<typename DataType, typename Aggregate>
+    void PooledMultiWayExplicitHierarchy<DataType, Aggregate>::renumberDepths(BlockType& subtreeRoot, size_t depth)
+    {
+        const size_t depthDifference = depth - subtreeRoot.depth_;
+        Hierarchy<BlockType>::processLevelOrder(&subtreeRoot, [depthDifference](BlockType* node)
+        {
+            node->depth_ += depthDifference;
+        });
+    }
+
+    template<typename DataType, typename Aggregate>
+    void PooledMultiWayExplicitHierarchy<DataType, Aggregate>::updateAncestors(BlockType* node, std::ptrdiff_t sizeDifference)
+    {
+        // Sizes and depths are kept for every Aggregate, the ancestors are walked only when there is work.
+        const bool updatesAggregates = HAS_AGGREGATE && !aggregatesDeferred_;
+        if (sizeDifference == 0 && !updatesAggregates)
+        {
+            return;
+        }
+
+        while (node != nullptr)
+        {
+            node->subtreeSize_ = static_cast<size_t>(static_cast<std::ptrdiff_t>(node->subtreeSize_) + sizeDifference);
+            if (updatesAggregates)
+            {
+                updateAggregate(*node);
+            }
+            node = static_cast<BlockType*>(node->parent_);
+        }
+    }
+
     template<typename DataType, size_t K>
     KWayExplicitHierarchy<DataType, K>::KWayExplicitHierarchy() :
         ExplicitHierarchy<KWayExplicitHierarchyBlock<DataType, K>>()
@@ -483,6 +1027,154 @@ namespace ds::amt {
         sonBlock->data_ = nullptr;
     }
 
+    template<typename BlockType, size_t K>
+    BlockType* DenseKWaySons<BlockType, K>::exchange(size_t sonOrder, BlockType* son)
+    {
+        BlockType* previous = sons_[sonOrder];
+        sons_[sonOrder] = son;
+        degree_ = degree_ + (son != nullptr ? 1 : 0) - (previous != nullptr ? 1 : 0);
+        return previous;
+    }
+
+    template<typename BlockType, size_t K>
+    BlockType* SparseKWaySons<BlockType, K>::access(size_t sonOrder) const
+    {
+        return sonOrder < K && this->isPresent(sonOrder) ? sons_[this->rank(sonOrder)] : nullptr;
+    }
+
+    template<typename BlockType, size_t K>
+    BlockType* SparseKWaySons<BlockType, K>::exchange(size_t sonOrder, BlockType* son)
+    {
+        const size_t position = this->rank(sonOrder);
+        const uint64_t bit = uint64_t(1) << (sonOrder % 64);
+
+        if (this->isPresent(sonOrder))
+        {
+            BlockType* previous = sons_[position];
+            if (son != nullptr)
+            {
+                sons_[position] = son;
+            }
+            else
+            {
+                std::move(sons_ + position + 1, sons_ + degree_, sons_ + position);
+                --degree_;
+                present_[sonOrder / 64] &= ~bit;
+            }
+            return previous;
+        }
+
+        if (son != nullptr)
+        {
+            if (degree_ == capacity_)
+            {
+                const size_t newCapacity = std::min(K, std::max<size_t>(2 * capacity_, 2));
+                BlockType** newSons = new BlockType*[newCapacity];
+                std::copy(sons_, sons_ + degree_, newSons);
+                delete[] sons_;
+                sons_ = newSons;
+                capacity_ = newCapacity;
+            }
+            std::move_backward(sons_ + position, sons_ + degree_, sons_ + degree_ + 1);
+            sons_[position] = son;
+            ++degree_;
+            present_[sonOrder / 64] |= bit;
+        }
+        return nullptr;
+    }
+
+    template<typename BlockType, size_t K>
+    size_t SparseKWaySons<BlockType, K>::rank(size_t sonOrder) const
+    {
+        const size_t word = sonOrder / 64;
+        size_t result = 0;
+        for (size_t i = 0; i < word; ++i)
+        {
+            result += popCount(present_[i]);
+        }
+        const uint64_t lowerBits = (uint64_t(1) << (sonOrder % 64)) - 1;
+        return result + popCount(present_[word] & lowerBits);
+    }
+
+    template<typename DataType, size_t K>
+    InlineKWayExplicitHierarchy<DataType, K>::InlineKWayExplicitHierarchy() :
+        ExplicitHierarchy<InlineKWayExplicitHierarchyBlock<DataType, K>>(new mm::PoolMemoryManager<BlockType>())
+    {
+    }
+
+    template<typename DataType, size_t K>
+    InlineKWayExplicitHierarchy<DataType, K>::InlineKWayExplicitHierarchy(const InlineKWayExplicitHierarchy& other) :
+        InlineKWayExplicitHierarchy()
+    {
+        this->assign(other);
+    }
+
+    template<typename DataType, size_t K>
+    InlineKWayExplicitHierarchy<DataType, K>::~InlineKWayExplicitHierarchy()
+    {
+        this->clear();
+    }
+
+    template<typename DataType, size_t K>
+    size_t InlineKWayExplicitHierarchy<DataType, K>::degree(const BlockType& node) const
+    {
+        return node.sons_.degree_;
+    }
+
+    template<typename DataType, size_t K>
+    auto InlineKWayExplicitHierarchy<DataType, K>::accessSon(const BlockType& node, size_t sonOrder) const -> BlockType*
+    {
+        return node.sons_.access(sonOrder);
+    }
+
+    template<typename DataType, size_t K>
+    auto InlineKWayExplicitHierarchy<DataType, K>::emplaceSon(BlockType& parent, size_t sonOrder) -> BlockType&
+    {
+        if (sonOrder >= K)
+        {
+            throw std::out_of_range("Invalid son order!");
+        }
+        if (parent.sons_.access(sonOrder) != nullptr)
+        {
+            throw std::invalid_argument("Son already exists!");
+        }
+
+        BlockType* newSon = AbstractMemoryStructure<BlockType>::memoryManager_->allocateMemory();
+        parent.sons_.exchange(sonOrder, newSon);
+        newSon->parent_ = &parent;
+        return *newSon;
+    }
+
+    template<typename DataType, size_t K>
+    void InlineKWayExplicitHierarchy<DataType, K>::changeSon(BlockType& parent, size_t sonOrder, BlockType* newSon)
+    {
+        if (sonOrder >= K)
+        {
+            throw std::out_of_range("Invalid son order!");
+        }
+
+        BlockType* oldSon = parent.sons_.exchange(sonOrder, newSon);
+
+        if (oldSon != nullptr) { oldSon->parent_ = nullptr; }
+        if (newSon != nullptr) { newSon->parent_ = &parent; }
+    }
+
+    template<typename DataType, size_t K>
+    void InlineKWayExplicitHierarchy<DataType, K>::removeSon(BlockType& parent, size_t sonOrder)
+    {
+        if (sonOrder >= K)
+        {
+            throw std::out_of_range("Invalid son order!");
+        }
+
+        BlockType* removedSon = parent.sons_.exchange(sonOrder, nullptr);
+
+        Hierarchy<BlockType>::processPostOrder(removedSon, [&](BlockType* b)
+        {
+            AbstractMemoryStructure<BlockType>::memoryManager_->releaseMemory(b);
+        });
+    }
+
     template<typename DataType>
     BinaryExplicitHierarchy<DataType>::BinaryExplicitHierarchy() :
         ExplicitHierarchy<BinaryExplicitHierarchyBlock<DataType>>()
@@ -618,6 +1310,26 @@ namespace ds::amt {
         return *newSon;
     }
 
+    template<typename DataType>
+    template<typename Factory>
+    auto BinaryExplicitHierarchy<DataType>::insertLeftSonFrom(BlockType& parent, const Factory& factory) -> BlockType&
+    {
+        BlockType* newSon = AbstractMemoryStructure<BlockType>::memoryManager_->emplaceMemory(FactoryTag(), factory);
+        parent.left_ = newSon;
+        newSon->parent_ = &parent;
+        return *newSon;
+    }
+
+    template<typename DataType>
+    template<typename Factory>
+    auto BinaryExplicitHierarchy<DataType>::insertRightSonFrom(BlockType& parent, const Factory& factory) -> BlockType&
+    {
+        BlockType* newSon = AbstractMemoryStructure<BlockType>::memoryManager_->emplaceMemory(FactoryTag(), factory);
+        parent.right_ = newSon;
+        newSon->parent_ = &parent;
+        return *newSon;
+    }
+
     template<typename DataType>
     void BinaryExplicitHierarchy<DataType>::changeLeftSon(BlockType& parent, BlockType* newSon)
     {
@@ -4,7 +4,12 @@
 #include <libds/amt/network.h>
 #include <libds/amt/implicit_sequence.h>
 #include <libds/amt/explicit_sequence.h>
+#include <libds/amt/compressed_network.h>
+#include <libds/amt/adaptive_relation_set.h>
+#include <algorithm>
 #include <functional>
+#include <utility>
+#include <vector>
 
 namespace ds::amt {
 
@@ -38,6 +43,21 @@ namespace ds::amt {
 	template<typename DataType>
 	using ERNetworkBlock = NetworkBlockExplicitRelations<DataType>;
 
+	template<typename DataType>
+	struct NetworkBlockHashedRelations :
+		public MemoryBlock<DataType>
+	{
+		using RelationBlockType = typename AdaptiveRelationSet<NetworkBlockHashedRelations<DataType>*>::BlockType;
+
+		NetworkBlockHashedRelations() : relations_(new AdaptiveRelationSet<NetworkBlockHashedRelations<DataType>*>()) {}
+		~NetworkBlockHashedRelations() { delete relations_; relations_ = nullptr; }
+
+		AdaptiveRelationSet<NetworkBlockHashedRelations<DataType>*>* relations_;
+	};
+
+	template<typename DataType>
+	using HRNetworkBlock = NetworkBlockHashedRelations<DataType>;
+
 	//----------
 
 	template<typename BlockType, typename GateType>
@@ -51,7 +71,7 @@ namespace ds::amt {
 		using IteratorType = typename GateType::IteratorType;
 
 		ExplicitNetwork() : gate_(new GateType()) {}
-		~ExplicitNetwork() override { delete gate_; gate_ = nullptr; }
+		~ExplicitNetwork() override { ExplicitNetwork::clear(); delete gate_; gate_ = nullptr; }
 
 		AMT& assign(const AMT& other) override;
 		void clear() override;
@@ -72,10 +92,41 @@ namespace ds::amt {
 		void connect(BlockType& nodeA, BlockType& nodeB) override;
 		void disconnect(BlockType& nodeA, BlockType& nodeB) override;
 
+		/**
+		 * @brief Creates an immutable copy of the network in the compressed sparse row format.
+		 * Node i of the result is the node at gate order i.
+		 */
+		CompressedNetwork<typename BlockType::DataT> freeze() const;
+
 		IteratorType begin();
 		IteratorType end();
 
 	protected:
+		using GateOrderLookup = std::vector<std::pair<const BlockType*, size_t>>;
+
+		/**
+		 * @brief Pairs (node, gate order) sorted by node address, so relations can be resolved to gate orders in O(log n).
+		 */
+		GateOrderLookup createGateOrderLookup() const;
+		static size_t findGateOrder(const GateOrderLookup& lookup, const BlockType* node);
+
+		/**
+		 * @brief Operations on relations of a node. Sequences are searched linearly, hashed relation sets in expected O(1).
+		 */
+		template<typename RelationsType>
+		static void insertRelation(RelationsType& relations, BlockType* node);
+		template<typename RelationsType>
+		static bool containsRelation(const RelationsType& relations, const BlockType* node);
+		template<typename RelationsType>
+		static void removeRelation(RelationsType& relations, const BlockType* node);
+
+		template<typename RelationDataType>
+		static void insertRelation(AdaptiveRelationSet<RelationDataType>& relations, BlockType* node);
+		template<typename RelationDataType>
+		static bool containsRelation(const AdaptiveRelationSet<RelationDataType>& relations, const BlockType* node);
+		template<typename RelationDataType>
+		static void removeRelation(AdaptiveRelationSet<RelationDataType>& relations, const BlockType* node);
+
 		GateType* gate_;
 	};
 
@@ -115,6 +166,24 @@ namespace ds::amt {
 	template<typename DataType>
 	using EGERNetwork = ExplicitGateExplicitRelationsNetwork<DataType>;
 
+	template<typename DataType>
+	class ImplicitGateHashedRelationsNetwork :
+		public ExplicitNetwork<HRNetworkBlock<DataType>, IS<HRNetworkBlock<DataType>*>>
+	{
+	};
+
+	template<typename DataType>
+	using IGHRNetwork = ImplicitGateHashedRelationsNetwork<DataType>;
+
+	template<typename DataType>
+	class ExplicitGateHashedRelationsNetwork :
+		public ExplicitNetwork<HRNetworkBlock<DataType>, DoublyLS<HRNetworkBlock<DataType>*>>
+	{
+	};
+
+	template<typename DataType>
+	using EGHRNetwork = ExplicitGateHashedRelationsNetwork<DataType>;
+
 	//----------
 
 	template<typename BlockType, typename GateType>
@@ -125,35 +194,27 @@ namespace ds::amt {
 			clear();
 
 			const ExplicitNetwork<BlockType, GateType>& otherExplicitNetwork = dynamic_cast<const  ExplicitNetwork<BlockType, GateType>&>(other);
+			const GateOrderLookup otherLookup = otherExplicitNetwork.createGateOrderLookup();
 
-			otherExplicitNetwork.gate_->processAllBlocksForward([&](GateBlockType* b) { insert().data_ = b->data_->data_; });
-
-			GateBlockType* myBlockFrom = gate_->accessFirst();
-			GateBlockType* otherBlockFrom = otherExplicitNetwork.gate_->accessFirst();
-
-			while (otherBlockFrom != nullptr)
-			{
-				otherBlockFrom->data_->relations_->processAllBlocksForward([&](RelationsBlockType* otherRelationsBlock)
-					{
-						size_t otherGateIndexTo = 0;
-						otherExplicitNetwork.gate_->findBlockWithProperty([&](GateBlockType* otherGateBlockIndexTo)->bool
-							{
-								if (otherGateBlockIndexTo->data_ == otherRelationsBlock->data_)
-								{
-									return true;
-								}
-								else {
-									otherGateIndexTo++;
-									return false;
-								}
-							});
-						GateBlockType* myBlockTo = gate_->access(otherGateIndexTo);
-						connect(*myBlockFrom->data_, *myBlockTo->data_);
-					});
+			std::vector<BlockType*> myNodes;
+			myNodes.reserve(otherExplicitNetwork.size());
+			otherExplicitNetwork.gate_->processAllBlocksForward([&](GateBlockType* b)
+				{
+					BlockType& node = insert();
+					node.data_ = b->data_->data_;
+					myNodes.push_back(&node);
+				});
 
-				myBlockFrom = gate_->accessNext(*myBlockFrom);
-				otherBlockFrom = otherExplicitNetwork.gate_->accessNext(*otherBlockFrom);
-			}
+			// Relations are copied one direction at a time so that their order is preserved.
+			size_t order = 0;
+			otherExplicitNetwork.gate_->processAllBlocksForward([&](GateBlockType* otherBlockFrom)
+				{
+					otherBlockFrom->data_->relations_->processAllBlocksForward([&](RelationsBlockType* otherRelationsBlock)
+						{
+							insertRelation(*myNodes[order]->relations_, myNodes[findGateOrder(otherLookup, otherRelationsBlock->data_)]);
+						});
+					++order;
+				});
 		}
 		return *this;
 	}
@@ -236,13 +297,9 @@ namespace ds::amt {
 	template<typename BlockType, typename GateType>
     bool ExplicitNetwork<BlockType, GateType>::relationExists(const BlockType& nodeA, const BlockType& nodeB) const
 	{
-		std::function<bool(const BlockType&, const BlockType&)> relationExists;
-		relationExists = [](const BlockType& vrcholOd, const BlockType& vrcholDo)->bool
-		{
-			return vrcholOd.relations_->findBlockWithProperty([&vrcholDo](RelationsBlockType* b)->bool {return b->data_ == &vrcholDo; }) != nullptr;
-		};
-
-		return degree(nodeA) <= degree(nodeB) ? relationExists(nodeA, nodeB) : relationExists(nodeB, nodeA);
+		return degree(nodeA) <= degree(nodeB)
+			? containsRelation(*nodeA.relations_, &nodeB)
+			: containsRelation(*nodeB.relations_, &nodeA);
 	}
 
 	template<typename BlockType, typename GateType>
@@ -281,33 +338,123 @@ namespace ds::amt {
 	template<typename BlockType, typename GateBlock>
     void ExplicitNetwork<BlockType, GateBlock>::connect(BlockType& nodeA, BlockType& nodeB)
 	{
-		nodeA.relations_->insertLast().data_ = &nodeB;
-		nodeB.relations_->insertLast().data_ = &nodeA;
+		insertRelation(*nodeA.relations_, &nodeB);
+		insertRelation(*nodeB.relations_, &nodeA);
 	}
 
 	template<typename BlockType, typename GateBlock>
     void ExplicitNetwork<BlockType, GateBlock>::disconnect(BlockType& nodeA, BlockType& nodeB)
 	{
-		std::function<void(const BlockType&, const BlockType&)> disconnectRelation;
-		disconnectRelation = [](const BlockType& nodeFrom, const BlockType& nodeTo)
-		{
+		removeRelation(*nodeA.relations_, &nodeB);
+		removeRelation(*nodeB.relations_, &nodeA);
+	}
 
-			if (nodeFrom.relations_->accessFirst()->data_ == &nodeTo)
-			{
-				nodeFrom.relations_->removeFirst();
-			}
-			else
+	template<typename BlockType, typename GateType>
+    CompressedNetwork<typename BlockType::DataT> ExplicitNetwork<BlockType, GateType>::freeze() const
+	{
+		const GateOrderLookup lookup = this->createGateOrderLookup();
+
+		CompressedNetwork<typename BlockType::DataT> result(this->size(), this->relationCount());
+		typename CompressedNetwork<typename BlockType::DataT>::BlockType* nodes = result.accessNodes();
+		size_t* offsets = result.accessOffsets();
+		size_t* neighbours = result.accessNeighbours();
+
+		size_t order = 0;
+		size_t position = 0;
+		gate_->processAllBlocksForward([&](GateBlockType* gateBlock)
 			{
-				RelationsBlockType* prevInRelationsFrom = nodeFrom.relations_->findPreviousToBlockWithProperty([&nodeTo](RelationsBlockType* b) -> bool
+				nodes[order].data_ = gateBlock->data_->data_;
+				offsets[order] = position;
+				gateBlock->data_->relations_->processAllBlocksForward([&](RelationsBlockType* relationsBlock)
 					{
-						return b->data_ == &nodeTo;
+						neighbours[position] = findGateOrder(lookup, relationsBlock->data_);
+						++position;
 					});
-				nodeFrom.relations_->removeNext(*prevInRelationsFrom);
-			}
-		};
+				std::sort(neighbours + offsets[order], neighbours + position);
+				++order;
+			});
+		offsets[order] = position;
 
-		disconnectRelation(nodeA, nodeB);
-		disconnectRelation(nodeB, nodeA);
+		return result;
+	}
+
+	template<typename BlockType, typename GateType>
+    typename ExplicitNetwork<BlockType, GateType>::GateOrderLookup ExplicitNetwork<BlockType, GateType>::createGateOrderLookup() const
+	{
+		GateOrderLookup lookup;
+		lookup.reserve(gate_->size());
+		gate_->processAllBlocksForward([&lookup](GateBlockType* b)
+			{
+				lookup.emplace_back(b->data_, lookup.size());
+			});
+		std::sort(lookup.begin(), lookup.end(), [](const auto& a, const auto& b)
+			{
+				return std::less<const BlockType*>()(a.first, b.first);
+			});
+		return lookup;
+	}
+
+	template<typename BlockType, typename GateType>
+    size_t ExplicitNetwork<BlockType, GateType>::findGateOrder(const GateOrderLookup& lookup, const BlockType* node)
+	{
+		auto it = std::lower_bound(lookup.begin(), lookup.end(), node, [](const auto& item, const BlockType* key)
+			{
+				return std::less<const BlockType*>()(item.first, key);
+			});
+		return it->second;
+	}
+
+	template<typename BlockType, typename GateType>
+	template<typename RelationsType>
+    void ExplicitNetwork<BlockType, GateType>::insertRelation(RelationsType& relations, BlockType* node)
+	{
+		relations.insertLast().data_ = node;
+	}
+
+	template<typename BlockType, typename GateType>
+	template<typename RelationsType>
+    bool ExplicitNetwork<BlockType, GateType>::containsRelation(const RelationsType& relations, const BlockType* node)
+	{
+		return relations.findBlockWithProperty([node](RelationsBlockType* b)->bool { return b->data_ == node; }) != nullptr;
+	}
+
+	template<typename BlockType, typename GateType>
+	template<typename RelationsType>
+    void ExplicitNetwork<BlockType, GateType>::removeRelation(RelationsType& relations, const BlockType* node)
+	{
+		if (relations.accessFirst()->data_ == node)
+		{
+			relations.removeFirst();
+		}
+		else
+		{
+			RelationsBlockType* prevInRelations = relations.findPreviousToBlockWithProperty([node](RelationsBlockType* b) -> bool
+				{
+					return b->data_ == node;
+				});
+			relations.removeNext(*prevInRelations);
+		}
+	}
+
+	template<typename BlockType, typename GateType>
+	template<typename RelationDataType>
+    void ExplicitNetwork<BlockType, GateType>::insertRelation(AdaptiveRelationSet<RelationDataType>& relations, BlockType* node)
+	{
+		relations.insert(node);
+	}
+
+	template<typename BlockType, typename GateType>
+	template<typename RelationDataType>
+    bool ExplicitNetwork<BlockType, GateType>::containsRelation(const AdaptiveRelationSet<RelationDataType>& relations, const BlockType* node)
+	{
+		return relations.contains(const_cast<BlockType*>(node));
+	}
+
+	template<typename BlockType, typename GateType>
+	template<typename RelationDataType>
+    void ExplicitNetwork<BlockType, GateType>::removeRelation(AdaptiveRelationSet<RelationDataType>& relations, const BlockType* node)
+	{
+		relations.remove(const_cast<BlockType*>(node));
 	}
 
 	template<typename BlockType, typename GateType>
@@ -33,6 +33,16 @@ namespace ds::amt {
         BlockType& insertAfter(BlockType& block) override;
         BlockType& insertBefore(BlockType& block) override;
 
+        /**
+         * @brief Inserts a block whose data is the result of @p factory, constructed right in the block.
+         */
+        template<typename Factory>
+        BlockType& insertFirstFrom(const Factory& factory);
+        template<typename Factory>
+        BlockType& insertLastFrom(const Factory& factory);
+        template<typename Factory>
+        BlockType& insertFrom(size_t index, const Factory& factory);
+
         void removeFirst() override;
         void removeLast() override;
         void remove(size_t index) override;
@@ -40,6 +50,14 @@ namespace ds::amt {
         void removePrevious(const BlockType& block) override;
 
     protected:
+        /**
+         * @brief Connects an allocated block to the sequence.
+         */
+        BlockType& linkFirst(BlockType* newBlock);
+        BlockType& linkLast(BlockType* newBlock);
+        BlockType& linkAfter(BlockType& block, BlockType* newBlock);
+        BlockType& linkBefore(BlockType& block, BlockType* newBlock);
+
         virtual void connectBlocks(BlockType* previous, BlockType* next);
         virtual void disconnectBlock(BlockType* block);
 
@@ -81,6 +99,8 @@ namespace ds::amt {
     {
 
         SinglyLinkedSequenceBlock() : next_(nullptr) {}
+        template<typename Factory>
+        SinglyLinkedSequenceBlock(FactoryTag tag, const Factory& factory) : MemoryBlock<DataType>(tag, factory), next_(nullptr) {}
         ~SinglyLinkedSequenceBlock() { next_ = nullptr; }
 
         SinglyLinkedSequenceBlock<DataType>* next_;
@@ -116,6 +136,8 @@ namespace ds::amt {
     {
 
         DoublyLinkedSequenceBlock() : previous_(nullptr) {}
+        template<typename Factory>
+        DoublyLinkedSequenceBlock(FactoryTag tag, const Factory& factory) : SLSBlock<DataType>(tag, factory), previous_(nullptr) {}
         ~DoublyLinkedSequenceBlock() { previous_ = nullptr; }
 
         DoublyLinkedSequenceBlock<DataType>* previous_;
@@ -304,46 +326,100 @@ namespace ds::amt {
     template<typename BlockType>
     BlockType& ExplicitSequence<BlockType>::insertFirst()
     {
-        if (this->size() == 0)
+        return this->linkFirst(AMS<BlockType>::memoryManager_->allocateMemory());
+    }
+
+    template<typename BlockType>
+    BlockType& ExplicitSequence<BlockType>::insertLast()
+    {
+        return this->linkLast(AMS<BlockType>::memoryManager_->allocateMemory());
+    }
+
+    template<typename BlockType>
+    BlockType& ExplicitSequence<BlockType>::insert(size_t index)
+    {
+        return index == 0
+               ? this->insertFirst()
+               : index == this->size()
+                 ? this->insertLast()
+                 : this->insertAfter(*this->access(index - 1));
+    }
+
+    template<typename BlockType>
+    BlockType& ExplicitSequence<BlockType>::insertAfter(BlockType& block)
+    {
+        return this->linkAfter(block, AMS<BlockType>::memoryManager_->allocateMemory());
+    }
+
+    template<typename BlockType>
+    BlockType& ExplicitSequence<BlockType>::insertBefore(BlockType& block)
+    {
+        return this->linkBefore(block, AMS<BlockType>::memoryManager_->allocateMemory());
+    }
+
+    template<typename BlockType>
+    template<typename Factory>
+    BlockType& ExplicitSequence<BlockType>::insertFirstFrom(const Factory& factory)
+    {
+        return this->linkFirst(AMS<BlockType>::memoryManager_->emplaceMemory(FactoryTag(), factory));
+    }
+
+    template<typename BlockType>
+    template<typename Factory>
+    BlockType& ExplicitSequence<BlockType>::insertLastFrom(const Factory& factory)
+    {
+        return this->linkLast(AMS<BlockType>::memoryManager_->emplaceMemory(FactoryTag(), factory));
+    }
+
+    template<typename BlockType>
+    template<typename Factory>
+    BlockType& ExplicitSequence<BlockType>::insertFrom(size_t index, const Factory& factory)
+    {
+        if (index == 0)
         {
-            first_ = last_ = AMS<BlockType>::memoryManager_->allocateMemory();
-            return *first_;
+            return this->insertFirstFrom(factory);
         }
-        else
+        if (index == this->size())
         {
-            return this->insertBefore(*first_);
+            return this->insertLastFrom(factory);
         }
+
+        BlockType& previous = *this->access(index - 1);
+        return this->linkAfter(previous, AMS<BlockType>::memoryManager_->emplaceMemory(FactoryTag(), factory));
     }
 
     template<typename BlockType>
-    BlockType& ExplicitSequence<BlockType>::insertLast()
+    BlockType& ExplicitSequence<BlockType>::linkFirst(BlockType* newBlock)
     {
-        if (this->size() == 0)
+        if (first_ == nullptr)
         {
-            first_ = last_ = AMS<BlockType>::memoryManager_->allocateMemory();
-            return *last_;
+            first_ = last_ = newBlock;
+            return *first_;
         }
         else
         {
-            return this->insertAfter(*last_);
+            return this->linkBefore(*first_, newBlock);
         }
     }
 
     template<typename BlockType>
-    BlockType& ExplicitSequence<BlockType>::insert(size_t index)
+    BlockType& ExplicitSequence<BlockType>::linkLast(BlockType* newBlock)
     {
-        return index == 0
-               ? this->insertFirst()
-               : index == this->size()
-                 ? this->insertLast()
-                 : this->insertAfter(*this->access(index - 1));
+        if (first_ == nullptr)
+        {
+            first_ = last_ = newBlock;
+            return *last_;
+        }
+        else
+        {
+            return this->linkAfter(*last_, newBlock);
+        }
     }
 
     template<typename BlockType>
-    BlockType& ExplicitSequence<BlockType>::insertAfter(BlockType& block)
+    BlockType& ExplicitSequence<BlockType>::linkAfter(BlockType& block, BlockType* newBlock)
     {
         BlockType* nextBlock = this->accessNext(block);
-        BlockType* newBlock = AMS<BlockType>::memoryManager_->allocateMemory();
 
         this->connectBlocks(&block, newBlock);
         this->connectBlocks(newBlock, nextBlock);
@@ -356,10 +432,9 @@ namespace ds::amt {
     }
 
     template<typename BlockType>
-    BlockType& ExplicitSequence<BlockType>::insertBefore(BlockType& block)
+    BlockType& ExplicitSequence<BlockType>::linkBefore(BlockType& block, BlockType* newBlock)
     {
         BlockType* prevBlock = this->accessPrevious(block);
-        BlockType* newBlock = AMS<BlockType>::memoryManager_->allocateMemory();
 
         this->connectBlocks(prevBlock, newBlock);
         this->connectBlocks(newBlock, &block);
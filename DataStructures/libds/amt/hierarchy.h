@@ -2,10 +2,16 @@
 
 #include <libds/amt/abstract_memory_type.h>
 #include <libds/amt/explicit_sequence.h>
+#include <algorithm>
 #include <functional>
+#include <utility>
+#include <vector>
 
 namespace ds::amt {
 
+    template<typename BlockType>
+    class LevelOrderTraversal;
+
     template<typename BlockType>
     class Hierarchy :
             virtual public AMT
@@ -36,57 +42,45 @@ namespace ds::amt {
         void processPostOrder(BlockType* node, std::function<void(BlockType*)> operation) const;
         void processLevelOrder(BlockType* node, std::function<void(BlockType*)> operation) const;
 
+        /**
+         * @brief Level-order traversal calling visitor(BlockType*) directly, see LevelOrderTraversal.
+         */
+        template<typename Visitor>
+        void processLevelOrder(BlockType* node, Visitor visitor) const;
+
     protected:
         using DataType = typename BlockType::DataT;
 
+        /**
+         * @brief Base of depth-first iterators.
+         *
+         * The path from the starting node to the current node is kept as a stack of positions. The first
+         * INLINE_DEPTH positions are stored inside the iterator, so traversals of hierarchies that are not deeper
+         * than that allocate no memory and a copy of an iterator copies just the positions on the path.
+         */
         class DepthFirstIterator
         {
         protected:
             struct DepthFirstIteratorPosition
             {
-                DepthFirstIteratorPosition(BlockType* currentNode, DepthFirstIteratorPosition* previousPosition) :
-                        currentNode_(currentNode),
-                        currentSon_(nullptr),
-                        currentSonOrder_(INVALID_INDEX),
-                        visitedSonCount_(0),
-                        currentNodeProcessed_(false),
-                        previousPosition_(previousPosition)
-                {}
-
-                DepthFirstIteratorPosition(const DepthFirstIteratorPosition& other) :
-                        currentNode_(other.currentNode_),
-                        currentSon_(other.currentSon_),
-                        currentSonOrder_(other.currentSonOrder_),
-                        visitedSonCount_(other.visitedSonCount_),
-                        currentNodeProcessed_(other.currentNodeProcessed_),
-                        previousPosition_(other.previousPosition_)
-                {}
-
-                ~DepthFirstIteratorPosition() {
-                    currentNode_ = nullptr;
-                    currentSon_ = nullptr;
-                    currentSonOrder_ = 0;
-                    visitedSonCount_ = 0;
-                    currentNodeProcessed_ = false;
-                    previousPosition_ = nullptr;
-                }
-
                 BlockType* currentNode_;
                 BlockType* currentSon_;
                 size_t currentSonOrder_;
                 size_t visitedSonCount_;
                 bool currentNodeProcessed_;
-                DepthFirstIteratorPosition* previousPosition_;
             };
 
         public:
             DepthFirstIterator(Hierarchy<BlockType>* hierarchy);
             DepthFirstIterator(const DepthFirstIterator& other);
             ~DepthFirstIterator();
+            DepthFirstIterator& operator=(const DepthFirstIterator& other);
             bool operator==(const DepthFirstIterator& other) const;
             bool operator!=(const DepthFirstIterator& other) const;
             DataType& operator*();
 
+            static const size_t INLINE_DEPTH = 16;
+
         protected:
             void savePosition(BlockType* currentNode);
             void removePosition();
@@ -94,6 +88,14 @@ namespace ds::amt {
 
             Hierarchy<BlockType>* hierarchy_;
             DepthFirstIteratorPosition* currentPosition_;
+
+        private:
+            void copyPositions(const DepthFirstIterator& other);
+
+            DepthFirstIteratorPosition* positions_;
+            size_t depth_;
+            size_t capacity_;
+            DepthFirstIteratorPosition inlinePositions_[INLINE_DEPTH];
         };
 
     public:
@@ -103,6 +105,7 @@ namespace ds::amt {
         public:
             PreOrderHierarchyIterator(Hierarchy<BlockType>* hierarchy, BlockType* node);
             PreOrderHierarchyIterator(const PreOrderHierarchyIterator& other);
+            PreOrderHierarchyIterator& operator=(const PreOrderHierarchyIterator& other);
             PreOrderHierarchyIterator& operator++();
         };
 
@@ -114,6 +117,8 @@ namespace ds::amt {
         public:
             PostOrderHierarchyIterator(Hierarchy<BlockType>* hierarchy, BlockType* node);
             PostOrderHierarchyIterator(const PreOrderHierarchyIterator& other);
+            PostOrderHierarchyIterator(const PostOrderHierarchyIterator& other);
+            PostOrderHierarchyIterator& operator=(const PostOrderHierarchyIterator& other);
             PostOrderHierarchyIterator& operator++();
         };
 
@@ -174,6 +179,7 @@ namespace ds::amt {
         public:
             InOrderHierarchyIterator(BinaryHierarchy<BlockType>* hierarchy, BlockType* node);
             InOrderHierarchyIterator(const InOrderHierarchyIterator& other);
+            InOrderHierarchyIterator& operator=(const InOrderHierarchyIterator& other);
             InOrderHierarchyIterator& operator++();
 
         protected:
@@ -187,6 +193,35 @@ namespace ds::amt {
         InOrderHierarchyIterator end();
     };
 
+    //----------
+
+    /**
+     * @brief Level-order traversal of a hierarchy that keeps its frontiers in reusable contiguous buffers.
+     *
+     * Nodes of one level are visited from the current frontier while their sons are appended to the next
+     * one, then both buffers are swapped. The buffers keep their capacity, so repeated traversals by the same
+     * object allocate nothing once the widest level has been seen. The visitor is a template parameter
+     * called as visitor(BlockType*) without an std::function wrapper.
+     */
+    template<typename BlockType>
+    class LevelOrderTraversal
+    {
+    public:
+        explicit LevelOrderTraversal(const Hierarchy<BlockType>& hierarchy);
+
+        template<typename Visitor>
+        void process(BlockType* node, Visitor&& visitor);
+
+    private:
+        void appendSons(const BlockType& node, std::vector<BlockType*>& sons) const;
+
+    private:
+        const Hierarchy<BlockType>* hierarchy_;
+        std::vector<BlockType*> frontier_;
+        std::vector<BlockType*> nextFrontier_;
+    };
+
+
     //----------
 
     template<typename BlockType>
@@ -298,31 +333,56 @@ namespace ds::amt {
     template<typename BlockType>
     void Hierarchy<BlockType>::processLevelOrder(BlockType* node, std::function<void(BlockType*)> operation) const
     {
+        LevelOrderTraversal<BlockType>(*this).process(node, operation);
+    }
+
+    template<typename BlockType>
+    template<typename Visitor>
+    void Hierarchy<BlockType>::processLevelOrder(BlockType* node, Visitor visitor) const
+    {
+        LevelOrderTraversal<BlockType>(*this).process(node, visitor);
+    }
+
+    template<typename BlockType>
+    LevelOrderTraversal<BlockType>::LevelOrderTraversal(const Hierarchy<BlockType>& hierarchy) :
+        hierarchy_(&hierarchy)
+    {
+    }
+
+    template<typename BlockType>
+    template<typename Visitor>
+    void LevelOrderTraversal<BlockType>::process(BlockType* node, Visitor&& visitor)
+    {
+        frontier_.clear();
         if (node != nullptr)
         {
-            SinglyLS<BlockType*> sequence;
-            sequence.insertFirst().data_ = node;
-            while (!sequence.isEmpty())
+            frontier_.push_back(node);
+        }
+
+        while (!frontier_.empty())
+        {
+            nextFrontier_.clear();
+            for (BlockType* current : frontier_)
             {
-                BlockType* current = sequence.accessFirst()->data_;
-                sequence.removeFirst();
-                if (current != nullptr)
-                {
-                    operation(current);
-                    size_t nodeDegree = this->degree(*current);
-                    size_t n = 0;
-                    size_t sonsProcessed = 0;
-                    while (sonsProcessed < nodeDegree)
-                    {
-                        BlockType* son = this->accessSon(*current, n);
-                        if (son != nullptr)
-                        {
-                            sequence.insertLast().data_ = son;
-                            ++sonsProcessed;
-                        }
-                        ++n;
-                    }
-                }
+                visitor(current);
+                this->appendSons(*current, nextFrontier_);
+            }
+            std::swap(frontier_, nextFrontier_);
+        }
+    }
+
+    template<typename BlockType>
+    void LevelOrderTraversal<BlockType>::appendSons(const BlockType& node, std::vector<BlockType*>& sons) const
+    {
+        const size_t nodeDegree = hierarchy_->degree(node);
+        size_t sonsProcessed = 0;
+        for (size_t n = 0; sonsProcessed < nodeDegree; ++n)
+        {
+            BlockType* son = hierarchy_->accessSon(node, n);
+            if (son != nullptr)
+            {
+                sons.push_back(son);
+                ++sonsProcessed;
             }
         }
     }
@@ -341,7 +401,10 @@ namespace ds::amt {
     template<typename BlockType>
     Hierarchy<BlockType>::DepthFirstIterator::DepthFirstIterator(Hierarchy<BlockType>* hierarchy) :
             hierarchy_(hierarchy),
-            currentPosition_(nullptr)
+            currentPosition_(nullptr),
+            positions_(inlinePositions_),
+            depth_(0),
+            capacity_(INLINE_DEPTH)
     {
     }
 
@@ -349,41 +412,32 @@ namespace ds::amt {
     Hierarchy<BlockType>::DepthFirstIterator::DepthFirstIterator(const DepthFirstIterator& other):
             DepthFirstIterator(other.hierarchy_)
     {
-        DepthFirstIteratorPosition* myPosition = nullptr;
-        for (DepthFirstIteratorPosition* otherPosition = other.currentPosition_;
-             otherPosition != nullptr;
-             otherPosition = otherPosition->previousPosition_)
-        {
-            if (currentPosition_ == nullptr)
-            {
-                currentPosition_ = new DepthFirstIteratorPosition(*otherPosition);
-                myPosition = currentPosition_;
-            }
-            else
-            {
-                if (myPosition != nullptr)
-                {
-                    myPosition->previousPosition_ = new DepthFirstIteratorPosition(*otherPosition);
-                    myPosition = myPosition->previousPosition_;
-                }
-                else
-                {
-                    throw std::logic_error("Invalid DFS copy init");
-                }
-            }
-        }
+        this->copyPositions(other);
     }
 
     template<typename BlockType>
     Hierarchy<BlockType>::DepthFirstIterator::~DepthFirstIterator()
     {
-        while (currentPosition_ != nullptr)
+        if (positions_ != inlinePositions_)
         {
-            this->removePosition();
+            delete[] positions_;
         }
 
         hierarchy_ = nullptr;
         currentPosition_ = nullptr;
+        positions_ = nullptr;
+        depth_ = 0;
+    }
+
+    template<typename BlockType>
+    auto Hierarchy<BlockType>::DepthFirstIterator::operator=(const DepthFirstIterator& other) -> DepthFirstIterator&
+    {
+        if (this != &other)
+        {
+            hierarchy_ = other.hierarchy_;
+            this->copyPositions(other);
+        }
+        return *this;
     }
 
     template<typename BlockType>
@@ -399,10 +453,7 @@ namespace ds::amt {
 
         if (myPosition != nullptr && otherPosition != nullptr)
         {
-            if (myPosition->currentNode_ != otherPosition->currentNode_ || myPosition->currentSonOrder_ != otherPosition->currentSonOrder_)
-            {
-                return false;
-            }
+            return myPosition->currentNode_ == otherPosition->currentNode_ && myPosition->currentSonOrder_ == otherPosition->currentSonOrder_;
         }
 
         return myPosition == nullptr && otherPosition == nullptr;
@@ -424,15 +475,45 @@ namespace ds::amt {
     template<typename BlockType>
     void Hierarchy<BlockType>::DepthFirstIterator::savePosition(BlockType* currentNode)
     {
-        currentPosition_ = new DepthFirstIteratorPosition(currentNode, currentPosition_);
+        if (depth_ == capacity_)
+        {
+            DepthFirstIteratorPosition* positions = new DepthFirstIteratorPosition[2 * capacity_];
+            std::copy(positions_, positions_ + depth_, positions);
+            if (positions_ != inlinePositions_)
+            {
+                delete[] positions_;
+            }
+            positions_ = positions;
+            capacity_ *= 2;
+        }
+
+        currentPosition_ = positions_ + depth_++;
+        *currentPosition_ = { currentNode, nullptr, INVALID_INDEX, 0, false };
     }
 
     template<typename BlockType>
     void Hierarchy<BlockType>::DepthFirstIterator::removePosition()
     {
-        DepthFirstIteratorPosition* positionToRemove = currentPosition_;
-        currentPosition_ = currentPosition_->previousPosition_;
-        delete positionToRemove;
+        --depth_;
+        currentPosition_ = depth_ > 0 ? positions_ + depth_ - 1 : nullptr;
+    }
+
+    template<typename BlockType>
+    void Hierarchy<BlockType>::DepthFirstIterator::copyPositions(const DepthFirstIterator& other)
+    {
+        if (other.depth_ > capacity_)
+        {
+            if (positions_ != inlinePositions_)
+            {
+                delete[] positions_;
+            }
+            positions_ = new DepthFirstIteratorPosition[other.capacity_];
+            capacity_ = other.capacity_;
+        }
+
+        std::copy(other.positions_, other.positions_ + other.depth_, positions_);
+        depth_ = other.depth_;
+        currentPosition_ = depth_ > 0 ? positions_ + depth_ - 1 : nullptr;
     }
 
     template<typename BlockType>
@@ -474,6 +555,13 @@ namespace ds::amt {
     {
     }
 
+    template<typename BlockType>
+    typename Hierarchy<BlockType>::PreOrderHierarchyIterator& Hierarchy<BlockType>::PreOrderHierarchyIterator::operator=(const PreOrderHierarchyIterator& other)
+    {
+        Hierarchy<BlockType>::DepthFirstIterator::operator=(other);
+        return *this;
+    }
+
     template<typename BlockType>
     typename Hierarchy<BlockType>::PreOrderHierarchyIterator& Hierarchy<BlockType>::PreOrderHierarchyIterator::operator++()
     {
@@ -510,6 +598,19 @@ namespace ds::amt {
     {
     }
 
+    template<typename BlockType>
+    Hierarchy<BlockType>::PostOrderHierarchyIterator::PostOrderHierarchyIterator(const PostOrderHierarchyIterator& other) :
+            Hierarchy<BlockType>::DepthFirstIterator::DepthFirstIterator(other)
+    {
+    }
+
+    template<typename BlockType>
+    typename Hierarchy<BlockType>::PostOrderHierarchyIterator& Hierarchy<BlockType>::PostOrderHierarchyIterator::operator=(const PostOrderHierarchyIterator& other)
+    {
+        Hierarchy<BlockType>::DepthFirstIterator::operator=(other);
+        return *this;
+    }
+
     template<typename BlockType>
     typename Hierarchy<BlockType>::PostOrderHierarchyIterator& Hierarchy<BlockType>::PostOrderHierarchyIterator::operator++()
     {
@@ -658,6 +759,13 @@ namespace ds::amt {
     {
     }
 
+    template<typename BlockType>
+    typename BinaryHierarchy<BlockType>::InOrderHierarchyIterator& BinaryHierarchy<BlockType>::InOrderHierarchyIterator::operator=(const InOrderHierarchyIterator& other)
+    {
+        Hierarchy<BlockType>::DepthFirstIterator::operator=(other);
+        return *this;
+    }
+
     template<typename BlockType>
     typename BinaryHierarchy<BlockType>::InOrderHierarchyIterator& BinaryHierarchy<BlockType>::InOrderHierarchyIterator::operator++()
     {
@@ -2,11 +2,223 @@
 
 #include <libds/amt/abstract_memory_type.h>
 #include <libds/amt/hierarchy.h>
+#include <libds/prefetch.h>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace ds::amt {
 
-    template<typename DataType, size_t K>
+    /**
+     * @brief Arithmetic shared by layouts of implicit hierarchies.
+     */
+    struct ImplicitHierarchyLayout
+    {
+        static constexpr size_t power(size_t base, size_t exponent)
+        {
+            size_t result = 1;
+            while (exponent-- > 0)
+            {
+                result *= base;
+            }
+            return result;
+        }
+
+        /**
+         * @return Node count of a complete K-way hierarchy with height levels.
+         */
+        template<size_t K>
+        static constexpr size_t completeSize(size_t height)
+        {
+            return (POWERS<K>.values_[height] - 1) / (K - 1);
+        }
+
+        template<size_t K>
+        struct PowerTable
+        {
+            constexpr PowerTable() :
+                values_()
+            {
+                size_t value = 1;
+                for (size_t& entry : values_)
+                {
+                    entry = value;
+                    value *= K;
+                }
+            }
+
+            size_t values_[64];
+        };
+
+        // Powers of K, index mapping of layouts looks them up on every access.
+        template<size_t K>
+        static constexpr PowerTable<K> POWERS = PowerTable<K>();
+    };
+
+    /**
+     * @brief Nodes are stored in breadth-first order, the node with index i has sons K * i + 1 ... K * i + K.
+     * @details Layout policies map the breadth-first (logical) index of a node to the position of its block in
+     *          the memory manager (physical index). IS_IDENTITY layouts store exactly size() blocks without gaps,
+     *          other layouts store a complete hierarchy of the given height and leave unused positions default.
+     */
+    struct BreadthFirstLayout : public ImplicitHierarchyLayout
+    {
+        static constexpr bool IS_IDENTITY = true;
+
+        template<size_t K>
+        static size_t physicalIndex(size_t index, size_t)
+        {
+            return index;
+        }
+
+        template<size_t K>
+        static size_t logicalIndex(size_t physicalIndex, size_t)
+        {
+            return physicalIndex;
+        }
+
+        /**
+         * @brief Called with the index of a node a descent has just moved to. Plain breadth-first order requests
+         *        nothing, prefetching layouts (EytzingerLayout, VanEmdeBoasLayout) override it.
+         */
+        template<size_t K, typename BlockType>
+        static void prefetchDescendants(const BlockType*, size_t, size_t, size_t)
+        {
+        }
+    };
+
+    /**
+     * @brief Breadth-first order (Eytzinger layout) that prefetches descendants during descents.
+     * @details Descendants of a node on one level are contiguous, so when a descent reaches a node, all of its
+     *          descendants PREFETCH_DEPTH levels below (they fit into one cache line for small blocks) are requested
+     *          at once. Their loads overlap with the comparisons on the levels in between, so a search waits for
+     *          memory roughly once per PREFETCH_DEPTH levels instead of on every level.
+     */
+    struct EytzingerLayout : public BreadthFirstLayout
+    {
+        template<size_t K, typename BlockType>
+        static constexpr size_t prefetchDepth()
+        {
+            size_t depth = 1;
+            while (power(K, depth + 1) * sizeof(BlockType) <= CACHE_LINE_SIZE)
+            {
+                ++depth;
+            }
+            return depth;
+        }
+
+        template<size_t K, typename BlockType>
+        static void prefetchDescendants(const BlockType* blocks, size_t index, size_t size, size_t)
+        {
+            constexpr size_t width = power(K, prefetchDepth<K, BlockType>());
+            const size_t first = width * index + (width - 1) / (K - 1);
+            if (first < size)
+            {
+                prefetchRange(blocks + first, (std::min)(width, size - first) * sizeof(BlockType));
+            }
+        }
+    };
+
+    /**
+     * @brief Blocked van Emde Boas layout: a hierarchy of height h is split into a top hierarchy of height h / 2
+     *        and bottom hierarchies under its leaves, each stored contiguously one after another, recursively.
+     * @details Any root-to-leaf path of length h crosses O(h / log B) blocks of B nodes regardless of B, so descents
+     *          touch fewer cache lines and pages than in breadth-first order without knowing the cache size.
+     *          Index mapping costs O(log h) per access. The whole complete hierarchy is stored, so insertLastLeaf
+     *          rebuilds the hierarchy with one more level when it is full.
+     */
+    struct VanEmdeBoasLayout : public ImplicitHierarchyLayout
+    {
+        static constexpr bool IS_IDENTITY = false;
+
+        template<size_t K>
+        static size_t physicalIndex(size_t index, size_t height)
+        {
+            size_t depth = 0;
+            size_t levelStart = 0;
+            size_t levelWidth = 1;
+            while (index >= levelStart + levelWidth)
+            {
+                levelStart += levelWidth;
+                levelWidth *= K;
+                ++depth;
+            }
+
+            size_t position = index - levelStart;
+            size_t result = 0;
+            while (height > 1)
+            {
+                const size_t topHeight = height / 2;
+                if (depth < topHeight)
+                {
+                    height = topHeight;
+                }
+                else
+                {
+                    const size_t bottomHeight = height - topHeight;
+                    depth -= topHeight;
+                    const size_t bottomWidth = POWERS<K>.values_[depth];
+                    result += completeSize<K>(topHeight) + position / bottomWidth * completeSize<K>(bottomHeight);
+                    position %= bottomWidth;
+                    height = bottomHeight;
+                }
+            }
+            return result;
+        }
+
+        template<size_t K>
+        static size_t logicalIndex(size_t physicalIndex, size_t height)
+        {
+            // Depth and position within its level of the root of the currently searched sub-hierarchy.
+            size_t depth = 0;
+            size_t position = 0;
+            while (height > 1)
+            {
+                const size_t topHeight = height / 2;
+                const size_t topSize = completeSize<K>(topHeight);
+                if (physicalIndex < topSize)
+                {
+                    height = topHeight;
+                }
+                else
+                {
+                    const size_t bottomHeight = height - topHeight;
+                    const size_t bottomSize = completeSize<K>(bottomHeight);
+                    physicalIndex -= topSize;
+                    depth += topHeight;
+                    position = position * POWERS<K>.values_[topHeight] + physicalIndex / bottomSize;
+                    physicalIndex %= bottomSize;
+                    height = bottomHeight;
+                }
+            }
+            return completeSize<K>(depth) + position;
+        }
+
+        /**
+         * @brief Sons of a node may lie in different bottom hierarchies, so their blocks are requested one by one.
+         */
+        template<size_t K, typename BlockType>
+        static void prefetchDescendants(const BlockType* blocks, size_t index, size_t size, size_t height)
+        {
+            const size_t first = K * index + 1;
+            const size_t last = (std::min)(first + K, size);
+            for (size_t son = first; son < last; ++son)
+            {
+                prefetch(blocks + physicalIndex<K>(son, height));
+            }
+        }
+    };
+
+    //----------
+
+    /**
+     * @brief K-way hierarchy stored in an array without pointers. Nodes are addressed by their breadth-first index,
+     *        Layout decides where the block of a node lies in memory (see BreadthFirstLayout).
+     */
+    template<typename DataType, size_t K, typename Layout = BreadthFirstLayout>
     class ImplicitHierarchy :
             virtual public KWayHierarchy<MemoryBlock<DataType>, K>,
             public ImplicitAMS<DataType>
@@ -15,6 +227,12 @@ namespace ds::amt {
         ImplicitHierarchy();
         ~ImplicitHierarchy() override;
 
+        AMT& assign(const AMT& other) override;
+        void clear() override;
+        size_t size() const override;
+        bool isEmpty() const override;
+        bool equals(const AMT& other) override;
+
         size_t level(const MemoryBlock<DataType>& node) const override;
         size_t level(size_t index) const;
         size_t degree(const MemoryBlock<DataType>& node) const override;
@@ -42,55 +260,140 @@ namespace ds::amt {
         size_t indexOfParent(size_t index) const;
         size_t indexOfSon(const MemoryBlock<DataType>& node, size_t sonOrder) const;
         size_t indexOfSon(size_t indexOfParent, size_t sonOrder) const;
+
+    private:
+        size_t indexOf(const MemoryBlock<DataType>& node) const;
+        MemoryBlock<DataType>* accessBlock(size_t index) const;
+        void rebuild(size_t height);
+
+    private:
+        // Used only by layouts that are not IS_IDENTITY; the memory manager then holds the complete hierarchy.
+        size_t size_;
+        size_t height_;
     };
 
-    template<typename DataType, size_t K>
-    using IH = ImplicitHierarchy<DataType, K>;
+    template<typename DataType, size_t K, typename Layout = BreadthFirstLayout>
+    using IH = ImplicitHierarchy<DataType, K, Layout>;
 
     //----------
 
-    template<typename DataType>
+    template<typename DataType, typename Layout = BreadthFirstLayout>
     class BinaryImplicitHierarchy :
             public BinaryHierarchy<MemoryBlock<DataType>>,
-            public ImplicitHierarchy<DataType, 2>
+            public ImplicitHierarchy<DataType, 2, Layout>
     {
     };
 
-    template<typename DataType>
-    using BinaryIH = BinaryImplicitHierarchy<DataType>;
+    template<typename DataType, typename Layout = BreadthFirstLayout>
+    using BinaryIH = BinaryImplicitHierarchy<DataType, Layout>;
 
     //----------
 
-    template<typename DataType, size_t K>
-    ImplicitHierarchy<DataType, K>::ImplicitHierarchy()
+    template<typename DataType, size_t K, typename Layout>
+    ImplicitHierarchy<DataType, K, Layout>::ImplicitHierarchy() :
+        size_(0),
+        height_(0)
     {
     }
 
-    template<typename DataType, size_t K>
-    ImplicitHierarchy<DataType, K>::~ImplicitHierarchy()
+    template<typename DataType, size_t K, typename Layout>
+    ImplicitHierarchy<DataType, K, Layout>::~ImplicitHierarchy()
     {
     }
 
-    template<typename DataType, size_t K>
-    size_t ImplicitHierarchy<DataType, K>::level(const MemoryBlock<DataType>& node) const
+    template<typename DataType, size_t K, typename Layout>
+    AMT& ImplicitHierarchy<DataType, K, Layout>::assign(const AMT& other)
     {
-        return this->level(this->getMemoryManager()->calculateIndex(node));
+        if (this != &other)
+        {
+            const ImplicitHierarchy<DataType, K, Layout>& otherHierarchy = dynamic_cast<const ImplicitHierarchy<DataType, K, Layout>&>(other);
+            ImplicitAMS<DataType>::assign(otherHierarchy);
+            size_ = otherHierarchy.size_;
+            height_ = otherHierarchy.height_;
+        }
+
+        return *this;
     }
 
-    template<typename DataType, size_t K>
-    size_t ImplicitHierarchy<DataType, K>::level(size_t index) const
+    template<typename DataType, size_t K, typename Layout>
+    void ImplicitHierarchy<DataType, K, Layout>::clear()
+    {
+        ImplicitAMS<DataType>::clear();
+        size_ = 0;
+        height_ = 0;
+    }
+
+    template<typename DataType, size_t K, typename Layout>
+    size_t ImplicitHierarchy<DataType, K, Layout>::size() const
+    {
+        if constexpr (Layout::IS_IDENTITY)
+        {
+            return ImplicitAMS<DataType>::size();
+        }
+        else
+        {
+            return size_;
+        }
+    }
+
+    template<typename DataType, size_t K, typename Layout>
+    bool ImplicitHierarchy<DataType, K, Layout>::isEmpty() const
+    {
+        return this->size() == 0;
+    }
+
+    template<typename DataType, size_t K, typename Layout>
+    bool ImplicitHierarchy<DataType, K, Layout>::equals(const AMT& other)
+    {
+        if constexpr (Layout::IS_IDENTITY)
+        {
+            return ImplicitAMS<DataType>::equals(other);
+        }
+        else
+        {
+            if (this == &other)
+            {
+                return true;
+            }
+
+            const ImplicitHierarchy<DataType, K, Layout>* otherHierarchy = dynamic_cast<const ImplicitHierarchy<DataType, K, Layout>*>(&other);
+            if (otherHierarchy == nullptr || size_ != otherHierarchy->size_)
+            {
+                return false;
+            }
+
+            // Both hierarchies may have a different height, so blocks are compared in logical order.
+            for (size_t i = 0; i < size_; ++i)
+            {
+                if (std::memcmp(this->accessBlock(i), otherHierarchy->accessBlock(i), sizeof(MemoryBlock<DataType>)) != 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    template<typename DataType, size_t K, typename Layout>
+    size_t ImplicitHierarchy<DataType, K, Layout>::level(const MemoryBlock<DataType>& node) const
+    {
+        return this->level(this->indexOf(node));
+    }
+
+    template<typename DataType, size_t K, typename Layout>
+    size_t ImplicitHierarchy<DataType, K, Layout>::level(size_t index) const
     {
         return static_cast<size_t>(std::floor(std::log((K - 1) * (index + 1)) / std::log(K)));
     }
 
-    template<typename DataType, size_t K>
-    size_t ImplicitHierarchy<DataType, K>::degree(const MemoryBlock<DataType>& node) const
+    template<typename DataType, size_t K, typename Layout>
+    size_t ImplicitHierarchy<DataType, K, Layout>::degree(const MemoryBlock<DataType>& node) const
     {
-        return this->degree(this->getMemoryManager()->calculateIndex(node));
+        return this->degree(this->indexOf(node));
     }
 
-    template<typename DataType, size_t K>
-    size_t ImplicitHierarchy<DataType, K>::degree(size_t index) const
+    template<typename DataType, size_t K, typename Layout>
+    size_t ImplicitHierarchy<DataType, K, Layout>::degree(size_t index) const
     {
         const size_t currentLevel = this->level(index);
         const size_t indexOfLast = this->size() - 1;
@@ -122,113 +425,181 @@ namespace ds::amt {
         }
     }
 
-    template<typename DataType, size_t K>
-    size_t ImplicitHierarchy<DataType, K>::nodeCount(const MemoryBlock<DataType>& node) const
+    template<typename DataType, size_t K, typename Layout>
+    size_t ImplicitHierarchy<DataType, K, Layout>::nodeCount(const MemoryBlock<DataType>& node) const
     {
-        return this->getMemoryManager()->calculateIndex(node) == 0
+        return this->indexOf(node) == 0
                ? this->size()
                : Hierarchy<MemoryBlock<DataType>>::nodeCount(node);
     }
 
-    template<typename DataType, size_t K>
-    MemoryBlock<DataType>* ImplicitHierarchy<DataType, K>::accessRoot() const
+    template<typename DataType, size_t K, typename Layout>
+    MemoryBlock<DataType>* ImplicitHierarchy<DataType, K, Layout>::accessRoot() const
     {
         return this->size() > 0
-               ? &this->getMemoryManager()->getBlockAt(0)
+               ? this->accessBlock(0)
                : nullptr;
     }
 
-    template<typename DataType, size_t K>
-    MemoryBlock<DataType>* ImplicitHierarchy<DataType, K>::accessParent(const MemoryBlock<DataType>& node) const
+    template<typename DataType, size_t K, typename Layout>
+    MemoryBlock<DataType>* ImplicitHierarchy<DataType, K, Layout>::accessParent(const MemoryBlock<DataType>& node) const
     {
         const size_t index = this->indexOfParent(node);
         return INVALID_INDEX != index
-               ? &this->getMemoryManager()->getBlockAt(index)
+               ? this->accessBlock(index)
                : nullptr;
     }
 
-    template<typename DataType, size_t K>
-    MemoryBlock<DataType>* ImplicitHierarchy<DataType, K>::accessSon(const MemoryBlock<DataType>& node, size_t sonOrder) const
+    template<typename DataType, size_t K, typename Layout>
+    MemoryBlock<DataType>* ImplicitHierarchy<DataType, K, Layout>::accessSon(const MemoryBlock<DataType>& node, size_t sonOrder) const
     {
         const size_t index = this->indexOfSon(node, sonOrder);
-        return index < this->size()
-               ? &this->getMemoryManager()->getBlockAt(index)
-               : nullptr;
+        const size_t size = this->size();
+        if (index >= size)
+        {
+            return nullptr;
+        }
+
+        Layout::template prefetchDescendants<K>(&this->getMemoryManager()->getBlockAt(0), index, size, height_);
+        return this->accessBlock(index);
     }
 
-    template<typename DataType, size_t K>
-    MemoryBlock<DataType>* ImplicitHierarchy<DataType, K>::accessLastLeaf() const
+    template<typename DataType, size_t K, typename Layout>
+    MemoryBlock<DataType>* ImplicitHierarchy<DataType, K, Layout>::accessLastLeaf() const
     {
         const size_t size = this->size();
         return size != 0
-               ? &this->getMemoryManager()->getBlockAt(size - 1)
+               ? this->accessBlock(size - 1)
                : nullptr;
     }
 
-    template<typename DataType, size_t K>
-    MemoryBlock<DataType>& ImplicitHierarchy<DataType, K>::emplaceRoot()
+    template<typename DataType, size_t K, typename Layout>
+    MemoryBlock<DataType>& ImplicitHierarchy<DataType, K, Layout>::emplaceRoot()
     {
         throw unavailable_function_call("Method emplace_root() unavailable in implicit hierarchies!");
     }
 
-    template<typename DataType, size_t K>
-    void ImplicitHierarchy<DataType, K>::changeRoot(MemoryBlock<DataType>* newRoot)
+    template<typename DataType, size_t K, typename Layout>
+    void ImplicitHierarchy<DataType, K, Layout>::changeRoot(MemoryBlock<DataType>* newRoot)
     {
         throw unavailable_function_call("Method changeRoot() unavailable in implicit hierarchies!");
     }
 
-    template<typename DataType, size_t K>
-    MemoryBlock<DataType>& ImplicitHierarchy<DataType, K>::emplaceSon(MemoryBlock<DataType>& parent, size_t sonOrder)
+    template<typename DataType, size_t K, typename Layout>
+    MemoryBlock<DataType>& ImplicitHierarchy<DataType, K, Layout>::emplaceSon(MemoryBlock<DataType>& parent, size_t sonOrder)
     {
         throw unavailable_function_call("Method emplaceSon() unavailable in implicit hierarchies!");
     }
 
-    template<typename DataType, size_t K>
-    void ImplicitHierarchy<DataType, K>::changeSon(MemoryBlock<DataType>& parent, size_t sonOrder, MemoryBlock<DataType>* newSon)
+    template<typename DataType, size_t K, typename Layout>
+    void ImplicitHierarchy<DataType, K, Layout>::changeSon(MemoryBlock<DataType>& parent, size_t sonOrder, MemoryBlock<DataType>* newSon)
     {
         throw unavailable_function_call("Method changeSon() unavailable in implicit hierarchies!");
     }
 
-    template<typename DataType, size_t K>
-    void ImplicitHierarchy<DataType, K>::removeSon(MemoryBlock<DataType>& parent, size_t sonOrder)
+    template<typename DataType, size_t K, typename Layout>
+    void ImplicitHierarchy<DataType, K, Layout>::removeSon(MemoryBlock<DataType>& parent, size_t sonOrder)
     {
         throw unavailable_function_call("Method removeSon() unavailable in implicit hierarchies!");
     }
 
-    template<typename DataType, size_t K>
-    MemoryBlock<DataType>& ImplicitHierarchy<DataType, K>::insertLastLeaf()
+    template<typename DataType, size_t K, typename Layout>
+    MemoryBlock<DataType>& ImplicitHierarchy<DataType, K, Layout>::insertLastLeaf()
     {
-        return *this->getMemoryManager()->allocateMemory();
+        if constexpr (Layout::IS_IDENTITY)
+        {
+            return *this->getMemoryManager()->allocateMemory();
+        }
+        else
+        {
+            if (size_ == ImplicitHierarchyLayout::completeSize<K>(height_))
+            {
+                this->rebuild(height_ + 1);
+            }
+            return *this->accessBlock(size_++);
+        }
     }
 
-    template<typename DataType, size_t K>
-    void ImplicitHierarchy<DataType, K>::removeLastLeaf()
+    template<typename DataType, size_t K, typename Layout>
+    void ImplicitHierarchy<DataType, K, Layout>::removeLastLeaf()
     {
-        this->getMemoryManager()->releaseMemory();
+        if constexpr (Layout::IS_IDENTITY)
+        {
+            this->getMemoryManager()->releaseMemory();
+        }
+        else
+        {
+            if (size_ == 0)
+            {
+                throw std::out_of_range("Hierarchy is empty!");
+            }
+
+            MemoryBlock<DataType>* block = this->accessBlock(--size_);
+            destroy(block);
+            placement_new(block);
+        }
     }
 
-    template<typename DataType, size_t K>
-    size_t ImplicitHierarchy<DataType, K>::indexOfParent(const MemoryBlock<DataType>& node) const
+    template<typename DataType, size_t K, typename Layout>
+    size_t ImplicitHierarchy<DataType, K, Layout>::indexOfParent(const MemoryBlock<DataType>& node) const
     {
-        return this->indexOfParent(this->getMemoryManager()->calculateIndex(node));
+        return this->indexOfParent(this->indexOf(node));
     }
 
-    template<typename DataType, size_t K>
-    size_t ImplicitHierarchy<DataType, K>::indexOfParent(size_t index) const
+    template<typename DataType, size_t K, typename Layout>
+    size_t ImplicitHierarchy<DataType, K, Layout>::indexOfParent(size_t index) const
     {
         return 0 == index ? INVALID_INDEX : (index - 1) / K;
     }
 
-    template<typename DataType, size_t K>
-    size_t ImplicitHierarchy<DataType, K>::indexOfSon(const MemoryBlock<DataType>& node, size_t sonOrder) const
+    template<typename DataType, size_t K, typename Layout>
+    size_t ImplicitHierarchy<DataType, K, Layout>::indexOfSon(const MemoryBlock<DataType>& node, size_t sonOrder) const
     {
-        return this->indexOfSon(this->getMemoryManager()->calculateIndex(node), sonOrder);
+        return this->indexOfSon(this->indexOf(node), sonOrder);
     }
 
-    template<typename DataType, size_t K>
-    size_t ImplicitHierarchy<DataType, K>::indexOfSon(size_t indexOfParent, size_t sonOrder) const
+    template<typename DataType, size_t K, typename Layout>
+    size_t ImplicitHierarchy<DataType, K, Layout>::indexOfSon(size_t indexOfParent, size_t sonOrder) const
     {
         return K * indexOfParent + sonOrder + 1;
     }
 
+    template<typename DataType, size_t K, typename Layout>
+    size_t ImplicitHierarchy<DataType, K, Layout>::indexOf(const MemoryBlock<DataType>& node) const
+    {
+        return Layout::template logicalIndex<K>(this->getMemoryManager()->calculateIndex(node), height_);
+    }
+
+    template<typename DataType, size_t K, typename Layout>
+    MemoryBlock<DataType>* ImplicitHierarchy<DataType, K, Layout>::accessBlock(size_t index) const
+    {
+        return &this->getMemoryManager()->getBlockAt(Layout::template physicalIndex<K>(index, height_));
+    }
+
+    template<typename DataType, size_t K, typename Layout>
+    void ImplicitHierarchy<DataType, K, Layout>::rebuild(size_t height)
+    {
+        std::vector<DataType> data;
+        data.reserve(size_);
+        for (size_t i = 0; i < size_; ++i)
+        {
+            data.push_back(std::move(this->accessBlock(i)->data_));
+        }
+
+        const size_t blockCount = ImplicitHierarchyLayout::completeSize<K>(height);
+        typename ImplicitAMS<DataType>::MemoryManagerType* memoryManager = this->getMemoryManager();
+        memoryManager->clear();
+        memoryManager->changeCapacity(blockCount);
+        for (size_t i = 0; i < blockCount; ++i)
+        {
+            memoryManager->allocateMemory();
+        }
+
+        height_ = height;
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            this->accessBlock(i)->data_ = std::move(data[i]);
+        }
+    }
+
 }
\ No newline at end of file
@@ -33,6 +33,16 @@ namespace ds::amt {
         BlockType& insertAfter(BlockType& block) override;
         BlockType& insertBefore(BlockType& block) override;
 
+        /**
+         * @brief Inserts a block whose data is the result of @p factory, constructed right in the block.
+         */
+        template<typename Factory>
+        BlockType& insertFirstFrom(const Factory& factory);
+        template<typename Factory>
+        BlockType& insertLastFrom(const Factory& factory);
+        template<typename Factory>
+        BlockType& insertFrom(size_t index, const Factory& factory);
+
         void removeFirst() override;
         void removeLast() override;
         void remove(size_t index) override;
@@ -174,6 +184,27 @@ namespace ds::amt {
 
     }
 
+    template<typename DataType>
+    template<typename Factory>
+    typename ImplicitSequence<DataType>::BlockType& ImplicitSequence<DataType>::insertFirstFrom(const Factory& factory)
+    {
+        return this->insertFrom(0, factory);
+    }
+
+    template<typename DataType>
+    template<typename Factory>
+    typename ImplicitSequence<DataType>::BlockType& ImplicitSequence<DataType>::insertLastFrom(const Factory& factory)
+    {
+        return this->insertFrom(this->size(), factory);
+    }
+
+    template<typename DataType>
+    template<typename Factory>
+    typename ImplicitSequence<DataType>::BlockType& ImplicitSequence<DataType>::insertFrom(size_t index, const Factory& factory)
+    {
+        return *this->getMemoryManager()->emplaceMemoryAt(index, FactoryTag(), factory);
+    }
+
     template<typename DataType>
     void ImplicitSequence<DataType>::removeFirst()
     {
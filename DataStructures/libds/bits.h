@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace ds
+{
+    /**
+     * @return Number of set bits in word.
+     */
+    inline unsigned int popCount(uint64_t word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned int>(__builtin_popcountll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return static_cast<unsigned int>(__popcnt64(word));
+#else
+        unsigned int count = 0;
+        while (word != 0)
+        {
+            word &= word - 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+}
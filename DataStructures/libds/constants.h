@@ -6,4 +6,7 @@
 namespace ds
 {
     const size_t INVALID_INDEX = (std::numeric_limits<size_t>::max)();
-}
\ No newline at end of file
+
+    // Size of the block that is transferred between caches. Data written by different threads should not share it.
+    const size_t CACHE_LINE_SIZE = 64;
+}
@@ -0,0 +1,352 @@
+#pragma once
+
+#include <libds/amt/hierarchy.h>
+#include <libds/exec/thread_pool.h>
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ds::exec {
+
+    /**
+     * @brief Level-order traversal of a hierarchy whose levels are split among tasks of a thread pool.
+     *
+     * The traversal is level-synchronous: frontiers wider than grainSize are split into blocks of grainSize
+     * nodes processed by tasks of the pool, and the next level starts only after the whole current level
+     * was visited. Within a level the visitor is called concurrently and must be thread-safe. Like
+     * amt::LevelOrderTraversal, the object keeps its frontiers, so repeated traversals allocate nothing.
+     */
+    template<typename BlockType>
+    class ParallelLevelOrderTraversal
+    {
+    public:
+        ParallelLevelOrderTraversal(const amt::Hierarchy<BlockType>& hierarchy, size_t grainSize,
+                                    ThreadPool& pool = ThreadPool::getDefault());
+
+        template<typename Visitor>
+        void process(BlockType* node, Visitor&& visitor);
+
+    private:
+        void appendSons(const BlockType& node, std::vector<BlockType*>& sons) const;
+
+    private:
+        const amt::Hierarchy<BlockType>* hierarchy_;
+        size_t grainSize_;
+        ThreadPool* pool_;
+        std::vector<BlockType*> frontier_;
+        std::vector<BlockType*> nextFrontier_;
+        std::vector<std::vector<BlockType*>> blockSons_;
+    };
+
+    /**
+     * @brief Pre-order traversal of a hierarchy split among tasks of a thread pool.
+     *
+     * Every task walks its subtree in pre-order with its own stack of pending sons. Once a task has visited
+     * grainSize nodes since it last forked, it forks the son at the bottom of its stack to a new task. That son
+     * is the shallowest pending one, so it is usually the root of the largest subtree the task has not entered
+     * yet. Subtree sizes are never computed, which keeps the traversal linear in hierarchies that do not cache
+     * them, and a task is forked at most once per grainSize visited nodes.
+     *
+     * Nodes are visited in pre-order within a task, but tasks run concurrently, so the operation must be
+     * thread-safe. reduce combines map(node) of the nodes of a task from left to right and partial results of
+     * tasks in the order they finish, so combine has to be associative and commutative.
+     */
+    template<typename BlockType>
+    class ParallelPreOrderTraversal
+    {
+    public:
+        static const size_t DEFAULT_GRAIN_SIZE = 1024;
+
+        ParallelPreOrderTraversal(const amt::Hierarchy<BlockType>& hierarchy, size_t grainSize,
+                                  ThreadPool& pool = ThreadPool::getDefault());
+
+        template<typename Operation>
+        void process(const BlockType* node, Operation& operation);
+
+        template<typename Result, typename Map, typename Combine>
+        Result reduce(const BlockType* node, Map& map, Combine& combine);
+
+    private:
+        template<typename Walker>
+        void walk(const BlockType* node, Walker& walker, TaskGroup& group) const;
+
+    private:
+        const amt::Hierarchy<BlockType>* hierarchy_;
+        size_t grainSize_;
+        ThreadPool* pool_;
+    };
+
+    //----------
+
+    /**
+     * @brief Level-order traversal of the subtree of node split among threads of pool, see ParallelLevelOrderTraversal.
+     */
+    template<typename BlockType, typename Visitor>
+    void parallelLevelOrder(const amt::Hierarchy<BlockType>& hierarchy, BlockType* node, Visitor visitor, size_t grainSize,
+                            ThreadPool& pool = ThreadPool::getDefault());
+
+    /**
+     * @brief Pre-order traversal whose subtrees are forked to tasks of pool, see ParallelPreOrderTraversal.
+     */
+    template<typename BlockType, typename Operation>
+    void parallelProcessPreOrder(const amt::Hierarchy<BlockType>& hierarchy, const BlockType* node, Operation operation,
+                                 size_t grainSize, ThreadPool& pool = ThreadPool::getDefault());
+
+    /**
+     * @brief Combines map(node) of all nodes of the subtree of node, see ParallelPreOrderTraversal.
+     * @return Value-initialized result if node is nullptr.
+     */
+    template<typename BlockType, typename Map, typename Combine>
+    auto parallelReduce(const amt::Hierarchy<BlockType>& hierarchy, const BlockType* node, Map map, Combine combine,
+                        size_t grainSize = ParallelPreOrderTraversal<BlockType>::DEFAULT_GRAIN_SIZE,
+                        ThreadPool& pool = ThreadPool::getDefault())
+        -> std::decay_t<std::invoke_result_t<Map&, const BlockType*>>;
+
+    //----------
+
+    template<typename BlockType>
+    ParallelLevelOrderTraversal<BlockType>::ParallelLevelOrderTraversal(const amt::Hierarchy<BlockType>& hierarchy, size_t grainSize, ThreadPool& pool) :
+        hierarchy_(&hierarchy),
+        grainSize_(std::max<size_t>(grainSize, 1)),
+        pool_(&pool)
+    {
+    }
+
+    template<typename BlockType>
+    template<typename Visitor>
+    void ParallelLevelOrderTraversal<BlockType>::process(BlockType* node, Visitor&& visitor)
+    {
+        frontier_.clear();
+        if (node != nullptr)
+        {
+            frontier_.push_back(node);
+        }
+
+        while (!frontier_.empty())
+        {
+            nextFrontier_.clear();
+            if (frontier_.size() <= grainSize_)
+            {
+                for (BlockType* current : frontier_)
+                {
+                    visitor(current);
+                    this->appendSons(*current, nextFrontier_);
+                }
+            }
+            else
+            {
+                const size_t blockCount = (frontier_.size() + grainSize_ - 1) / grainSize_;
+                if (blockSons_.size() < blockCount)
+                {
+                    blockSons_.resize(blockCount);
+                }
+
+                pool_->parallelFor(0, blockCount, 1, [&](size_t block)
+                    {
+                        std::vector<BlockType*>& sons = blockSons_[block];
+                        sons.clear();
+                        const size_t last = std::min(frontier_.size(), (block + 1) * grainSize_);
+                        for (size_t i = block * grainSize_; i < last; ++i)
+                        {
+                            visitor(frontier_[i]);
+                            this->appendSons(*frontier_[i], sons);
+                        }
+                    });
+
+                // Blocks are joined in their order, so every level keeps the order of the serial traversal.
+                for (size_t block = 0; block < blockCount; ++block)
+                {
+                    nextFrontier_.insert(nextFrontier_.end(), blockSons_[block].begin(), blockSons_[block].end());
+                }
+            }
+            std::swap(frontier_, nextFrontier_);
+        }
+    }
+
+    template<typename BlockType>
+    void ParallelLevelOrderTraversal<BlockType>::appendSons(const BlockType& node, std::vector<BlockType*>& sons) const
+    {
+        const size_t nodeDegree = hierarchy_->degree(node);
+        size_t sonsProcessed = 0;
+        for (size_t n = 0; sonsProcessed < nodeDegree; ++n)
+        {
+            BlockType* son = hierarchy_->accessSon(node, n);
+            if (son != nullptr)
+            {
+                sons.push_back(son);
+                ++sonsProcessed;
+            }
+        }
+    }
+
+    template<typename BlockType>
+    ParallelPreOrderTraversal<BlockType>::ParallelPreOrderTraversal(const amt::Hierarchy<BlockType>& hierarchy, size_t grainSize, ThreadPool& pool) :
+        hierarchy_(&hierarchy),
+        grainSize_(std::max<size_t>(grainSize, 1)),
+        pool_(&pool)
+    {
+    }
+
+    template<typename BlockType>
+    template<typename Operation>
+    void ParallelPreOrderTraversal<BlockType>::process(const BlockType* node, Operation& operation)
+    {
+        struct ProcessWalker
+        {
+            struct Local
+            {
+            };
+
+            Local start()
+            {
+                return Local();
+            }
+
+            void visit(Local&, const BlockType* current)
+            {
+                operation_(current);
+            }
+
+            void finish(Local&)
+            {
+            }
+
+            Operation& operation_;
+        };
+
+        if (node != nullptr)
+        {
+            ProcessWalker walker{operation};
+            TaskGroup group(*pool_);
+            this->walk(node, walker, group);
+            group.wait();
+        }
+    }
+
+    template<typename BlockType>
+    template<typename Result, typename Map, typename Combine>
+    Result ParallelPreOrderTraversal<BlockType>::reduce(const BlockType* node, Map& map, Combine& combine)
+    {
+        // Every task starts from the map of its first node, so no identity of combine is needed.
+        struct ReduceWalker
+        {
+            using Local = std::optional<Result>;
+
+            ReduceWalker(Map& map, Combine& combine) :
+                map_(map),
+                combine_(combine)
+            {
+            }
+
+            Local start()
+            {
+                return Local();
+            }
+
+            void visit(Local& local, const BlockType* current)
+            {
+                if (local.has_value())
+                {
+                    local = combine_(std::move(*local), map_(current));
+                }
+                else
+                {
+                    local.emplace(map_(current));
+                }
+            }
+
+            void finish(Local& local)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (result_.has_value())
+                {
+                    result_ = combine_(std::move(*result_), std::move(*local));
+                }
+                else
+                {
+                    result_ = std::move(local);
+                }
+            }
+
+            Map& map_;
+            Combine& combine_;
+            std::mutex mutex_;
+            std::optional<Result> result_;
+        };
+
+        if (node == nullptr)
+        {
+            return Result();
+        }
+
+        ReduceWalker walker(map, combine);
+        TaskGroup group(*pool_);
+        this->walk(node, walker, group);
+        group.wait();
+        return std::move(*walker.result_);
+    }
+
+    template<typename BlockType>
+    template<typename Walker>
+    void ParallelPreOrderTraversal<BlockType>::walk(const BlockType* node, Walker& walker, TaskGroup& group) const
+    {
+        typename Walker::Local local = walker.start();
+        std::deque<const BlockType*> pending;
+        pending.push_back(node);
+        size_t visitedSinceFork = 0;
+        while (!pending.empty())
+        {
+            const BlockType* current = pending.back();
+            pending.pop_back();
+            walker.visit(local, current);
+
+            // Sons are pushed in reverse, so the first son is on top of the stack.
+            const size_t sonsBegin = pending.size();
+            const size_t nodeDegree = hierarchy_->degree(*current);
+            size_t sonsProcessed = 0;
+            for (size_t n = 0; sonsProcessed < nodeDegree; ++n)
+            {
+                const BlockType* son = hierarchy_->accessSon(*current, n);
+                if (son != nullptr)
+                {
+                    pending.push_back(son);
+                    ++sonsProcessed;
+                }
+            }
+            std::reverse(pending.begin() + sonsBegin, pending.end());
+
+            if (++visitedSinceFork >= grainSize_ && pending.size() > 1)
+            {
+                const BlockType* forked = pending.front();
+                pending.pop_front();
+                group.run([this, &walker, &group, forked]() { this->walk(forked, walker, group); });
+                visitedSinceFork = 0;
+            }
+        }
+        walker.finish(local);
+    }
+
+    template<typename BlockType, typename Visitor>
+    void parallelLevelOrder(const amt::Hierarchy<BlockType>& hierarchy, BlockType* node, Visitor visitor, size_t grainSize, ThreadPool& pool)
+    {
+        ParallelLevelOrderTraversal<BlockType>(hierarchy, grainSize, pool).process(node, visitor);
+    }
+
+    template<typename BlockType, typename Operation>
+    void parallelProcessPreOrder(const amt::Hierarchy<BlockType>& hierarchy, const BlockType* node, Operation operation, size_t grainSize, ThreadPool& pool)
+    {
+        ParallelPreOrderTraversal<BlockType>(hierarchy, grainSize, pool).process(node, operation);
+    }
+
+    template<typename BlockType, typename Map, typename Combine>
+    auto parallelReduce(const amt::Hierarchy<BlockType>& hierarchy, const BlockType* node, Map map, Combine combine, size_t grainSize, ThreadPool& pool)
+        -> std::decay_t<std::invoke_result_t<Map&, const BlockType*>>
+    {
+        using Result = std::decay_t<std::invoke_result_t<Map&, const BlockType*>>;
+        return ParallelPreOrderTraversal<BlockType>(hierarchy, grainSize, pool).template reduce<Result>(node, map, combine);
+    }
+}
@@ -0,0 +1,620 @@
+#pragma once
+
+#include <libds/exec/work_stealing_deque.h>
+#include <libds/adt/queue.h>
+#include <libds/amt/implicit_sequence.h>
+#include <libds/heap_monitor.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ds::exec {
+
+    class TaskGroup;
+    class TaskArena;
+
+    /**
+     * @brief Unit of work executed by the thread pool.
+     * The callable is stored inline, so spawning a task never allocates once the arena is warm.
+     */
+    struct Task
+    {
+        static const size_t STORAGE_SIZE = 64;
+
+        void (*execute_)(Task* task);
+        TaskGroup* group_;
+        TaskArena* arena_;
+        Task* nextFree_;
+        alignas(std::max_align_t) unsigned char storage_[STORAGE_SIZE];
+    };
+
+    //----------
+
+    /**
+     * @brief Pool of task blocks. Blocks are allocated in chunks and recycled through a free list.
+     * Every block returns to the arena it came from: its owner releases it to the free list, other threads
+     * push it to a lock-free list of returned blocks, which the owner takes over when the free list is empty.
+     * So the number of chunks is bounded by the peak number of live tasks of the arena.
+     */
+    class TaskArena
+    {
+    public:
+        TaskArena() = default;
+        TaskArena(const TaskArena& other) = delete;
+        ~TaskArena();
+
+        /**
+         * @brief Owner only.
+         */
+        Task* allocate();
+
+        /**
+         * @brief Owner only.
+         */
+        void release(Task* task);
+
+        /**
+         * @brief Any thread.
+         */
+        void releaseRemote(Task* task);
+
+        size_t getChunkCount() const;
+
+        static const size_t TASKS_PER_CHUNK = 64;
+
+    private:
+        amt::IS<Task*> chunks_;
+        std::atomic<size_t> chunkCount_ = 0;
+        Task* free_ = nullptr;
+        std::atomic<Task*> returned_ = nullptr;
+    };
+
+    //----------
+
+    /**
+     * @brief Fixed set of worker threads, each with its own work-stealing deque and task arena.
+     *
+     * Tasks spawned by a worker go to its deque; tasks spawned by other threads go to a shared injection queue.
+     * Idle workers steal from random victims and sleep when there is nothing to do.
+     * Callables must fit into @c Task::STORAGE_SIZE bytes (capture large state by reference).
+     */
+    class ThreadPool
+    {
+    public:
+        ThreadPool();
+        explicit ThreadPool(size_t threadCount);
+        ThreadPool(const ThreadPool& other) = delete;
+        ~ThreadPool();
+
+        size_t getThreadCount() const;
+
+        /**
+         * @brief Runs op asynchronously. Exceptions escaping op terminate the program.
+         */
+        template<typename Operation>
+        void submit(Operation&& op);
+
+        /**
+         * @brief Calls body(i) for every i in [begin, end). Ranges are split until they have at most grainSize indices.
+         */
+        template<typename Body>
+        void parallelFor(size_t begin, size_t end, size_t grainSize, Body&& body);
+
+        /**
+         * @brief Combines map(first, last) over consecutive blocks of at most grainSize indices of [begin, end).
+         * Partial results are combined from left to right, so combine only has to be associative.
+         */
+        template<typename Result, typename Map, typename Combine>
+        Result parallelReduce(size_t begin, size_t end, size_t grainSize, Result identity, Map&& map, Combine&& combine);
+
+        /**
+         * @brief Number of task chunks allocated by the arenas of the pool.
+         */
+        size_t getTaskChunkCount() const;
+
+        /**
+         * @brief Pool shared by the library (sorts, hierarchy traversals, analyzers).
+         */
+        static ThreadPool& getDefault();
+
+    private:
+        friend class TaskGroup;
+
+        struct Worker
+        {
+            WorkStealingDeque<Task*> deque_;
+            TaskArena arena_;
+            std::thread thread_;
+            unsigned int seed_ = 0;
+        };
+
+        // Zero-initialized as a thread_local, so pool_ is nullptr on threads that are not workers.
+        struct WorkerContext
+        {
+            const ThreadPool* pool_;
+            size_t index_;
+        };
+
+        template<typename Operation>
+        Task* createTask(Operation&& op, TaskGroup* group);
+        void schedule(Task* task);
+        bool tryRunOne();
+        Task* findTask();
+        void runTask(Task* task);
+        void workerLoop(size_t index);
+        Worker* currentWorker() const;
+
+        static inline thread_local WorkerContext context_;
+
+    private:
+        std::vector<std::unique_ptr<Worker>> workers_;
+        TaskArena externalArena_;
+        std::mutex externalMutex_;
+        adt::ChunkedQueue<Task*> injected_;
+        std::atomic<size_t> queuedTasks_;
+        std::atomic<size_t> unfinishedTasks_;
+        std::atomic<size_t> sleepingWorkers_;
+        std::mutex sleepMutex_;
+        std::condition_variable wakeUp_;
+        std::condition_variable allFinished_;
+        std::atomic<bool> stopping_;
+    };
+
+    //----------
+
+    /**
+     * @brief Set of tasks that can be waited for. Waiting threads execute pending tasks of the pool
+     * instead of blocking, so groups can be nested inside tasks. The first exception thrown by a task
+     * is rethrown by @c wait .
+     */
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup(ThreadPool& pool);
+        TaskGroup(const TaskGroup& other) = delete;
+        ~TaskGroup();
+
+        template<typename Operation>
+        void run(Operation&& op);
+
+        void wait();
+
+    private:
+        friend class ThreadPool;
+
+        void finishTask(std::exception_ptr error);
+
+    private:
+        ThreadPool& pool_;
+        std::atomic<size_t> pending_;
+        std::mutex errorMutex_;
+        std::exception_ptr error_;
+    };
+
+    //----------
+
+    inline TaskArena::~TaskArena()
+    {
+        for (Task* chunk : chunks_)
+        {
+            delete[] chunk;
+        }
+    }
+
+    inline Task* TaskArena::allocate()
+    {
+        if (free_ == nullptr)
+        {
+            free_ = returned_.exchange(nullptr, std::memory_order_acquire);
+        }
+        if (free_ == nullptr)
+        {
+            Task* chunk = new Task[TASKS_PER_CHUNK];
+            chunks_.insertLast().data_ = chunk;
+            chunkCount_.fetch_add(1, std::memory_order_relaxed);
+            for (size_t i = 0; i < TASKS_PER_CHUNK; ++i)
+            {
+                chunk[i].arena_ = this;
+                chunk[i].nextFree_ = free_;
+                free_ = &chunk[i];
+            }
+        }
+
+        Task* task = free_;
+        free_ = task->nextFree_;
+        return task;
+    }
+
+    inline void TaskArena::release(Task* task)
+    {
+        task->nextFree_ = free_;
+        free_ = task;
+    }
+
+    inline void TaskArena::releaseRemote(Task* task)
+    {
+        // Only the owner takes blocks and it takes the whole list at once, so pushes do not suffer from ABA.
+        Task* head = returned_.load(std::memory_order_relaxed);
+        do
+        {
+            task->nextFree_ = head;
+        }
+        while (!returned_.compare_exchange_weak(head, task, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    inline size_t TaskArena::getChunkCount() const
+    {
+        return chunkCount_.load(std::memory_order_relaxed);
+    }
+
+    inline ThreadPool::ThreadPool() :
+        ThreadPool(std::max(1u, std::thread::hardware_concurrency()))
+    {
+    }
+
+    inline ThreadPool::ThreadPool(size_t threadCount) :
+        queuedTasks_(0),
+        unfinishedTasks_(0),
+        sleepingWorkers_(0),
+        stopping_(false)
+    {
+        threadCount = std::max<size_t>(threadCount, 1);
+        workers_.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            workers_.push_back(std::make_unique<Worker>());
+            workers_.back()->seed_ = static_cast<unsigned int>(i * 2654435761u + 1);
+        }
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            workers_[i]->thread_ = std::thread([this, i]() { this->workerLoop(i); });
+        }
+    }
+
+    inline ThreadPool::~ThreadPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            allFinished_.wait(lock, [this]() { return unfinishedTasks_.load() == 0; });
+            stopping_.store(true);
+        }
+        wakeUp_.notify_all();
+        for (std::unique_ptr<Worker>& worker : workers_)
+        {
+            worker->thread_.join();
+        }
+    }
+
+    inline size_t ThreadPool::getThreadCount() const
+    {
+        return workers_.size();
+    }
+
+    template<typename Operation>
+    void ThreadPool::submit(Operation&& op)
+    {
+        this->schedule(this->createTask(std::forward<Operation>(op), nullptr));
+    }
+
+    template<typename Body>
+    void ThreadPool::parallelFor(size_t begin, size_t end, size_t grainSize, Body&& body)
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+        grainSize = std::max<size_t>(grainSize, 1);
+
+        TaskGroup group(*this);
+        // Recursive halving: the upper half becomes a stealable task, the lower half is processed in place.
+        struct Splitter
+        {
+            static void run(TaskGroup& group, Body& body, size_t first, size_t last, size_t grain)
+            {
+                while (last - first > grain)
+                {
+                    const size_t middle = first + (last - first) / 2;
+                    group.run([&group, &body, middle, last, grain]() { Splitter::run(group, body, middle, last, grain); });
+                    last = middle;
+                }
+                for (size_t i = first; i < last; ++i)
+                {
+                    body(i);
+                }
+            }
+        };
+        Splitter::run(group, body, begin, end, grainSize);
+        group.wait();
+    }
+
+    template<typename Result, typename Map, typename Combine>
+    Result ThreadPool::parallelReduce(size_t begin, size_t end, size_t grainSize, Result identity, Map&& map, Combine&& combine)
+    {
+        if (begin >= end)
+        {
+            return identity;
+        }
+        grainSize = std::max<size_t>(grainSize, 1);
+
+        const size_t blockCount = (end - begin + grainSize - 1) / grainSize;
+        std::vector<Result> partials(blockCount, identity);
+        this->parallelFor(0, blockCount, 1, [&](size_t block)
+            {
+                const size_t first = begin + block * grainSize;
+                partials[block] = map(first, std::min(first + grainSize, end));
+            });
+
+        Result result = identity;
+        for (const Result& partial : partials)
+        {
+            result = combine(result, partial);
+        }
+        return result;
+    }
+
+    inline size_t ThreadPool::getTaskChunkCount() const
+    {
+        size_t result = externalArena_.getChunkCount();
+        for (const std::unique_ptr<Worker>& worker : workers_)
+        {
+            result += worker->arena_.getChunkCount();
+        }
+        return result;
+    }
+
+    inline ThreadPool& ThreadPool::getDefault()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    template<typename Operation>
+    Task* ThreadPool::createTask(Operation&& op, TaskGroup* group)
+    {
+        using Callable = std::decay_t<Operation>;
+        static_assert(sizeof(Callable) <= Task::STORAGE_SIZE, "Task is too large, capture its state by reference.");
+        static_assert(alignof(Callable) <= alignof(std::max_align_t), "Task is over-aligned.");
+
+        Worker* worker = this->currentWorker();
+        Task* task;
+        if (worker != nullptr)
+        {
+            task = worker->arena_.allocate();
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(externalMutex_);
+            task = externalArena_.allocate();
+        }
+
+        placement_emplace(reinterpret_cast<Callable*>(task->storage_), std::forward<Operation>(op));
+        task->group_ = group;
+        task->execute_ = [](Task* self)
+            {
+                Callable* callable = std::launder(reinterpret_cast<Callable*>(self->storage_));
+                struct Destroyer
+                {
+                    Callable* callable_;
+                    ~Destroyer() { callable_->~Callable(); }
+                } destroyer{ callable };
+                (*callable)();
+            };
+        return task;
+    }
+
+    inline void ThreadPool::schedule(Task* task)
+    {
+        unfinishedTasks_.fetch_add(1);
+        queuedTasks_.fetch_add(1);
+
+        Worker* worker = this->currentWorker();
+        if (worker != nullptr)
+        {
+            worker->deque_.push(task);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(externalMutex_);
+            injected_.push(task);
+        }
+
+        if (sleepingWorkers_.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            wakeUp_.notify_one();
+        }
+    }
+
+    inline bool ThreadPool::tryRunOne()
+    {
+        Task* task = this->findTask();
+        if (task == nullptr)
+        {
+            return false;
+        }
+        this->runTask(task);
+        return true;
+    }
+
+    inline Task* ThreadPool::findTask()
+    {
+        Task* task = nullptr;
+        Worker* worker = this->currentWorker();
+        if (worker != nullptr && worker->deque_.pop(task))
+        {
+            queuedTasks_.fetch_sub(1);
+            return task;
+        }
+
+        if (queuedTasks_.load() == 0)
+        {
+            return nullptr;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(externalMutex_);
+            if (!injected_.isEmpty())
+            {
+                queuedTasks_.fetch_sub(1);
+                return injected_.pop();
+            }
+        }
+
+        const size_t count = workers_.size();
+        size_t start = 0;
+        if (worker != nullptr)
+        {
+            // xorshift, so that thieves do not all start with the same victim
+            worker->seed_ ^= worker->seed_ << 13;
+            worker->seed_ ^= worker->seed_ >> 17;
+            worker->seed_ ^= worker->seed_ << 5;
+            start = worker->seed_ % count;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            Worker* victim = workers_[(start + i) % count].get();
+            if (victim != worker && victim->deque_.steal(task))
+            {
+                queuedTasks_.fetch_sub(1);
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    inline void ThreadPool::runTask(Task* task)
+    {
+        TaskGroup* group = task->group_;
+        if (group != nullptr)
+        {
+            std::exception_ptr error;
+            try
+            {
+                task->execute_(task);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            group->finishTask(error);
+        }
+        else
+        {
+            task->execute_(task);
+        }
+
+        Worker* worker = this->currentWorker();
+        TaskArena* arena = task->arena_;
+        if (worker != nullptr && arena == &worker->arena_)
+        {
+            arena->release(task);
+        }
+        else
+        {
+            arena->releaseRemote(task);
+        }
+
+        if (unfinishedTasks_.fetch_sub(1) == 1)
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            allFinished_.notify_all();
+        }
+    }
+
+    inline void ThreadPool::workerLoop(size_t index)
+    {
+        context_.pool_ = this;
+        context_.index_ = index;
+
+        while (true)
+        {
+            if (this->tryRunOne())
+            {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            sleepingWorkers_.fetch_add(1);
+            wakeUp_.wait(lock, [this]() { return queuedTasks_.load() > 0 || stopping_.load(); });
+            sleepingWorkers_.fetch_sub(1);
+            if (stopping_.load() && queuedTasks_.load() == 0)
+            {
+                break;
+            }
+        }
+
+        context_.pool_ = nullptr;
+    }
+
+    inline ThreadPool::Worker* ThreadPool::currentWorker() const
+    {
+        return context_.pool_ == this ? workers_[context_.index_].get() : nullptr;
+    }
+
+    inline TaskGroup::TaskGroup(ThreadPool& pool) :
+        pool_(pool),
+        pending_(0)
+    {
+    }
+
+    inline TaskGroup::~TaskGroup()
+    {
+        while (pending_.load(std::memory_order_acquire) > 0)
+        {
+            if (!pool_.tryRunOne())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    template<typename Operation>
+    void TaskGroup::run(Operation&& op)
+    {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        pool_.schedule(pool_.createTask(std::forward<Operation>(op), this));
+    }
+
+    inline void TaskGroup::wait()
+    {
+        while (pending_.load(std::memory_order_acquire) > 0)
+        {
+            if (!pool_.tryRunOne())
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(errorMutex_);
+            std::swap(error, error_);
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    inline void TaskGroup::finishTask(std::exception_ptr error)
+    {
+        if (error)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex_);
+            if (!error_)
+            {
+                error_ = error;
+            }
+        }
+        pending_.fetch_sub(1, std::memory_order_release);
+    }
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <libds/amt/explicit_sequence.h>
+#include <libds/constants.h>
+#include <atomic>
+#include <cstdint>
+
+namespace ds::exec {
+
+    /**
+     * @brief Chase-Lev work-stealing deque (with the C11 memory orders of Le et al.).
+     *
+     * The owning thread pushes and pops at the bottom (LIFO), other threads steal from the top (FIFO).
+     * Only steals and the pop of the last element need a CAS. The buffer is a power-of-two array of atomics
+     * that is never moved in memory; when it is full a buffer of double size replaces it and the old one is
+     * retired until the deque is destroyed, because a thief may still be reading it. T must be trivially
+     * copyable (typically a pointer to a task).
+     */
+    template<typename T>
+    class WorkStealingDeque
+    {
+    public:
+        WorkStealingDeque();
+        explicit WorkStealingDeque(size_t capacity);
+        WorkStealingDeque(const WorkStealingDeque& other) = delete;
+        ~WorkStealingDeque();
+
+        size_t size() const;
+        bool isEmpty() const;
+
+        /**
+         * @brief Inserts item at the bottom. Owner only.
+         */
+        void push(T item);
+
+        /**
+         * @brief Removes the most recently pushed item. Owner only.
+         * @return false if the deque was empty.
+         */
+        bool pop(T& item);
+
+        /**
+         * @brief Removes the oldest item. Any thread.
+         * @return false if the deque was empty or another thread won the race for the item.
+         */
+        bool steal(T& item);
+
+        static const size_t INIT_CAPACITY = 256;
+
+    private:
+        struct Buffer
+        {
+            explicit Buffer(size_t capacity);
+            Buffer(const Buffer& other) = delete;
+            ~Buffer();
+
+            std::atomic<T>& at(std::int64_t index) const;
+
+            std::atomic<T>* items_;
+            std::int64_t mask_;
+        };
+
+        Buffer* grow(Buffer* buffer, std::int64_t top, std::int64_t bottom);
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> top_;
+        alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> bottom_;
+        std::atomic<Buffer*> buffer_;
+        amt::SinglyLS<Buffer*> retiredBuffers_;
+    };
+
+    //----------
+
+    template<typename T>
+    WorkStealingDeque<T>::Buffer::Buffer(size_t capacity) :
+        items_(new std::atomic<T>[capacity]),
+        mask_(static_cast<std::int64_t>(capacity) - 1)
+    {
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            items_[i].store(T(), std::memory_order_relaxed);
+        }
+    }
+
+    template<typename T>
+    WorkStealingDeque<T>::Buffer::~Buffer()
+    {
+        delete[] items_;
+    }
+
+    template<typename T>
+    std::atomic<T>& WorkStealingDeque<T>::Buffer::at(std::int64_t index) const
+    {
+        return items_[index & mask_];
+    }
+
+    template<typename T>
+    WorkStealingDeque<T>::WorkStealingDeque() :
+        WorkStealingDeque(INIT_CAPACITY)
+    {
+    }
+
+    template<typename T>
+    WorkStealingDeque<T>::WorkStealingDeque(size_t capacity) :
+        top_(0),
+        bottom_(0),
+        buffer_(nullptr)
+    {
+        size_t rounded = 2;
+        while (rounded < capacity)
+        {
+            rounded <<= 1;
+        }
+        buffer_.store(new Buffer(rounded), std::memory_order_relaxed);
+    }
+
+    template<typename T>
+    WorkStealingDeque<T>::~WorkStealingDeque()
+    {
+        delete buffer_.load(std::memory_order_relaxed);
+        for (Buffer* buffer : retiredBuffers_)
+        {
+            delete buffer;
+        }
+    }
+
+    template<typename T>
+    size_t WorkStealingDeque<T>::size() const
+    {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t top = top_.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    template<typename T>
+    bool WorkStealingDeque<T>::isEmpty() const
+    {
+        return this->size() == 0;
+    }
+
+    template<typename T>
+    void WorkStealingDeque<T>::push(T item)
+    {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t top = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        if (bottom - top > buffer->mask_)
+        {
+            buffer = this->grow(buffer, top, bottom);
+        }
+        buffer->at(bottom).store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    template<typename T>
+    bool WorkStealingDeque<T>::pop(T& item)
+    {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        item = buffer->at(bottom).load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // Last item: race against thieves for it.
+            const bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool WorkStealingDeque<T>::steal(T& item)
+    {
+        std::int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            return false;
+        }
+
+        Buffer* buffer = buffer_.load(std::memory_order_acquire);
+        item = buffer->at(top).load(std::memory_order_relaxed);
+        return top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    template<typename T>
+    auto WorkStealingDeque<T>::grow(Buffer* buffer, std::int64_t top, std::int64_t bottom) -> Buffer*
+    {
+        Buffer* bigger = new Buffer(static_cast<size_t>(buffer->mask_ + 1) * 2);
+        for (std::int64_t i = top; i < bottom; ++i)
+        {
+            bigger->at(i).store(buffer->at(i).load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        retiredBuffers_.insertLast().data_ = buffer;
+        buffer_.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <libds/graph/graph_view.h>
+#include <libds/exec/thread_pool.h>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ds::graph {
+
+    /**
+     * @brief Direction-optimizing parallel breadth-first search (Beamer et al.).
+     *
+     * Levels are expanded top-down (frontier nodes claim their unvisited neighbours with a CAS) while the frontier
+     * is small and bottom-up (every unvisited node looks for a neighbour in the frontier and stops at the first one)
+     * once the edges leaving the frontier exceed 1/ALPHA of the unexplored edges. The search returns to top-down
+     * when fewer than 1/BETA of the nodes were discovered in the last level.
+     * Bottom-up steps rely on relations being symmetric, which holds for ds::amt networks.
+     */
+    class BreadthFirstSearch
+    {
+    public:
+        explicit BreadthFirstSearch(exec::ThreadPool& pool = exec::ThreadPool::getDefault());
+
+        /**
+         * @brief Computes the number of relations on the shortest path from source to every node.
+         * @return Level of every node in gate order, UNREACHED for nodes not connected to source.
+         */
+        template<typename DataType>
+        std::vector<size_t> run(const GraphView<DataType>& graph, size_t source);
+
+        size_t getTopDownStepCount() const;
+        size_t getBottomUpStepCount() const;
+
+        static constexpr size_t UNREACHED = std::numeric_limits<size_t>::max();
+        static constexpr size_t ALPHA = 14;
+        static constexpr size_t BETA = 24;
+        static constexpr size_t GRAIN_SIZE = 256;
+
+    private:
+        using Levels = std::unique_ptr<std::atomic<size_t>[]>;
+
+        /**
+         * @brief Expands frontier[0 ... frontierSize - 1] into next.
+         * @return Size of the next frontier and the sum of degrees of its nodes.
+         */
+        template<typename DataType>
+        std::pair<size_t, size_t> topDownStep(const GraphView<DataType>& graph, Levels& levels, size_t level,
+                                              const std::vector<size_t>& frontier, size_t frontierSize, std::vector<size_t>& next);
+
+        /**
+         * @brief Assigns level + 1 to every unvisited node with a neighbour at the given level.
+         * @return Number of nodes discovered and the sum of their degrees.
+         */
+        template<typename DataType>
+        std::pair<size_t, size_t> bottomUpStep(const GraphView<DataType>& graph, Levels& levels, size_t level);
+
+        /**
+         * @brief Collects the nodes at the given level into frontier.
+         */
+        void collectLevel(size_t nodeCount, Levels& levels, size_t level, std::vector<size_t>& frontier);
+
+    private:
+        exec::ThreadPool* pool_;
+        size_t topDownStepCount_;
+        size_t bottomUpStepCount_;
+    };
+
+    //----------
+
+    inline BreadthFirstSearch::BreadthFirstSearch(exec::ThreadPool& pool) :
+        pool_(&pool),
+        topDownStepCount_(0),
+        bottomUpStepCount_(0)
+    {
+    }
+
+    template<typename DataType>
+    std::vector<size_t> BreadthFirstSearch::run(const GraphView<DataType>& graph, size_t source)
+    {
+        const size_t nodeCount = graph.nodeCount();
+        if (source >= nodeCount)
+        {
+            throw std::out_of_range("Source node does not exist!");
+        }
+
+        topDownStepCount_ = 0;
+        bottomUpStepCount_ = 0;
+
+        Levels levels(new std::atomic<size_t>[nodeCount]);
+        pool_->parallelFor(0, nodeCount, GRAIN_SIZE * 4, [&levels](size_t i)
+            {
+                levels[i].store(UNREACHED, std::memory_order_relaxed);
+            });
+        levels[source].store(0, std::memory_order_relaxed);
+
+        std::vector<size_t> frontier(nodeCount);
+        std::vector<size_t> next(nodeCount);
+        frontier[0] = source;
+        size_t frontierSize = 1;
+        size_t frontierEdges = graph.degree(source);
+        size_t unexploredEdges = graph.relationCount();
+        bool bottomUp = false;
+
+        for (size_t level = 0; frontierSize > 0; ++level)
+        {
+            if (!bottomUp && frontierEdges > unexploredEdges / ALPHA)
+            {
+                bottomUp = true;
+            }
+
+            std::pair<size_t, size_t> discovered;
+            if (bottomUp)
+            {
+                discovered = this->bottomUpStep(graph, levels, level);
+                ++bottomUpStepCount_;
+                if (discovered.first < nodeCount / BETA)
+                {
+                    bottomUp = false;
+                    this->collectLevel(nodeCount, levels, level + 1, frontier);
+                }
+            }
+            else
+            {
+                discovered = this->topDownStep(graph, levels, level, frontier, frontierSize, next);
+                ++topDownStepCount_;
+                std::swap(frontier, next);
+            }
+
+            unexploredEdges -= std::min(unexploredEdges, frontierEdges);
+            frontierSize = discovered.first;
+            frontierEdges = discovered.second;
+        }
+
+        std::vector<size_t> result(nodeCount);
+        pool_->parallelFor(0, nodeCount, GRAIN_SIZE * 4, [&levels, &result](size_t i)
+            {
+                result[i] = levels[i].load(std::memory_order_relaxed);
+            });
+        return result;
+    }
+
+    inline size_t BreadthFirstSearch::getTopDownStepCount() const
+    {
+        return topDownStepCount_;
+    }
+
+    inline size_t BreadthFirstSearch::getBottomUpStepCount() const
+    {
+        return bottomUpStepCount_;
+    }
+
+    template<typename DataType>
+    std::pair<size_t, size_t> BreadthFirstSearch::topDownStep(const GraphView<DataType>& graph, Levels& levels, size_t level,
+                                                              const std::vector<size_t>& frontier, size_t frontierSize, std::vector<size_t>& next)
+    {
+        std::atomic<size_t> nextSize(0);
+        std::atomic<size_t> nextEdges(0);
+        const size_t blockCount = (frontierSize + GRAIN_SIZE - 1) / GRAIN_SIZE;
+        pool_->parallelFor(0, blockCount, 1, [&](size_t block)
+            {
+                // Nodes are claimed into a local buffer so the shared frontier is reserved once per block.
+                std::vector<size_t> claimed;
+                size_t claimedEdges = 0;
+                const size_t last = std::min(frontierSize, (block + 1) * GRAIN_SIZE);
+                for (size_t f = block * GRAIN_SIZE; f < last; ++f)
+                {
+                    const size_t node = frontier[f];
+                    const size_t* neighbours = graph.accessNeighbours(node);
+                    const size_t degree = graph.degree(node);
+                    for (size_t k = 0; k < degree; ++k)
+                    {
+                        const size_t neighbour = neighbours[k];
+                        size_t expected = UNREACHED;
+                        if (levels[neighbour].load(std::memory_order_relaxed) == UNREACHED
+                            && levels[neighbour].compare_exchange_strong(expected, level + 1, std::memory_order_relaxed))
+                        {
+                            claimed.push_back(neighbour);
+                            claimedEdges += graph.degree(neighbour);
+                        }
+                    }
+                }
+
+                const size_t position = nextSize.fetch_add(claimed.size(), std::memory_order_relaxed);
+                std::copy(claimed.begin(), claimed.end(), next.begin() + position);
+                nextEdges.fetch_add(claimedEdges, std::memory_order_relaxed);
+            });
+
+        return std::make_pair(nextSize.load(), nextEdges.load());
+    }
+
+    template<typename DataType>
+    std::pair<size_t, size_t> BreadthFirstSearch::bottomUpStep(const GraphView<DataType>& graph, Levels& levels, size_t level)
+    {
+        using Counts = std::pair<size_t, size_t>;
+        return pool_->parallelReduce(0, graph.nodeCount(), GRAIN_SIZE * 4, Counts(0, 0),
+            [&](size_t first, size_t last)
+            {
+                Counts counts(0, 0);
+                for (size_t node = first; node < last; ++node)
+                {
+                    if (levels[node].load(std::memory_order_relaxed) != UNREACHED)
+                    {
+                        continue;
+                    }
+
+                    const size_t* neighbours = graph.accessNeighbours(node);
+                    const size_t degree = graph.degree(node);
+                    for (size_t k = 0; k < degree; ++k)
+                    {
+                        // Nodes discovered in this step get level + 1, so they never match and no CAS is needed.
+                        if (levels[neighbours[k]].load(std::memory_order_relaxed) == level)
+                        {
+                            levels[node].store(level + 1, std::memory_order_relaxed);
+                            ++counts.first;
+                            counts.second += degree;
+                            break;
+                        }
+                    }
+                }
+                return counts;
+            },
+            [](const Counts& a, const Counts& b)
+            {
+                return Counts(a.first + b.first, a.second + b.second);
+            });
+    }
+
+    inline void BreadthFirstSearch::collectLevel(size_t nodeCount, Levels& levels, size_t level, std::vector<size_t>& frontier)
+    {
+        std::atomic<size_t> size(0);
+        const size_t blockSize = GRAIN_SIZE * 4;
+        const size_t blockCount = (nodeCount + blockSize - 1) / blockSize;
+        pool_->parallelFor(0, blockCount, 1, [&](size_t block)
+            {
+                std::vector<size_t> collected;
+                const size_t last = std::min(nodeCount, (block + 1) * blockSize);
+                for (size_t node = block * blockSize; node < last; ++node)
+                {
+                    if (levels[node].load(std::memory_order_relaxed) == level)
+                    {
+                        collected.push_back(node);
+                    }
+                }
+                const size_t position = size.fetch_add(collected.size(), std::memory_order_relaxed);
+                std::copy(collected.begin(), collected.end(), frontier.begin() + position);
+            });
+    }
+}
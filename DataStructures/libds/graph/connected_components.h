@@ -0,0 +1,138 @@
+#pragma once
+
+#include <libds/graph/graph_view.h>
+#include <libds/exec/thread_pool.h>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ds::graph {
+
+    /**
+     * @brief Connected components by a lock-free parallel union-find.
+     *
+     * Every relation is processed once (from its node with the smaller index) by a task of the pool. Roots are linked
+     * with a CAS from the larger index to the smaller one and finds shorten paths by halving, so after the last union
+     * the root of every component is its node with the smallest index.
+     */
+    class ConnectedComponents
+    {
+    public:
+        explicit ConnectedComponents(exec::ThreadPool& pool = exec::ThreadPool::getDefault());
+
+        /**
+         * @return For every node in gate order the smallest index of a node in its component.
+         */
+        template<typename DataType>
+        std::vector<size_t> run(const GraphView<DataType>& graph);
+
+        size_t getComponentCount() const;
+
+        static constexpr size_t GRAIN_SIZE = 1024;
+
+    private:
+        using Parents = std::unique_ptr<std::atomic<size_t>[]>;
+
+        static size_t find(Parents& parents, size_t node);
+        static void unite(Parents& parents, size_t nodeA, size_t nodeB);
+
+    private:
+        exec::ThreadPool* pool_;
+        size_t componentCount_;
+    };
+
+    //----------
+
+    inline ConnectedComponents::ConnectedComponents(exec::ThreadPool& pool) :
+        pool_(&pool),
+        componentCount_(0)
+    {
+    }
+
+    template<typename DataType>
+    std::vector<size_t> ConnectedComponents::run(const GraphView<DataType>& graph)
+    {
+        const size_t nodeCount = graph.nodeCount();
+
+        Parents parents(new std::atomic<size_t>[nodeCount]);
+        pool_->parallelFor(0, nodeCount, GRAIN_SIZE, [&parents](size_t i)
+            {
+                parents[i].store(i, std::memory_order_relaxed);
+            });
+
+        pool_->parallelFor(0, nodeCount, GRAIN_SIZE / 4, [&graph, &parents](size_t node)
+            {
+                const size_t* neighbours = graph.accessNeighbours(node);
+                const size_t degree = graph.degree(node);
+                for (size_t k = 0; k < degree; ++k)
+                {
+                    if (node < neighbours[k])
+                    {
+                        unite(parents, node, neighbours[k]);
+                    }
+                }
+            });
+
+        std::vector<size_t> labels(nodeCount);
+        componentCount_ = pool_->parallelReduce(0, nodeCount, GRAIN_SIZE, size_t(0),
+            [&parents, &labels](size_t first, size_t last)
+            {
+                size_t roots = 0;
+                for (size_t node = first; node < last; ++node)
+                {
+                    labels[node] = find(parents, node);
+                    roots += labels[node] == node ? 1 : 0;
+                }
+                return roots;
+            },
+            [](size_t a, size_t b) { return a + b; });
+        return labels;
+    }
+
+    inline size_t ConnectedComponents::getComponentCount() const
+    {
+        return componentCount_;
+    }
+
+    inline size_t ConnectedComponents::find(Parents& parents, size_t node)
+    {
+        size_t parent = parents[node].load(std::memory_order_relaxed);
+        while (parent != node)
+        {
+            size_t grandParent = parents[parent].load(std::memory_order_relaxed);
+            if (grandParent != parent)
+            {
+                // Path halving; losing the race only means the path stays longer.
+                parents[node].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+            }
+            node = grandParent;
+            parent = parents[node].load(std::memory_order_relaxed);
+        }
+        return node;
+    }
+
+    inline void ConnectedComponents::unite(Parents& parents, size_t nodeA, size_t nodeB)
+    {
+        while (true)
+        {
+            size_t rootA = find(parents, nodeA);
+            size_t rootB = find(parents, nodeB);
+            if (rootA == rootB)
+            {
+                return;
+            }
+            if (rootA < rootB)
+            {
+                std::swap(rootA, rootB);
+            }
+
+            // Fails when rootA stopped being a root in the meantime, then both roots are found again.
+            size_t expected = rootA;
+            if (parents[rootA].compare_exchange_strong(expected, rootB, std::memory_order_relaxed))
+            {
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <libds/amt/network.h>
+#include <libds/amt/compressed_network.h>
+#include <libds/amt/explicit_network.h>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace ds::graph {
+
+    /**
+     * @brief Index based view of a network used by the graph algorithms.
+     *
+     * Nodes are numbered 0 ... nodeCount() - 1 in gate order and the neighbours of node i are the indices
+     * accessNeighbours(i)[0] ... accessNeighbours(i)[degree(i) - 1], so algorithms touch plain arrays instead of
+     * calling accessNodeFromNode for every relation. A compressed network is viewed without copying,
+     * an explicit network is frozen and any other network is converted through the Network interface.
+     * Relations of ds::amt networks are symmetric, so every relation is visible from both of its nodes.
+     */
+    template<typename DataType>
+    class GraphView
+    {
+    public:
+        using NetworkType = amt::CompressedNetwork<DataType>;
+
+        explicit GraphView(const NetworkType& network);
+
+        template<typename BlockType, typename GateType>
+        explicit GraphView(const amt::ExplicitNetwork<BlockType, GateType>& network);
+
+        template<typename BlockType>
+        explicit GraphView(const amt::Network<BlockType>& network);
+
+        GraphView(const GraphView& other) = delete;
+
+        size_t nodeCount() const;
+        size_t relationCount() const;
+        size_t degree(size_t node) const;
+        const size_t* accessNeighbours(size_t node) const;
+        const DataType& accessData(size_t node) const;
+
+        const NetworkType& getNetwork() const;
+
+    private:
+        template<typename BlockType>
+        static NetworkType convert(const amt::Network<BlockType>& network);
+
+        void bind(const NetworkType& network);
+
+    private:
+        NetworkType owned_;
+        const NetworkType* network_;
+        const size_t* offsets_;
+        const size_t* neighbours_;
+        size_t nodeCount_;
+    };
+
+    //----------
+
+    template<typename DataType>
+    GraphView<DataType>::GraphView(const NetworkType& network)
+    {
+        this->bind(network);
+    }
+
+    template<typename DataType>
+    template<typename BlockType, typename GateType>
+    GraphView<DataType>::GraphView(const amt::ExplicitNetwork<BlockType, GateType>& network) :
+        owned_(network.freeze())
+    {
+        this->bind(owned_);
+    }
+
+    template<typename DataType>
+    template<typename BlockType>
+    GraphView<DataType>::GraphView(const amt::Network<BlockType>& network) :
+        owned_(convert(network))
+    {
+        this->bind(owned_);
+    }
+
+    template<typename DataType>
+    size_t GraphView<DataType>::nodeCount() const
+    {
+        return nodeCount_;
+    }
+
+    template<typename DataType>
+    size_t GraphView<DataType>::relationCount() const
+    {
+        return offsets_[nodeCount_];
+    }
+
+    template<typename DataType>
+    size_t GraphView<DataType>::degree(size_t node) const
+    {
+        return offsets_[node + 1] - offsets_[node];
+    }
+
+    template<typename DataType>
+    const size_t* GraphView<DataType>::accessNeighbours(size_t node) const
+    {
+        return neighbours_ + offsets_[node];
+    }
+
+    template<typename DataType>
+    const DataType& GraphView<DataType>::accessData(size_t node) const
+    {
+        return network_->accessNodes()[node].data_;
+    }
+
+    template<typename DataType>
+    auto GraphView<DataType>::getNetwork() const -> const NetworkType&
+    {
+        return *network_;
+    }
+
+    template<typename DataType>
+    template<typename BlockType>
+    auto GraphView<DataType>::convert(const amt::Network<BlockType>& network) -> NetworkType
+    {
+        using LookupItem = std::pair<const BlockType*, size_t>;
+
+        const size_t nodeCount = network.size();
+        std::vector<LookupItem> lookup;
+        lookup.reserve(nodeCount);
+        for (size_t i = 0; i < nodeCount; ++i)
+        {
+            lookup.emplace_back(network.accessNodeFromGate(i), i);
+        }
+        auto byAddress = [](const LookupItem& a, const LookupItem& b)
+            {
+                return std::less<const BlockType*>()(a.first, b.first);
+            };
+        std::sort(lookup.begin(), lookup.end(), byAddress);
+
+        NetworkType result(nodeCount, network.relationCount());
+        typename NetworkType::BlockType* nodes = result.accessNodes();
+        size_t* offsets = result.accessOffsets();
+        size_t* neighbours = result.accessNeighbours();
+        size_t position = 0;
+        for (size_t i = 0; i < nodeCount; ++i)
+        {
+            const BlockType* node = network.accessNodeFromGate(i);
+            nodes[i].data_ = node->data_;
+            offsets[i] = position;
+            const size_t degree = network.degree(*node);
+            for (size_t order = 0; order < degree; ++order)
+            {
+                const LookupItem key(network.accessNodeFromNode(*node, order), 0);
+                neighbours[position++] = std::lower_bound(lookup.begin(), lookup.end(), key, byAddress)->second;
+            }
+            std::sort(neighbours + offsets[i], neighbours + position);
+        }
+        offsets[nodeCount] = position;
+
+        return result;
+    }
+
+    template<typename DataType>
+    void GraphView<DataType>::bind(const NetworkType& network)
+    {
+        network_ = &network;
+        offsets_ = network.accessOffsets();
+        neighbours_ = network.accessNeighbours();
+        nodeCount_ = network.size();
+    }
+}
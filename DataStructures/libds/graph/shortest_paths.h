@@ -0,0 +1,205 @@
+#pragma once
+
+#include <libds/graph/graph_view.h>
+#include <libds/exec/thread_pool.h>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ds::graph {
+
+    /**
+     * @brief Parallel single-source shortest paths by delta-stepping (Meyer and Sanders).
+     *
+     * Tentative distances are kept in buckets of width delta. Nodes of the current bucket relax their light
+     * relations (weight <= delta) in parallel until the bucket stays empty, then all nodes settled in the bucket
+     * relax their heavy relations once. Distances are lowered by an atomic minimum, relaxation requests are
+     * sorted into buckets after every parallel phase.
+     *
+     * Relations of ds::amt networks carry no data, so the weight of a relation is computed from the data of its
+     * nodes by weight(const DataType& from, const DataType& to), which must be non-negative.
+     * Weights are evaluated once per relation before the search.
+     */
+    class DeltaSteppingShortestPaths
+    {
+    public:
+        explicit DeltaSteppingShortestPaths(double delta, exec::ThreadPool& pool = exec::ThreadPool::getDefault());
+
+        /**
+         * @return Distance of every node from source in gate order, UNREACHED for nodes not connected to source.
+         */
+        template<typename DataType, typename Weight>
+        std::vector<double> run(const GraphView<DataType>& graph, size_t source, Weight weight);
+
+        static constexpr double UNREACHED = std::numeric_limits<double>::infinity();
+        static constexpr size_t GRAIN_SIZE = 256;
+
+    private:
+        using Distances = std::unique_ptr<std::atomic<double>[]>;
+        using Request = std::pair<size_t, size_t>;
+
+        /**
+         * @brief Relaxes relations of the given nodes whose weight is light (or heavy) and sorts improved nodes into buckets.
+         */
+        template<typename DataType>
+        void relax(const GraphView<DataType>& graph, const std::vector<double>& weights, Distances& distances,
+                   const std::vector<size_t>& nodes, bool light, std::vector<std::vector<size_t>>& buckets);
+
+        static bool lowerDistance(std::atomic<double>& distance, double candidate);
+
+    private:
+        exec::ThreadPool* pool_;
+        double delta_;
+    };
+
+    //----------
+
+    inline DeltaSteppingShortestPaths::DeltaSteppingShortestPaths(double delta, exec::ThreadPool& pool) :
+        pool_(&pool),
+        delta_(delta)
+    {
+        if (!(delta > 0))
+        {
+            throw std::invalid_argument("Delta must be positive!");
+        }
+    }
+
+    template<typename DataType, typename Weight>
+    std::vector<double> DeltaSteppingShortestPaths::run(const GraphView<DataType>& graph, size_t source, Weight weight)
+    {
+        const size_t nodeCount = graph.nodeCount();
+        if (source >= nodeCount)
+        {
+            throw std::out_of_range("Source node does not exist!");
+        }
+
+        std::vector<double> weights(graph.relationCount());
+        pool_->parallelFor(0, nodeCount, GRAIN_SIZE, [&](size_t node)
+            {
+                const size_t* neighbours = graph.accessNeighbours(node);
+                double* nodeWeights = weights.data() + (neighbours - graph.accessNeighbours(0));
+                const size_t degree = graph.degree(node);
+                for (size_t k = 0; k < degree; ++k)
+                {
+                    nodeWeights[k] = weight(graph.accessData(node), graph.accessData(neighbours[k]));
+                }
+            });
+
+        Distances distances(new std::atomic<double>[nodeCount]);
+        pool_->parallelFor(0, nodeCount, GRAIN_SIZE * 4, [&distances](size_t i)
+            {
+                distances[i].store(UNREACHED, std::memory_order_relaxed);
+            });
+        distances[source].store(0.0, std::memory_order_relaxed);
+
+        // relaxedAt[v] is the distance v had when its relations were last relaxed; stale bucket entries are skipped.
+        std::vector<double> relaxedAt(nodeCount, UNREACHED);
+        std::vector<std::vector<size_t>> buckets(1);
+        buckets[0].push_back(source);
+
+        std::vector<size_t> frontier;
+        std::vector<size_t> settled;
+        for (size_t bucket = 0; bucket < buckets.size(); ++bucket)
+        {
+            settled.clear();
+            while (!buckets[bucket].empty())
+            {
+                frontier.clear();
+                for (size_t node : buckets[bucket])
+                {
+                    const double distance = distances[node].load(std::memory_order_relaxed);
+                    if (distance < relaxedAt[node])
+                    {
+                        if (relaxedAt[node] == UNREACHED)
+                        {
+                            settled.push_back(node);
+                        }
+                        relaxedAt[node] = distance;
+                        frontier.push_back(node);
+                    }
+                }
+                buckets[bucket].clear();
+                this->relax(graph, weights, distances, frontier, true, buckets);
+            }
+            this->relax(graph, weights, distances, settled, false, buckets);
+        }
+
+        std::vector<double> result(nodeCount);
+        for (size_t i = 0; i < nodeCount; ++i)
+        {
+            result[i] = distances[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    template<typename DataType>
+    void DeltaSteppingShortestPaths::relax(const GraphView<DataType>& graph, const std::vector<double>& weights, Distances& distances,
+                                           const std::vector<size_t>& nodes, bool light, std::vector<std::vector<size_t>>& buckets)
+    {
+        const size_t blockCount = (nodes.size() + GRAIN_SIZE - 1) / GRAIN_SIZE;
+        std::vector<std::vector<Request>> requests(blockCount);
+        const size_t* firstNeighbour = graph.nodeCount() > 0 ? graph.accessNeighbours(0) : nullptr;
+
+        pool_->parallelFor(0, blockCount, 1, [&](size_t block)
+            {
+                std::vector<Request>& blockRequests = requests[block];
+                const size_t last = std::min(nodes.size(), (block + 1) * GRAIN_SIZE);
+                for (size_t n = block * GRAIN_SIZE; n < last; ++n)
+                {
+                    const size_t node = nodes[n];
+                    const double distance = distances[node].load(std::memory_order_relaxed);
+                    const size_t* neighbours = graph.accessNeighbours(node);
+                    const double* nodeWeights = weights.data() + (neighbours - firstNeighbour);
+                    const size_t degree = graph.degree(node);
+                    for (size_t k = 0; k < degree; ++k)
+                    {
+                        if ((nodeWeights[k] <= delta_) != light)
+                        {
+                            continue;
+                        }
+
+                        const double candidate = distance + nodeWeights[k];
+                        if (lowerDistance(distances[neighbours[k]], candidate))
+                        {
+                            blockRequests.emplace_back(static_cast<size_t>(candidate / delta_), neighbours[k]);
+                        }
+                    }
+                }
+            });
+
+        for (const std::vector<Request>& blockRequests : requests)
+        {
+            for (const Request& request : blockRequests)
+            {
+                // Only the request that produced the final distance of this phase is kept.
+                const double distance = distances[request.second].load(std::memory_order_relaxed);
+                if (static_cast<size_t>(distance / delta_) != request.first)
+                {
+                    continue;
+                }
+                if (request.first >= buckets.size())
+                {
+                    buckets.resize(request.first + 1);
+                }
+                buckets[request.first].push_back(request.second);
+            }
+        }
+    }
+
+    inline bool DeltaSteppingShortestPaths::lowerDistance(std::atomic<double>& distance, double candidate)
+    {
+        double current = distance.load(std::memory_order_relaxed);
+        while (candidate < current)
+        {
+            if (distance.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <new>
+#include <utility>
+
 /**
  * @brief Creates default-constructed object at @p address.
  */
@@ -18,6 +21,66 @@ T* placement_copy(T* address, const T& origin)
 	return new (address) T(origin);
 }
 
+/**
+ * @brief Creates object constructed from @p args at @p address.
+ */
+template<typename T, typename... Args>
+T* placement_emplace(T* address, Args&&... args)
+{
+	return new (address) T(std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Replaces the object living at @p address with the object returned by @p factory, which is created
+ * right at @p address. If the factory throws, a default-constructed object is left at @p address.
+ */
+template<typename T, typename Factory>
+T* placement_recreate(T* address, const Factory& factory)
+{
+	address->~T();
+	try
+	{
+		return new (address) T(factory());
+	}
+	catch (...)
+	{
+		new (address) T();
+		throw;
+	}
+}
+
+/**
+ * @brief Allocates uninitialised memory for an object of type T. Once an object lives there, it is released by delete.
+ */
+template<typename T>
+T* allocate_storage()
+{
+	if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+	{
+		return static_cast<T*>(::operator new(sizeof(T), std::align_val_t(alignof(T))));
+	}
+	else
+	{
+		return static_cast<T*>(::operator new(sizeof(T)));
+	}
+}
+
+/**
+ * @brief Releases memory returned by allocate_storage in which no object lives.
+ */
+template<typename T>
+void release_storage(T* address)
+{
+	if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+	{
+		::operator delete(static_cast<void*>(address), std::align_val_t(alignof(T)));
+	}
+	else
+	{
+		::operator delete(static_cast<void*>(address));
+	}
+}
+
 /**
  * @brief Explicitly calls destructor of the object living at @p address.
  */
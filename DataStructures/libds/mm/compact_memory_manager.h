@@ -22,6 +22,13 @@ namespace ds::mm {
 
         BlockType* allocateMemory() override;
         BlockType* allocateMemoryAt(size_t index);
+
+        /**
+         * @brief Allocates a block at @p index constructed from @p args directly in its memory.
+         */
+        template<typename... Args>
+        BlockType* emplaceMemoryAt(size_t index, Args&&... args);
+
         void releaseMemory(BlockType* pointer) override;
         void releaseMemoryAt(size_t index);
         void releaseMemory();
@@ -40,10 +47,24 @@ namespace ds::mm {
 
         void print(std::ostream& os);
 
+    protected:
+        BlockType* allocateStorage() override;
+        void releaseStorage(BlockType* pointer) override;
+
     private:
         size_t getAllocatedBlocksSize() const;
         size_t getAllocatedCapacitySize() const;
 
+        /**
+         * @brief Makes room for a block at @p index by moving the following blocks one position forward.
+         */
+        BlockType* reserveAt(size_t index);
+
+        /**
+         * @brief Closes the room at @p index, in which no block lives, by moving the following blocks back.
+         */
+        void unreserveAt(size_t index);
+
     private:
         BlockType* base_;
         BlockType* end_;
@@ -93,6 +114,40 @@ namespace ds::mm {
 
     template<typename BlockType>
     BlockType* CompactMemoryManager<BlockType>::allocateMemoryAt(size_t index)
+    {
+        return placement_new(this->reserveAt(index));
+    }
+
+    template<typename BlockType>
+    template<typename... Args>
+    BlockType* CompactMemoryManager<BlockType>::emplaceMemoryAt(size_t index, Args&&... args)
+    {
+        BlockType* storage = this->reserveAt(index);
+        try
+        {
+            return placement_emplace(storage, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            this->unreserveAt(index);
+            throw;
+        }
+    }
+
+    template<typename BlockType>
+    BlockType* CompactMemoryManager<BlockType>::allocateStorage()
+    {
+        return this->reserveAt(static_cast<size_t>(end_ - base_));
+    }
+
+    template<typename BlockType>
+    void CompactMemoryManager<BlockType>::releaseStorage(BlockType* pointer)
+    {
+        this->unreserveAt(static_cast<size_t>(pointer - base_));
+    }
+
+    template<typename BlockType>
+    BlockType* CompactMemoryManager<BlockType>::reserveAt(size_t index)
     {
         if (end_ == limit_)
         {
@@ -111,7 +166,19 @@ namespace ds::mm {
         ++MemoryManager<BlockType>::allocatedBlockCount_;
         ++end_;
 
-        return placement_new(base_ + index);
+        return base_ + index;
+    }
+
+    template<typename BlockType>
+    void CompactMemoryManager<BlockType>::unreserveAt(size_t index)
+    {
+        std::memmove(
+                base_ + index,
+                base_ + index + 1,
+                (end_ - base_ - index - 1) * sizeof(BlockType)
+        );
+        --end_;
+        --this->allocatedBlockCount_;
     }
 
     template<typename BlockType>
@@ -132,13 +199,7 @@ namespace ds::mm {
     void CompactMemoryManager<BlockType>::releaseMemoryAt(size_t index)
     {
         destroy(&this->getBlockAt(index));
-        std::memmove(
-                base_ + index,
-                base_ + index + 1,
-                (end_ - base_ - index - 1) * sizeof(BlockType)
-        );
-        --end_;
-        --this->allocatedBlockCount_;
+        this->unreserveAt(index);
     }
 
     template<typename BlockType>
@@ -162,7 +223,8 @@ namespace ds::mm {
             this->releaseMemory(base_);
             this->allocatedBlockCount_ = other.MemoryManager<BlockType>::allocatedBlockCount_;
             void* newBase = std::realloc(base_, other.getAllocatedCapacitySize());
-            if (newBase == nullptr)
+            // realloc may return nullptr for zero capacity, which is not a failure.
+            if (newBase == nullptr && other.getAllocatedCapacitySize() > 0)
             {
                 throw std::bad_alloc();
             }
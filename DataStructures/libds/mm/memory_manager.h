@@ -1,6 +1,7 @@
 #pragma once
 
 #include <libds/heap_monitor.h>
+#include <utility>
 
 namespace ds::mm {
 
@@ -14,10 +15,27 @@ namespace ds::mm {
 		virtual BlockType* allocateMemory();
 		virtual void releaseMemory(BlockType* pointer);
 
+		/**
+		 * @brief Allocates a block constructed from @p args directly in its memory.
+		 */
+		template<typename... Args>
+		BlockType* emplaceMemory(Args&&... args);
+
 		void releaseAndSetNull(BlockType*& pointer);
 
 		size_t getAllocatedBlockCount() const;
 
+	protected:
+		/**
+		 * @brief Allocates memory of a block without constructing the block. The block is counted as allocated.
+		 */
+		virtual BlockType* allocateStorage();
+
+		/**
+		 * @brief Takes back memory returned by allocateStorage in which no block was constructed.
+		 */
+		virtual void releaseStorage(BlockType* pointer);
+
 	protected:
 		size_t allocatedBlockCount_;
 	};
@@ -48,6 +66,36 @@ namespace ds::mm {
 		delete pointer;
 	}
 
+	template<typename BlockType>
+	template<typename... Args>
+    BlockType* MemoryManager<BlockType>::emplaceMemory(Args&&... args)
+	{
+		BlockType* storage = this->allocateStorage();
+		try
+		{
+			return placement_emplace(storage, std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			this->releaseStorage(storage);
+			throw;
+		}
+	}
+
+	template<typename BlockType>
+    BlockType* MemoryManager<BlockType>::allocateStorage()
+	{
+		allocatedBlockCount_++;
+		return allocate_storage<BlockType>();
+	}
+
+	template<typename BlockType>
+    void MemoryManager<BlockType>::releaseStorage(BlockType* pointer)
+	{
+		allocatedBlockCount_--;
+		release_storage(pointer);
+	}
+
 	template<typename BlockType>
     void MemoryManager<BlockType>::releaseAndSetNull(BlockType*& pointer)
 	{
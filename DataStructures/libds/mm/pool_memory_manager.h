@@ -0,0 +1,133 @@
+#pragma once
+
+#include <libds/mm/memory_manager.h>
+#include <libds/heap_monitor.h>
+#include <cstddef>
+
+namespace ds::mm {
+
+    /**
+     * @brief Memory manager that carves blocks out of chunks of CHUNK_SIZE blocks.
+     *
+     * A chunk is allocated only when all previously allocated chunks are used up, so creating a block normally
+     * costs no heap allocation at all. Released blocks are destroyed and kept in a free list, the next allocation
+     * reuses the most recently released one. Memory of chunks is returned to the heap when the manager is destroyed.
+     * Blocks that were not released until then are not destroyed.
+     */
+    template<typename BlockType>
+    class PoolMemoryManager : public MemoryManager<BlockType> {
+    public:
+        PoolMemoryManager();
+        PoolMemoryManager(const PoolMemoryManager<BlockType>& other) = delete;
+        ~PoolMemoryManager() override;
+
+        BlockType* allocateMemory() override;
+        void releaseMemory(BlockType* pointer) override;
+
+        /**
+         * @return Number of blocks that fit into all allocated chunks.
+         */
+        size_t getCapacity() const;
+
+        static const size_t CHUNK_SIZE = 256;
+
+    protected:
+        BlockType* allocateStorage() override;
+        void releaseStorage(BlockType* pointer) override;
+
+    private:
+        union Slot
+        {
+            Slot* nextFree_;
+            alignas(BlockType) unsigned char storage_[sizeof(BlockType)];
+        };
+
+        struct Chunk
+        {
+            Chunk* previous_;
+            Slot slots_[CHUNK_SIZE];
+        };
+
+    private:
+        Chunk* lastChunk_;
+        size_t usedInLastChunk_;
+        size_t chunkCount_;
+        Slot* firstFree_;
+    };
+
+    template<typename BlockType>
+    PoolMemoryManager<BlockType>::PoolMemoryManager() :
+        lastChunk_(nullptr),
+        usedInLastChunk_(CHUNK_SIZE),
+        chunkCount_(0),
+        firstFree_(nullptr)
+    {
+    }
+
+    template<typename BlockType>
+    PoolMemoryManager<BlockType>::~PoolMemoryManager()
+    {
+        while (lastChunk_ != nullptr)
+        {
+            Chunk* previous = lastChunk_->previous_;
+            delete lastChunk_;
+            lastChunk_ = previous;
+        }
+        usedInLastChunk_ = CHUNK_SIZE;
+        chunkCount_ = 0;
+        firstFree_ = nullptr;
+    }
+
+    template<typename BlockType>
+    BlockType* PoolMemoryManager<BlockType>::allocateMemory()
+    {
+        return placement_new(this->allocateStorage());
+    }
+
+    template<typename BlockType>
+    BlockType* PoolMemoryManager<BlockType>::allocateStorage()
+    {
+        Slot* slot = firstFree_;
+        if (slot != nullptr)
+        {
+            firstFree_ = slot->nextFree_;
+        }
+        else
+        {
+            if (usedInLastChunk_ == CHUNK_SIZE)
+            {
+                Chunk* chunk = new Chunk;
+                chunk->previous_ = lastChunk_;
+                lastChunk_ = chunk;
+                usedInLastChunk_ = 0;
+                ++chunkCount_;
+            }
+            slot = &lastChunk_->slots_[usedInLastChunk_++];
+        }
+
+        ++MemoryManager<BlockType>::allocatedBlockCount_;
+        return reinterpret_cast<BlockType*>(slot->storage_);
+    }
+
+    template<typename BlockType>
+    void PoolMemoryManager<BlockType>::releaseMemory(BlockType* pointer)
+    {
+        destroy(pointer);
+        this->releaseStorage(pointer);
+    }
+
+    template<typename BlockType>
+    void PoolMemoryManager<BlockType>::releaseStorage(BlockType* pointer)
+    {
+        Slot* slot = reinterpret_cast<Slot*>(pointer);
+        slot->nextFree_ = firstFree_;
+        firstFree_ = slot;
+        --MemoryManager<BlockType>::allocatedBlockCount_;
+    }
+
+    template<typename BlockType>
+    size_t PoolMemoryManager<BlockType>::getCapacity() const
+    {
+        return chunkCount_ * CHUNK_SIZE;
+    }
+}
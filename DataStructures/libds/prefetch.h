@@ -0,0 +1,45 @@
+#pragma once
+
+#include <libds/constants.h>
+#include <cstddef>
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace ds
+{
+    /**
+     * @brief Hints the processor to load the cache line containing address. Has no observable effect otherwise,
+     *        the address does not have to be dereferenceable.
+     */
+    inline void prefetch(const void* address)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+        // A prefetch alone lets the compiler treat callers as side-effect free and drop calls to them.
+        __asm__ __volatile__("" : : "r"(address));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+        (void)address;
+#endif
+    }
+
+    /**
+     * @brief Hints the processor to load all cache lines overlapping byteCount bytes starting at address.
+     */
+    inline void prefetchRange(const void* address, size_t byteCount)
+    {
+        const char* first = static_cast<const char*>(address);
+        const char* last = first + byteCount;
+        for (const char* line = first; line < last; line += CACHE_LINE_SIZE)
+        {
+            prefetch(line);
+        }
+        if (byteCount > 0)
+        {
+            prefetch(last - 1);
+        }
+    }
+}
@@ -323,4 +323,74 @@ namespace ds::tests
     {
         *number_ = newNumber;
     }
+
+    int CountingData::copyCount_ = 0;
+    int CountingData::moveCount_ = 0;
+
+    CountingData::CountingData() :
+        number_(0)
+    {
+    }
+
+    CountingData::CountingData(int number, int offset) :
+        number_(number + offset)
+    {
+    }
+
+    CountingData::CountingData(const CountingData& other) :
+        number_(other.number_)
+    {
+        ++copyCount_;
+    }
+
+    CountingData::CountingData(CountingData&& other) noexcept :
+        number_(other.number_)
+    {
+        ++moveCount_;
+    }
+
+    auto CountingData::operator= (const CountingData& other) -> CountingData&
+    {
+        number_ = other.number_;
+        ++copyCount_;
+        return *this;
+    }
+
+    auto CountingData::operator= (CountingData&& other) noexcept -> CountingData&
+    {
+        number_ = other.number_;
+        ++moveCount_;
+        return *this;
+    }
+
+    auto CountingData::operator== (const CountingData& other) const -> bool
+    {
+        return number_ == other.number_;
+    }
+
+    auto CountingData::operator!= (const CountingData& other) const -> bool
+    {
+        return !(*this == other);
+    }
+
+    auto CountingData::get_number() const -> int
+    {
+        return number_;
+    }
+
+    auto CountingData::get_copy_count() -> int
+    {
+        return copyCount_;
+    }
+
+    auto CountingData::get_move_count() -> int
+    {
+        return moveCount_;
+    }
+
+    auto CountingData::reset_counts() -> void
+    {
+        copyCount_ = 0;
+        moveCount_ = 0;
+    }
 }
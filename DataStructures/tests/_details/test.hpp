@@ -542,6 +542,37 @@ namespace ds::tests
         int* number_;
     };
 
+    /**
+     *  \brief Dummy class counting its copies and moves, so tests can check
+     *  that structures construct their elements in place.
+     */
+    class CountingData
+    {
+    public:
+        CountingData();
+        CountingData(int number, int offset);
+        CountingData(const CountingData& other);
+        CountingData(CountingData&& other) noexcept;
+        ~CountingData() = default;
+
+        auto operator= (const CountingData& other) -> CountingData&;
+        auto operator= (CountingData&& other) noexcept -> CountingData&;
+        auto operator== (const CountingData& other) const -> bool;
+        auto operator!= (const CountingData& other) const -> bool;
+
+        auto get_number() const -> int;
+
+        static auto get_copy_count() -> int;
+        static auto get_move_count() -> int;
+        static auto reset_counts() -> void;
+
+    private:
+        int number_;
+
+        static int copyCount_;
+        static int moveCount_;
+    };
+
 // LeafTest:
 
     template<class T>
@@ -2,6 +2,7 @@
 
 #include <tests/_details/test.hpp>
 #include <libds/adt/list.h>
+#include <vector>
 
 namespace ds::tests
 {
@@ -413,10 +414,80 @@ namespace ds::tests
     };
 
     /**
-     * @brief All list leaf tests.
+     * @brief Tests emplacement and insertion of a range.
      * @tparam ListT Type of the list.
      */
     template<class ListT>
+    class ListTestEmplaceInsertRange : public LeafTest
+    {
+    public:
+        ListTestEmplaceInsertRange() :
+            LeafTest("emplace-insertRange")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            ListT list;
+            list.emplaceLast(3);
+            list.emplaceFirst(1);
+            this->assert_equals(2, list.emplace(1, 2));
+            this->assert_throws([&list]()
+                {
+                    list.emplace(10, 0);
+                },
+                "Emplace to invalid index throws."
+            );
+
+            const std::vector<int> range = { 4, 5, 6, 7, 8, 9 };
+            list.insertRange(range.begin(), range.end());
+
+            this->assert_equals(static_cast<size_t>(9), list.size());
+            for (size_t i = 0; i < list.size(); ++i)
+            {
+                this->assert_equals(static_cast<int>(i + 1), list.access(i));
+            }
+        }
+    };
+
+    /**
+     * @brief Tests that emplace constructs the elements right in the list.
+     * @tparam ListT Type of the list of CountingData.
+     */
+    template<class ListT>
+    class ListTestEmplaceInPlace : public LeafTest
+    {
+    public:
+        ListTestEmplaceInPlace() :
+            LeafTest("emplace-in-place")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            ListT list;
+            CountingData::reset_counts();
+            list.emplaceLast(3, 0);
+            list.emplaceFirst(1, 0);
+            this->assert_equals(2, list.emplace(1, 1, 1).get_number());
+
+            this->assert_equals(0, CountingData::get_copy_count(), "Emplace copies nothing.");
+            this->assert_equals(0, CountingData::get_move_count(), "Emplace moves nothing.");
+            for (size_t i = 0; i < list.size(); ++i)
+            {
+                this->assert_equals(static_cast<int>(i + 1), list.access(i).get_number());
+            }
+        }
+    };
+
+    /**
+     * @brief All list leaf tests.
+     * @tparam ListT Type of the list.
+     * @tparam CountingListT The same list of CountingData.
+     */
+    template<class ListT, class CountingListT>
     class GeneralListTest : public CompositeTest
     {
     public:
@@ -434,6 +505,8 @@ namespace ds::tests
             this->add_test(std::make_unique<ListTestIterators<ListT>>());
             this->add_test(std::make_unique<ListTestClear<ListT>>());
             this->add_test(std::make_unique<ListTestCopyAssignEquals<ListT>>());
+            this->add_test(std::make_unique<ListTestEmplaceInsertRange<ListT>>());
+            this->add_test(std::make_unique<ListTestEmplaceInPlace<CountingListT>>());
         }
     };
 
@@ -446,9 +519,9 @@ namespace ds::tests
         ListTest() :
             CompositeTest("List")
         {
-            this->add_test(std::make_unique<GeneralListTest<adt::ImplicitList<int>>>("ImplicitList"));
-            this->add_test(std::make_unique<GeneralListTest<adt::SinglyLinkedList<int>>>("SinglyLinkedList"));
-            this->add_test(std::make_unique<GeneralListTest<adt::DoublyLinkedList<int>>>("DoublyLinkedList"));
+            this->add_test(std::make_unique<GeneralListTest<adt::ImplicitList<int>, adt::ImplicitList<CountingData>>>("ImplicitList"));
+            this->add_test(std::make_unique<GeneralListTest<adt::SinglyLinkedList<int>, adt::SinglyLinkedList<CountingData>>>("SinglyLinkedList"));
+            this->add_test(std::make_unique<GeneralListTest<adt::DoublyLinkedList<int>, adt::DoublyLinkedList<CountingData>>>("DoublyLinkedList"));
         }
     };
 }
\ No newline at end of file
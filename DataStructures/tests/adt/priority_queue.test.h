@@ -351,6 +351,8 @@ namespace ds::tests
             this->add_test(std::make_unique<GeneralPrioQueueTest<adt::SortedImplicitSequencePriorityQueue<int, int>>>("SortedImplicit"));
             this->add_test(std::make_unique<GeneralPrioQueueTest<adt::SortedExplicitSequencePriorityQueue<int, int>>>("SortedExplicit"));
             this->add_test(std::make_unique<GeneralPrioQueueTest<adt::BinaryHeap<int, int>>>("BinaryHeap"));
+            this->add_test(std::make_unique<GeneralPrioQueueTest<adt::BinaryHeap<int, int, amt::EytzingerLayout>>>("BinaryHeap-eytzinger"));
+            this->add_test(std::make_unique<GeneralPrioQueueTest<adt::BinaryHeap<int, int, amt::VanEmdeBoasLayout>>>("BinaryHeap-veb"));
             this->add_test(std::make_unique<TwoListsTest>());
         }
     };
@@ -2,7 +2,11 @@
 
 #include <tests/_details/test.hpp>
 #include <libds/adt/queue.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 namespace ds::tests
 {
@@ -168,10 +172,258 @@ namespace ds::tests
     };
 
     /**
-     * @brief All queue leaf tests.
+     * @brief Tests emplacement and pushing of a range.
      * @tparam QueueT Type of the queue.
      */
     template<class QueueT>
+    class QueueTestEmplacePushRange : public LeafTest
+    {
+    public:
+        QueueTestEmplacePushRange() :
+            LeafTest("emplace-pushRange")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            QueueT queue;
+            queue.emplace(0);
+
+            const std::vector<int> range = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+            queue.pushRange(range.begin(), range.end());
+
+            this->assert_equals(static_cast<size_t>(10), queue.size());
+            for (int i = 0; i < 10; ++i)
+            {
+                this->assert_equals(i, queue.pop());
+            }
+
+            if constexpr (std::is_same_v<QueueT, adt::ImplicitQueue<int>>)
+            {
+                const std::vector<int> tooLong(queue.getCapacity() + 1, 0);
+                this->assert_throws([&queue, &tooLong]()
+                    {
+                        queue.pushRange(tooLong.begin(), tooLong.end());
+                    },
+                    "Range longer than the capacity throws."
+                );
+                this->assert_true(queue.isEmpty(), "Nothing is pushed when the range does not fit.");
+            }
+        }
+    };
+
+    /**
+     * @brief Tests concurrent producers and consumers.
+     * @tparam QueueT Type of the queue.
+     */
+    template<class QueueT>
+    class QueueTestConcurrentTransfer : public LeafTest
+    {
+    public:
+        QueueTestConcurrentTransfer() :
+            LeafTest("concurrent-transfer")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            constexpr int threadCount = 4;
+            constexpr long long n = 10'000;
+
+            QueueT queue(64);
+            std::atomic<long long> sum(0);
+            std::atomic<long long> popped(0);
+            std::vector<std::thread> threads;
+
+            for (int t = 0; t < threadCount; ++t)
+            {
+                threads.emplace_back([&queue]()
+                    {
+                        for (long long i = 1; i <= n; ++i)
+                        {
+                            while (!queue.tryPush(i))
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+                    });
+                threads.emplace_back([&queue, &sum, &popped]()
+                    {
+                        long long value = 0;
+                        while (popped.load() < threadCount * n)
+                        {
+                            if (queue.tryPop(value))
+                            {
+                                sum += value;
+                                ++popped;
+                            }
+                            else
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+                    });
+            }
+
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            this->assert_equals(threadCount * n, popped.load());
+            this->assert_equals(threadCount * (n * (n + 1) / 2), sum.load());
+            this->assert_true(queue.isEmpty(), "Queue is empty.");
+        }
+    };
+
+    /**
+     * @brief One producer and one consumer move a sequence through the queue in batches.
+     * @tparam QueueT Type of the queue.
+     */
+    template<class QueueT>
+    class QueueTestBatchTransfer : public LeafTest
+    {
+    public:
+        QueueTestBatchTransfer() :
+            LeafTest("batch-transfer")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            constexpr long long n = 100'000;
+            constexpr size_t pushBatchSize = 37;
+            constexpr size_t popBatchSize = 50;
+
+            QueueT queue(64);
+            std::thread producer([&queue]()
+                {
+                    std::vector<long long> batch(pushBatchSize);
+                    long long next = 1;
+                    while (next <= n)
+                    {
+                        size_t count = 0;
+                        while (count < pushBatchSize && next + static_cast<long long>(count) <= n)
+                        {
+                            batch[count] = next + static_cast<long long>(count);
+                            ++count;
+                        }
+                        size_t pushed = 0;
+                        while (pushed < count)
+                        {
+                            pushed += queue.pushBatch(batch.data() + pushed, count - pushed);
+                        }
+                        next += static_cast<long long>(count);
+                    }
+                });
+
+            std::vector<long long> buffer(popBatchSize);
+            long long expected = 1;
+            bool inOrder = true;
+            while (expected <= n)
+            {
+                const size_t popped = queue.popBatch(buffer.data(), popBatchSize);
+                for (size_t i = 0; i < popped; ++i)
+                {
+                    inOrder = inOrder && buffer[i] == expected;
+                    ++expected;
+                }
+            }
+            producer.join();
+
+            this->assert_true(inOrder, "Elements are popped in the order they were pushed.");
+            this->assert_equals(n + 1, expected);
+            this->assert_true(queue.isEmpty(), "Queue is empty.");
+        }
+    };
+
+    /**
+     * @brief Tests that an element whose construction throws is not pushed.
+     * @tparam QueueT Type of the queue.
+     */
+    template<class QueueT>
+    class QueueTestEmplaceThrows : public LeafTest
+    {
+    public:
+        QueueTestEmplaceThrows() :
+            LeafTest("emplace-throws")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            struct ThrowingNumber
+            {
+                operator int() const { throw std::runtime_error("Number can not be created."); }
+            };
+
+            QueueT queue;
+            queue.push(1);
+            this->assert_throws([&queue]()
+                {
+                    queue.emplace(ThrowingNumber());
+                },
+                "Exception of the construction is propagated."
+            );
+            this->assert_equals(static_cast<size_t>(1), queue.size(), "Element that was not constructed is not pushed.");
+            queue.push(2);
+            this->assert_equals(1, queue.pop());
+            this->assert_equals(2, queue.pop());
+            this->assert_true(queue.isEmpty(), "Queue is empty.");
+        }
+    };
+
+    /**
+     * @brief Tests that emplace constructs the elements right in the queue.
+     * @tparam QueueT Type of the queue of CountingData.
+     */
+    template<class QueueT>
+    class QueueTestEmplaceInPlace : public LeafTest
+    {
+    public:
+        QueueTestEmplaceInPlace() :
+            LeafTest("emplace-in-place")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            constexpr int n = 10;
+
+            QueueT queue;
+            CountingData::reset_counts();
+            for (int i = 0; i < n; ++i)
+            {
+                queue.emplace(i, 1);
+            }
+
+            this->assert_equals(0, CountingData::get_copy_count(), "Emplace copies nothing.");
+            if constexpr (std::is_same_v<QueueT, adt::ConcurrentBoundedQueue<CountingData>>)
+            {
+                this->assert_equals(n, CountingData::get_move_count(), "Element created before its slot is claimed is moved once.");
+            }
+            else
+            {
+                this->assert_equals(0, CountingData::get_move_count(), "Emplace moves nothing.");
+            }
+            for (int i = 0; i < n; ++i)
+            {
+                this->assert_equals(i + 1, queue.pop().get_number());
+            }
+        }
+    };
+
+    /**
+     * @brief All queue leaf tests.
+     * @tparam QueueT Type of the queue.
+     * @tparam CountingQueueT The same queue of CountingData.
+     */
+    template<class QueueT, class CountingQueueT>
     class GeneralQueueTest : public CompositeTest
     {
     public:
@@ -182,6 +434,17 @@ namespace ds::tests
             this->add_test(std::make_unique<QueueTestPop<QueueT>>());
             this->add_test(std::make_unique<QueueTestClear<QueueT>>());
             this->add_test(std::make_unique<QueueTestCopyAssignEquals<QueueT>>());
+            this->add_test(std::make_unique<QueueTestEmplacePushRange<QueueT>>());
+            this->add_test(std::make_unique<QueueTestEmplaceThrows<QueueT>>());
+            this->add_test(std::make_unique<QueueTestEmplaceInPlace<CountingQueueT>>());
+            if constexpr (std::is_same_v<QueueT, adt::ConcurrentBoundedQueue<int>>)
+            {
+                this->add_test(std::make_unique<QueueTestConcurrentTransfer<adt::ConcurrentBoundedQueue<long long>>>());
+            }
+            if constexpr (std::is_same_v<QueueT, adt::SpscRingQueue<int>>)
+            {
+                this->add_test(std::make_unique<QueueTestBatchTransfer<adt::SpscRingQueue<long long>>>());
+            }
         }
     };
 
@@ -194,8 +457,11 @@ namespace ds::tests
         QueueTest() :
             CompositeTest("Queue")
         {
-            this->add_test(std::make_unique<GeneralQueueTest<adt::ImplicitQueue<int>>>("ImplicitQueue"));
-            this->add_test(std::make_unique<GeneralQueueTest<adt::ExplicitQueue<int>>>("ExplicitQueue"));
+            this->add_test(std::make_unique<GeneralQueueTest<adt::ImplicitQueue<int>, adt::ImplicitQueue<CountingData>>>("ImplicitQueue"));
+            this->add_test(std::make_unique<GeneralQueueTest<adt::ExplicitQueue<int>, adt::ExplicitQueue<CountingData>>>("ExplicitQueue"));
+            this->add_test(std::make_unique<GeneralQueueTest<adt::ChunkedQueue<int, 4>, adt::ChunkedQueue<CountingData, 4>>>("ChunkedQueue"));
+            this->add_test(std::make_unique<GeneralQueueTest<adt::ConcurrentBoundedQueue<int>, adt::ConcurrentBoundedQueue<CountingData>>>("ConcurrentBoundedQueue"));
+            this->add_test(std::make_unique<GeneralQueueTest<adt::SpscRingQueue<int>, adt::SpscRingQueue<CountingData>>>("SpscRingQueue"));
         }
     };
 }
\ No newline at end of file
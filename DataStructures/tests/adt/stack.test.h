@@ -2,6 +2,7 @@
 
 #include <tests/_details/test.hpp>
 #include <libds/adt/stack.h>
+#include <vector>
 
 namespace ds::tests
 {
@@ -152,10 +153,75 @@ namespace ds::tests
     };
 
     /**
-     * @brief All stack leaf tests.
+     * @brief Tests emplacement and pushing of a range.
      * @tparam StackT Type of the stack.
      */
     template<class StackT>
+    class StackTestEmplacePushRange : public LeafTest
+    {
+    public:
+        StackTestEmplacePushRange() :
+            LeafTest("emplace-pushRange")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            StackT stack;
+            stack.emplace(0);
+
+            const std::vector<int> range = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+            stack.pushRange(range.begin(), range.end());
+
+            this->assert_equals(static_cast<size_t>(10), stack.size());
+            for (int i = 9; i >= 0; --i)
+            {
+                this->assert_equals(i, stack.pop());
+            }
+        }
+    };
+
+    /**
+     * @brief Tests that emplace constructs the elements right in the stack.
+     * @tparam StackT Type of the stack of CountingData.
+     */
+    template<class StackT>
+    class StackTestEmplaceInPlace : public LeafTest
+    {
+    public:
+        StackTestEmplaceInPlace() :
+            LeafTest("emplace-in-place")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            constexpr int n = 10;
+
+            StackT stack;
+            CountingData::reset_counts();
+            for (int i = 0; i < n; ++i)
+            {
+                stack.emplace(i, 1);
+            }
+
+            this->assert_equals(0, CountingData::get_copy_count(), "Emplace copies nothing.");
+            this->assert_equals(0, CountingData::get_move_count(), "Emplace moves nothing.");
+            for (int i = n - 1; i >= 0; --i)
+            {
+                this->assert_equals(i + 1, stack.pop().get_number());
+            }
+        }
+    };
+
+    /**
+     * @brief All stack leaf tests.
+     * @tparam StackT Type of the stack.
+     * @tparam CountingStackT The same stack of CountingData.
+     */
+    template<class StackT, class CountingStackT>
     class GeneralStackTest : public CompositeTest
     {
     public:
@@ -166,6 +232,8 @@ namespace ds::tests
             this->add_test(std::make_unique<StackTestPop<StackT>>());
             this->add_test(std::make_unique<StackTestClear<StackT>>());
             this->add_test(std::make_unique<StackTestCopyAssignEquals<StackT>>());
+            this->add_test(std::make_unique<StackTestEmplacePushRange<StackT>>());
+            this->add_test(std::make_unique<StackTestEmplaceInPlace<CountingStackT>>());
         }
     };
 
@@ -178,8 +246,9 @@ namespace ds::tests
         StackTest() :
             CompositeTest("Stack")
         {
-            this->add_test(std::make_unique<GeneralStackTest<adt::ImplicitStack<int>>>("ImplicitStack"));
-            this->add_test(std::make_unique<GeneralStackTest<adt::ExplicitStack<int>>>("ExplicitStack"));
+            this->add_test(std::make_unique<GeneralStackTest<adt::ImplicitStack<int>, adt::ImplicitStack<CountingData>>>("ImplicitStack"));
+            this->add_test(std::make_unique<GeneralStackTest<adt::ExplicitStack<int>, adt::ExplicitStack<CountingData>>>("ExplicitStack"));
+            this->add_test(std::make_unique<GeneralStackTest<adt::ChunkedStack<int, 4>, adt::ChunkedStack<CountingData, 4>>>("ChunkedStack"));
         }
     };
 }
\ No newline at end of file
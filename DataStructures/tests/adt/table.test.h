@@ -4,6 +4,7 @@
 #include <libds/adt/table.h>
 #include <memory>
 #include <random>
+#include <type_traits>
 #include <unordered_set>
 #include <tests/_details/test.hpp>
 
@@ -479,11 +480,47 @@ namespace ds::tests
         }
     };
 
+    /**
+     * @brief Tests that emplace constructs the items right in the table.
+     * @tparam TableT Type of the table of CountingData.
+     */
+    template<class TableT>
+    class TableTestEmplaceInPlace : public LeafTest
+    {
+    public:
+        TableTestEmplaceInPlace() :
+            LeafTest("emplace-in-place")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            const std::vector<int> keys = { 5, 2, 8, 1, 9, 3, 7, 4, 6, 0 };
+
+            TableT table;
+            CountingData::reset_counts();
+            for (const int key : keys)
+            {
+                table.emplace(key, key, 1);
+            }
+
+            this->assert_equals(0, CountingData::get_copy_count(), "Emplace copies nothing.");
+            this->assert_equals(0, CountingData::get_move_count(), "Emplace moves nothing.");
+            this->assert_equals(keys.size(), table.size());
+            for (const int key : keys)
+            {
+                this->assert_equals(key + 1, table.find(key).get_number());
+            }
+        }
+    };
+
     /**
      * @brief All table leaf tests
      * @tparam TableT table ty[e
+     * @tparam CountingTableT the same table of CountingData, void to skip emplace-in-place
      */
-    template<class TableT>
+    template<class TableT, class CountingTableT = void>
     class GeneralTableTest : public CompositeTest
     {
     public:
@@ -498,6 +535,10 @@ namespace ds::tests
             this->add_test(std::make_unique<TableTestIterator<TableT>>());
             this->add_test(std::make_unique<TableTestEquals<TableT>>());
             this->add_test(std::make_unique<TableTestScenario<TableT>>());
+            if constexpr (!std::is_void_v<CountingTableT>)
+            {
+                this->add_test(std::make_unique<TableTestEmplaceInPlace<CountingTableT>>());
+            }
         }
     };
 
@@ -510,9 +551,9 @@ namespace ds::tests
         SequenceTableTest() :
             CompositeTest("SequenceTable")
         {
-            this->add_test(std::make_unique<GeneralTableTest<adt::UnsortedImplicitSequenceTable<int, int>>>("UnsortedImplicitSequenceTable"));
-            this->add_test(std::make_unique<GeneralTableTest<adt::UnsortedExplicitSequenceTable<int, int>>>("UnsortedExplicitSequenceTable"));
-            this->add_test(std::make_unique<GeneralTableTest<adt::SortedSequenceTable<int, int>>>("SortedSequenceTable"));
+            this->add_test(std::make_unique<GeneralTableTest<adt::UnsortedImplicitSequenceTable<int, int>, adt::UnsortedImplicitSequenceTable<int, CountingData>>>("UnsortedImplicitSequenceTable"));
+            this->add_test(std::make_unique<GeneralTableTest<adt::UnsortedExplicitSequenceTable<int, int>, adt::UnsortedExplicitSequenceTable<int, CountingData>>>("UnsortedExplicitSequenceTable"));
+            this->add_test(std::make_unique<GeneralTableTest<adt::SortedSequenceTable<int, int>, adt::SortedSequenceTable<int, CountingData>>>("SortedSequenceTable"));
         }
     };
 
@@ -526,8 +567,8 @@ namespace ds::tests
             CompositeTest("NonSequenceTable")
         {
             this->add_test(std::make_unique<GeneralTableTest<adt::HashTable<int, int>>>("HashTable"));
-            this->add_test(std::make_unique<GeneralTableTest<adt::BinarySearchTree<int, int>>>("BinarySearchTree"));
-            this->add_test(std::make_unique<GeneralTableTest<adt::Treap<int, int>>>("Treap"));
+            this->add_test(std::make_unique<GeneralTableTest<adt::BinarySearchTree<int, int>, adt::BinarySearchTree<int, CountingData>>>("BinarySearchTree"));
+            this->add_test(std::make_unique<GeneralTableTest<adt::Treap<int, int>, adt::Treap<int, CountingData>>>("Treap"));
         }
     };
 
@@ -540,12 +581,12 @@ namespace ds::tests
         TableTest() :
             CompositeTest("Table")
         {
-            this->add_test(std::make_unique<GeneralTableTest<adt::UnsortedImplicitSequenceTable<int, int>>>("UnsortedImplicitSequenceTable"));
-            this->add_test(std::make_unique<GeneralTableTest<adt::UnsortedExplicitSequenceTable<int, int>>>("UnsortedExplicitSequenceTable"));
-            this->add_test(std::make_unique<GeneralTableTest<adt::SortedSequenceTable<int, int>>>("SortedSequenceTable"));
+            this->add_test(std::make_unique<GeneralTableTest<adt::UnsortedImplicitSequenceTable<int, int>, adt::UnsortedImplicitSequenceTable<int, CountingData>>>("UnsortedImplicitSequenceTable"));
+            this->add_test(std::make_unique<GeneralTableTest<adt::UnsortedExplicitSequenceTable<int, int>, adt::UnsortedExplicitSequenceTable<int, CountingData>>>("UnsortedExplicitSequenceTable"));
+            this->add_test(std::make_unique<GeneralTableTest<adt::SortedSequenceTable<int, int>, adt::SortedSequenceTable<int, CountingData>>>("SortedSequenceTable"));
             this->add_test(std::make_unique<GeneralTableTest<adt::HashTable<int, int>>>("HashTable"));
-            this->add_test(std::make_unique<GeneralTableTest<adt::BinarySearchTree<int, int>>>("BinarySearchTree"));
-            this->add_test(std::make_unique<GeneralTableTest<adt::Treap<int, int>>>("Treap"));
+            this->add_test(std::make_unique<GeneralTableTest<adt::BinarySearchTree<int, int>, adt::BinarySearchTree<int, CountingData>>>("BinarySearchTree"));
+            this->add_test(std::make_unique<GeneralTableTest<adt::Treap<int, int>, adt::Treap<int, CountingData>>>("Treap"));
         }
     };
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <tests/amt/implicit_hierarchy.test.h>
 #include <tests/amt/explicit_hierarchy.test.h>
 #include <tests/amt/hierarchy.test.h>
+#include <tests/amt/network.test.h>
 #include <memory>
 
 namespace ds::tests
@@ -21,6 +22,7 @@ namespace ds::tests
             this->add_test(std::make_unique<ImplicitHierarchyTest>());
             this->add_test(std::make_unique<ExplicitHierarchyTest>());
             this->add_test(std::make_unique<HierarchyTest>());
+            this->add_test(std::make_unique<NetworkTest>());
         }
     };
 }
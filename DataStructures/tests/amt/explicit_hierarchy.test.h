@@ -3,6 +3,8 @@
 #include <libds/amt/explicit_hierarchy.h>
 #include <tests/_details/test.hpp>
 #include <tests/amt/hierarchy.test.h>
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <type_traits>
 
@@ -523,6 +525,330 @@ namespace ds::tests
         }
     };
 
+    /**
+     * @brief Tests insertion and removal of sons beyond the inline capacity of a block.
+     */
+    class PMWEHTestInsertRemove : public LeafTest
+    {
+    public:
+        PMWEHTestInsertRemove() :
+            LeafTest("insert-remove")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            using HierarchyType = amt::PooledMultiWayExplicitHierarchy<int>;
+            constexpr int sonCount = 20;
+
+            HierarchyType hierarchy;
+            auto& root = hierarchy.emplaceRoot();
+            for (int i = sonCount - 1; i >= 0; i -= 2)
+            {
+                hierarchy.emplaceSon(root, 0).data_ = i;
+            }
+            for (int i = 0; i < sonCount; i += 2)
+            {
+                hierarchy.emplaceSon(root, static_cast<size_t>(i)).data_ = i;
+            }
+            this->assert_equals(static_cast<size_t>(sonCount), hierarchy.degree(root));
+            this->assert_equals(static_cast<size_t>(sonCount + 1), hierarchy.size());
+
+            bool ordered = true;
+            for (int i = 0; i < sonCount; ++i)
+            {
+                auto* son = hierarchy.accessSon(root, static_cast<size_t>(i));
+                ordered = ordered && son->data_ == i && hierarchy.accessParent(*son) == &root;
+            }
+            this->assert_true(ordered, "Sons are in order.");
+            this->assert_null(hierarchy.accessSon(root, sonCount));
+
+            hierarchy.emplaceSon(*hierarchy.accessSon(root, 3), 0).data_ = 30;
+            hierarchy.removeSon(root, 3);
+            hierarchy.removeSon(root, 0);
+            this->assert_equals(static_cast<size_t>(sonCount - 2), hierarchy.degree(root));
+            this->assert_equals(1, hierarchy.accessSon(root, 0)->data_);
+            this->assert_equals(4, hierarchy.accessSon(root, 2)->data_);
+            this->assert_equals(static_cast<size_t>(sonCount - 1), hierarchy.size());
+            this->assert_throws([&hierarchy, &root]() { hierarchy.emplaceSon(root, sonCount); });
+        }
+    };
+
+    /**
+     * @brief Tests copy constructor, assign and equals against the sequence based multi-way hierarchy.
+     */
+    class PMWEHTestCopyAssignEquals : public LeafTest
+    {
+    public:
+        PMWEHTestCopyAssignEquals() :
+            LeafTest("copy-assign-equals")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            auto fixture = details::makePMWEH();
+            auto& hierarchy1 = *fixture.hierarchy_;
+            auto& root1 = *hierarchy1.accessRoot();
+
+            auto hierarchy2(hierarchy1);
+            this->assert_true(hierarchy1.equals(hierarchy2), "Copy constructed hierarchy is the same.");
+            hierarchy1.removeSon(root1, 1);
+            this->assert_false(hierarchy1.equals(hierarchy2), "Modified copy is different.");
+
+            amt::PooledMultiWayExplicitHierarchy<int> hierarchy3;
+            hierarchy3.assign(hierarchy2);
+            hierarchy3.removeSon(*hierarchy3.accessRoot(), 1);
+            this->assert_true(hierarchy1.equals(hierarchy3), "Assigned hierarchy is the same.");
+
+            hierarchy3.clear();
+            this->assert_true(hierarchy3.isEmpty(), "Cleared hierarchy is empty.");
+            this->assert_equals(static_cast<size_t>(0), hierarchy3.size());
+        }
+    };
+
+    namespace details
+    {
+        struct MinMaxAggregate
+        {
+            struct ValueType
+            {
+                int min_;
+                int max_;
+            };
+
+            static ValueType identity() { return { (std::numeric_limits<int>::max)(), (std::numeric_limits<int>::min)() }; }
+            static ValueType of(const int& data) { return { data, data }; }
+            static ValueType combine(const ValueType& a, const ValueType& b) { return { (std::min)(a.min_, b.min_), (std::max)(a.max_, b.max_) }; }
+        };
+    }
+
+    /**
+     * @brief Tests cached depths, subtree sizes and aggregates when sons are emplaced, moved and removed.
+     */
+    class PMWEHTestAggregates : public LeafTest
+    {
+    public:
+        PMWEHTestAggregates() :
+            LeafTest("cached-aggregates")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            using HierarchyType = amt::PooledMultiWayEH<int, details::MinMaxAggregate>;
+            //        5
+            //      /   \
+            //     3     8
+            //     |     |
+            //     1     10
+            HierarchyType hierarchy;
+            auto& root = hierarchy.emplaceRoot();
+            root.data_ = 5;
+            hierarchy.refresh(root);
+            auto& three = hierarchy.emplaceSon(root, 0);
+            three.data_ = 3;
+            hierarchy.refresh(three);
+            auto& eight = hierarchy.emplaceSon(root, 1);
+            eight.data_ = 8;
+            hierarchy.refresh(eight);
+            auto& one = hierarchy.emplaceSon(three, 0);
+            one.data_ = 1;
+            hierarchy.refresh(one);
+            auto& ten = hierarchy.emplaceSon(eight, 0);
+            ten.data_ = 10;
+            hierarchy.refresh(ten);
+
+            this->assert_equals(static_cast<size_t>(5), hierarchy.size());
+            this->assert_equals(static_cast<size_t>(2), hierarchy.nodeCount(three));
+            this->assert_equals(static_cast<size_t>(2), hierarchy.level(ten));
+            this->assert_equals(1, hierarchy.aggregate(root).min_);
+            this->assert_equals(10, hierarchy.aggregate(root).max_);
+            this->assert_equals(8, hierarchy.aggregate(eight).min_);
+
+            ten.data_ = 4;
+            hierarchy.refresh(ten);
+            this->assert_equals(8, hierarchy.aggregate(root).max_);
+            this->assert_equals(4, hierarchy.aggregate(eight).min_);
+
+            // Moves the subtree of 8 below 1, the son it replaces is moved to the place of 8.
+            hierarchy.changeSon(root, 1, nullptr);
+            this->assert_equals(static_cast<size_t>(3), hierarchy.size());
+            this->assert_equals(5, hierarchy.aggregate(root).max_);
+            auto& placeholder = hierarchy.emplaceSon(one, 0);
+            placeholder.data_ = 7;
+            hierarchy.changeSon(one, 0, &eight);
+            hierarchy.changeSon(root, 1, &placeholder);
+            hierarchy.refresh(placeholder);
+            this->assert_equals(static_cast<size_t>(6), hierarchy.size());
+            this->assert_equals(static_cast<size_t>(3), hierarchy.level(eight));
+            this->assert_equals(static_cast<size_t>(4), hierarchy.level(ten));
+            this->assert_equals(static_cast<size_t>(1), hierarchy.level(placeholder));
+            this->assert_equals(static_cast<size_t>(4), hierarchy.nodeCount(three));
+            this->assert_equals(8, hierarchy.aggregate(three).max_);
+
+            HierarchyType copy(hierarchy);
+            this->assert_equals(static_cast<size_t>(6), copy.size());
+            this->assert_equals(1, copy.aggregate(*copy.accessRoot()).min_);
+            this->assert_equals(8, copy.aggregate(*copy.accessRoot()).max_);
+
+            hierarchy.removeSon(root, 0);
+            this->assert_equals(static_cast<size_t>(2), hierarchy.size());
+            this->assert_equals(5, hierarchy.aggregate(root).min_);
+            this->assert_equals(7, hierarchy.aggregate(root).max_);
+        }
+    };
+
+    /**
+     * @brief Tests that aggregates deferred while emplacing and changing nodes are correct once resumed.
+     */
+    class PMWEHTestDeferredAggregates : public LeafTest
+    {
+    public:
+        PMWEHTestDeferredAggregates() :
+            LeafTest("deferred-aggregates")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            using HierarchyType = amt::PooledMultiWayEH<int, details::MinMaxAggregate>;
+            HierarchyType hierarchy;
+            hierarchy.deferAggregates();
+            auto& root = hierarchy.emplaceRoot();
+            root.data_ = 50;
+            for (int i = 0; i < 10; ++i)
+            {
+                auto& son = hierarchy.emplaceSon(root, hierarchy.degree(root));
+                son.data_ = 40 + i;
+                for (int j = 0; j < 10; ++j)
+                {
+                    auto& grandson = hierarchy.emplaceSon(son, j);
+                    grandson.data_ = 10 * i + j;
+                    hierarchy.refresh(grandson);
+                }
+            }
+            this->assert_equals(static_cast<size_t>(111), hierarchy.size());
+            this->assert_equals(static_cast<size_t>(11), hierarchy.nodeCount(*hierarchy.accessSon(root, 3)));
+
+            hierarchy.resumeAggregates();
+            this->assert_equals(0, hierarchy.aggregate(root).min_);
+            this->assert_equals(99, hierarchy.aggregate(root).max_);
+            this->assert_equals(30, hierarchy.aggregate(*hierarchy.accessSon(root, 3)).min_);
+            this->assert_equals(43, hierarchy.aggregate(*hierarchy.accessSon(root, 3)).max_);
+
+            auto& last = *hierarchy.accessSon(*hierarchy.accessSon(root, 9), 9);
+            last.data_ = 100;
+            hierarchy.refresh(last);
+            this->assert_equals(100, hierarchy.aggregate(root).max_);
+
+            HierarchyType copy(hierarchy);
+            this->assert_equals(100, copy.aggregate(*copy.accessRoot()).max_);
+            copy.removeSon(*copy.accessRoot(), 9);
+            this->assert_equals(89, copy.aggregate(*copy.accessRoot()).max_);
+        }
+    };
+
+    /**
+     * @brief All PooledMultiwayExplicitHierarchy tests.
+     */
+    class PooledMultiwayExplicitHierarchyTest : public CompositeTest
+    {
+    public:
+        PooledMultiwayExplicitHierarchyTest() :
+            CompositeTest("PooledMultiwayExplicitHierarchy")
+        {
+            this->add_test(std::make_unique<PMWEHTestInsertRemove>());
+            this->add_test(std::make_unique<PMWEHTestCopyAssignEquals>());
+            this->add_test(std::make_unique<PMWEHTestAggregates>());
+            this->add_test(std::make_unique<PMWEHTestDeferredAggregates>());
+        }
+    };
+
+    /**
+     * @brief Tests sons of an inline K-way hierarchy at orders spread over the whole range of K.
+     */
+    template<size_t K>
+    class IKWEHTestSons : public LeafTest
+    {
+    public:
+        explicit IKWEHTestSons(const std::string& name) :
+            LeafTest(name)
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            using HierarchyType = amt::InlineKWayExplicitHierarchy<int, K>;
+            const size_t step = K > 4 ? 3 : 1;
+
+            HierarchyType hierarchy;
+            auto& root = hierarchy.emplaceRoot();
+            // Descending orders, so every son of a sparse block is inserted before all present ones.
+            size_t sonCount = 0;
+            for (size_t order = (K - 1) / step * step; order != static_cast<size_t>(-step); order -= step)
+            {
+                hierarchy.emplaceSon(root, order).data_ = static_cast<int>(order);
+                ++sonCount;
+            }
+            this->assert_equals(sonCount, hierarchy.degree(root));
+            this->assert_equals(sonCount + 1, hierarchy.size());
+
+            bool sonsMatch = true;
+            for (size_t order = 0; order < K; ++order)
+            {
+                auto* son = hierarchy.accessSon(root, order);
+                sonsMatch = sonsMatch && (order % step == 0
+                    ? son != nullptr && son->data_ == static_cast<int>(order) && hierarchy.accessParent(*son) == &root
+                    : son == nullptr);
+            }
+            this->assert_true(sonsMatch, "Sons are at their orders.");
+            this->assert_null(hierarchy.accessSon(root, K));
+            this->assert_throws([&hierarchy, &root]() { hierarchy.emplaceSon(root, K); });
+            this->assert_throws([&hierarchy, &root]() { hierarchy.emplaceSon(root, 0); });
+
+            auto& grandson = hierarchy.emplaceSon(*hierarchy.accessSon(root, 0), K - 1);
+            grandson.data_ = -1;
+            HierarchyType copy(hierarchy);
+            this->assert_true(copy.equals(hierarchy), "Copy is the same.");
+
+            hierarchy.removeSon(root, 0);
+            this->assert_equals(sonCount - 1, hierarchy.degree(root));
+            this->assert_equals(sonCount, hierarchy.size());
+            this->assert_null(hierarchy.accessSon(root, 0));
+            this->assert_false(copy.equals(hierarchy), "Modified hierarchy is different.");
+
+            auto* last = hierarchy.accessSon(root, (K - 1) / step * step);
+            hierarchy.changeSon(root, (K - 1) / step * step, nullptr);
+            this->assert_equals(sonCount - 2, hierarchy.degree(root));
+            this->assert_null(hierarchy.accessParent(*last));
+            hierarchy.changeSon(root, 1, last);
+            this->assert_equals(last, hierarchy.accessSon(root, 1));
+            this->assert_equals(&root, hierarchy.accessParent(*last));
+            this->assert_equals(sonCount - 1, hierarchy.degree(root));
+        }
+    };
+
+    /**
+     * @brief All InlineKWayExplicitHierarchy tests.
+     */
+    class InlineKWayExplicitHierarchyTest : public CompositeTest
+    {
+    public:
+        InlineKWayExplicitHierarchyTest() :
+            CompositeTest("InlineKWayExplicitHierarchy")
+        {
+            this->add_test(std::make_unique<IKWEHTestSons<2>>("sons-2"));
+            this->add_test(std::make_unique<IKWEHTestSons<16>>("sons-16"));
+            this->add_test(std::make_unique<IKWEHTestSons<256>>("sons-256"));
+        }
+    };
+
     /**
      * @brief All ExplicitHierarchy tests.
      */
@@ -534,6 +860,8 @@ namespace ds::tests
         {
             this->add_test(std::make_unique<MultiwayExplicitHierarchyTest>());
             this->add_test(std::make_unique<KWayExplicitHierarchyTest>());
+            this->add_test(std::make_unique<PooledMultiwayExplicitHierarchyTest>());
+            this->add_test(std::make_unique<InlineKWayExplicitHierarchyTest>());
         }
     };
 }
@@ -3,7 +3,12 @@
 #include <tests/_details/test.hpp>
 #include <libds/amt/implicit_hierarchy.h>
 #include <libds/amt/explicit_hierarchy.h>
+#include <libds/exec/parallel_hierarchy.h>
+#include <algorithm>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <type_traits>
 #include <vector>
 
 namespace ds::tests
@@ -50,6 +55,75 @@ namespace ds::tests
             };
         };
 
+        /**
+         *  Same shape as makeMWEH.
+         */
+        inline auto const makePMWEH = []()-> HierarchyFixture<amt::PooledMultiWayExplicitHierarchy<int>>
+        {
+            auto hierarchy = std::make_unique<amt::PooledMultiWayExplicitHierarchy<int>>();
+            auto& root = hierarchy->emplaceRoot();
+            auto& two = hierarchy->emplaceSon(root, 0);
+            auto& one = hierarchy->emplaceSon(root, 0);
+            root.data_ = 0;
+            one.data_ = 1;
+            two.data_ = 2;
+            hierarchy->emplaceSon(one, 0).data_ = 5;
+            hierarchy->emplaceSon(one, 0).data_ = 3;
+            hierarchy->emplaceSon(one, 1).data_ = 4;
+            hierarchy->emplaceSon(two, 0).data_ = 6;
+            return
+            {
+                std::move(hierarchy),
+                {0, 1, 3, 4, 5, 2, 6},
+                {3, 4, 5, 1, 6, 2, 0},
+                {0, 1, 2, 3, 4, 5, 6},
+                {}
+            };
+        };
+
+        /**
+         *  0
+         *  | \
+         *  1  2
+         *     | \
+         *     3  4
+         *        ...
+         *        | \
+         *        77 78
+         *        |
+         *        79
+         *
+         *  Deeper than the inline path of depth-first iterators.
+         */
+        inline auto const makeDeepPMWEH = []()-> HierarchyFixture<amt::PooledMultiWayExplicitHierarchy<int>>
+        {
+            const int chainLength = 40;
+            auto hierarchy = std::make_unique<amt::PooledMultiWayExplicitHierarchy<int>>();
+            HierarchyFixture<amt::PooledMultiWayExplicitHierarchy<int>> fixture;
+
+            auto* node = &hierarchy->emplaceRoot();
+            for (int i = 0; i < chainLength; ++i)
+            {
+                node->data_ = 2 * i;
+                hierarchy->emplaceSon(*node, 0).data_ = 2 * i + 1;
+                if (i + 1 < chainLength)
+                {
+                    node = &hierarchy->emplaceSon(*node, 1);
+                }
+
+                fixture.preOrder_.push_back(2 * i);
+                fixture.preOrder_.push_back(2 * i + 1);
+                fixture.postOrder_.push_back(2 * i + 1);
+            }
+            for (int i = chainLength - 1; i >= 0; --i)
+            {
+                fixture.postOrder_.push_back(2 * i);
+            }
+            fixture.levelOrder_ = fixture.preOrder_;
+            fixture.hierarchy_ = std::move(hierarchy);
+            return fixture;
+        };
+
         /**
          *         0
          *    /    |    \
@@ -79,6 +153,32 @@ namespace ds::tests
             };
         };
 
+        /**
+         *  Same shape as makeKWEH, sons with order 1 have order K / 2 and sons with order 2 have order K - 1.
+         */
+        template<size_t K>
+        HierarchyFixture<amt::InlineKWayExplicitHierarchy<int, K>> makeInlineKWEH()
+        {
+            auto hierarchy = std::make_unique<amt::InlineKWayExplicitHierarchy<int, K>>();
+            auto& root = hierarchy->emplaceRoot();
+            auto& two = hierarchy->emplaceSon(root, K - 1);
+            auto& one = hierarchy->emplaceSon(root, 0);
+            root.data_ = 0;
+            one.data_ = 1;
+            two.data_ = 2;
+            hierarchy->emplaceSon(one, K - 1).data_ = 4;
+            hierarchy->emplaceSon(one, 0).data_ = 3;
+            hierarchy->emplaceSon(two, K / 2).data_ = 5;
+            return
+            {
+                std::move(hierarchy),
+                {0, 1, 3, 4, 2, 5},
+                {3, 4, 1, 5, 2, 0},
+                {0, 1, 2, 3, 4, 5},
+                {}
+            };
+        }
+
         /*         10
          *    /          \
          *    5          15
@@ -229,6 +329,112 @@ namespace ds::tests
         MakeFixtureType makeFixture_;
     };
 
+    /**
+     *  @brief Tests parallel level-order traversal with one node per task.
+     */
+    template<class MakeFixtureType>
+    class HierarchyTestParallelLevelOrder : public LeafTest
+    {
+    public:
+        HierarchyTestParallelLevelOrder(MakeFixtureType makeFixture, const std::string& name) :
+            LeafTest(name),
+            makeFixture_(std::move(makeFixture))
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            const auto fixture = makeFixture_();
+            const auto& hierarchy = fixture.hierarchy_;
+            using BlockType = std::remove_pointer_t<decltype(hierarchy->accessRoot())>;
+
+            std::mutex mutex;
+            std::vector<int> visited;
+            std::vector<size_t> levels;
+            exec::parallelLevelOrder(*hierarchy, hierarchy->accessRoot(), [&](BlockType* node)
+                {
+                    const size_t level = hierarchy->level(*node);
+                    std::lock_guard<std::mutex> lock(mutex);
+                    visited.push_back(node->data_);
+                    levels.push_back(level);
+                }, 1);
+
+            this->assert_true(std::is_sorted(levels.begin(), levels.end()), "Levels are visited one after another.");
+            std::vector<int> expected = fixture.levelOrder_;
+            std::sort(expected.begin(), expected.end());
+            std::sort(visited.begin(), visited.end());
+            this->assert_true(expected == visited, "Every node is visited once.");
+
+            amt::LevelOrderTraversal<BlockType> traversal(*hierarchy);
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                std::vector<int> order;
+                traversal.process(hierarchy->accessRoot(), [&order](BlockType* node)
+                    {
+                        order.push_back(node->data_);
+                    });
+                this->assert_true(order == fixture.levelOrder_, "Reused traversal keeps level order.");
+            }
+        }
+
+    private:
+        MakeFixtureType makeFixture_;
+    };
+
+    /**
+     *  @brief Tests parallel pre-order traversal and reduction with a fork after every visited node.
+     */
+    template<class MakeFixtureType>
+    class HierarchyTestParallelPreOrder : public LeafTest
+    {
+    public:
+        HierarchyTestParallelPreOrder(MakeFixtureType makeFixture, const std::string& name) :
+            LeafTest(name),
+            makeFixture_(std::move(makeFixture))
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            const auto fixture = makeFixture_();
+            const auto& hierarchy = fixture.hierarchy_;
+            using BlockType = std::remove_pointer_t<decltype(hierarchy->accessRoot())>;
+
+            std::mutex mutex;
+            std::vector<int> visited;
+            exec::parallelProcessPreOrder(*hierarchy, hierarchy->accessRoot(), [&](const BlockType* node)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    visited.push_back(node->data_);
+                }, 1);
+
+            std::vector<int> expected = fixture.preOrder_;
+            std::sort(expected.begin(), expected.end());
+            std::sort(visited.begin(), visited.end());
+            this->assert_true(expected == visited, "Every node is visited once.");
+
+            auto data = [](const BlockType* node) { return node->data_; };
+            for (const size_t grainSize : {size_t(1), size_t(1024)})
+            {
+                const int sum = exec::parallelReduce(*hierarchy, hierarchy->accessRoot(), data,
+                    [](int left, int right) { return left + right; }, grainSize);
+                const int max = exec::parallelReduce(*hierarchy, hierarchy->accessRoot(), data,
+                    [](int left, int right) { return std::max(left, right); }, grainSize);
+                this->assert_equals(std::accumulate(expected.begin(), expected.end(), 0), sum);
+                this->assert_equals(expected.back(), max);
+            }
+
+            const size_t count = exec::parallelReduce(*hierarchy, static_cast<const BlockType*>(nullptr),
+                [](const BlockType*) { return size_t(1); }, [](size_t left, size_t right) { return left + right; });
+            this->assert_equals(size_t(0), count);
+        }
+
+    private:
+        MakeFixtureType makeFixture_;
+    };
+
     /**
      *  @brief Tests pre-order iterator.
      */
@@ -363,6 +569,62 @@ namespace ds::tests
         MakeFixture makeFixture_;
     };
 
+    /**
+     *  @brief Tests that copied and assigned iterators continue independently from the same position.
+     */
+    template<class MakeFixtureType>
+    class HierarchyTestIteratorCopy : public LeafTest
+    {
+    public:
+        HierarchyTestIteratorCopy(MakeFixtureType makeFixture, const std::string& name) :
+            LeafTest(name),
+            makeFixture_(std::move(makeFixture))
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            auto fixture = makeFixture_();
+            auto& hierarchy = fixture.hierarchy_;
+            const size_t half = fixture.preOrder_.size() / 2;
+
+            auto hierarchyIt = hierarchy->beginPre();
+            for (size_t i = 0; i < half; ++i)
+            {
+                ++hierarchyIt;
+            }
+
+            auto copyIt = hierarchyIt;
+            auto assignedIt = hierarchy->endPre();
+            assignedIt = hierarchyIt;
+            this->assert_true(copyIt == hierarchyIt && assignedIt == hierarchyIt, "Copies start at the same position.");
+
+            bool same = true;
+            for (size_t i = half; i < fixture.preOrder_.size(); ++i)
+            {
+                same = same && *hierarchyIt == fixture.preOrder_[i] && *copyIt == fixture.preOrder_[i] && *assignedIt == fixture.preOrder_[i];
+                ++hierarchyIt;
+                ++copyIt;
+                ++assignedIt;
+            }
+            this->assert_true(same, "Copies visit the remaining nodes.");
+            this->assert_equals(hierarchy->endPre(), copyIt);
+            this->assert_equals(hierarchy->endPre(), assignedIt);
+
+            auto postIt = hierarchy->beginPost();
+            this->assert_equals(fixture.postOrder_[0], *postIt);
+            auto postCopyIt = postIt;
+            ++postIt;
+            ++postCopyIt;
+            this->assert_equals(fixture.postOrder_[1], *postIt);
+            this->assert_equals(fixture.postOrder_[1], *postCopyIt);
+        }
+
+    private:
+        MakeFixtureType makeFixture_;
+    };
+
     /**
      *  @brief Test for processing elements in various orders.
      */
@@ -374,28 +636,54 @@ namespace ds::tests
         {
             using MakeKWEHType = decltype(details::makeKWEH);
             using MakeMWEHType = decltype(details::makeMWEH);
+            using MakePMWEHType = decltype(details::makePMWEH);
+            using MakeDeepPMWEHType = decltype(details::makeDeepPMWEH);
             using MakeBIHType = decltype(details::makeBIH);
             using MakeBEHType = decltype(details::makeBEH);
+            using MakeDenseIKWEHType = decltype(&details::makeInlineKWEH<3>);
+            using MakeSparseIKWEHType = decltype(&details::makeInlineKWEH<256>);
 
             this->add_test(std::make_unique<HierarchyTestProcessPreOrder<MakeKWEHType>>(details::makeKWEH, "process-pre-order-kweh"));
             this->add_test(std::make_unique<HierarchyTestProcessPreOrder<MakeMWEHType>>(details::makeMWEH, "process-pre-order-mweh"));
+            this->add_test(std::make_unique<HierarchyTestProcessPreOrder<MakePMWEHType>>(details::makePMWEH, "process-pre-order-pmweh"));
             this->add_test(std::make_unique<HierarchyTestProcessPreOrder<MakeBIHType>>(details::makeBIH, "process-pre-order-bih"));
             this->add_test(std::make_unique<HierarchyTestProcessPostOrder<MakeKWEHType>>(details::makeKWEH, "process-post-order-kweh"));
             this->add_test(std::make_unique<HierarchyTestProcessPostOrder<MakeMWEHType>>(details::makeMWEH, "process-post-order-mweh"));
+            this->add_test(std::make_unique<HierarchyTestProcessPostOrder<MakePMWEHType>>(details::makePMWEH, "process-post-order-pmweh"));
             this->add_test(std::make_unique<HierarchyTestProcessPostOrder<MakeBIHType>>(details::makeBIH, "process-post-order-bih"));
             this->add_test(std::make_unique<HierarchyTestProcessLevelOrder<MakeKWEHType>>(details::makeKWEH, "process-level-order-kweh"));
             this->add_test(std::make_unique<HierarchyTestProcessLevelOrder<MakeMWEHType>>(details::makeMWEH, "process-level-order-mweh"));
+            this->add_test(std::make_unique<HierarchyTestProcessLevelOrder<MakePMWEHType>>(details::makePMWEH, "process-level-order-pmweh"));
             this->add_test(std::make_unique<HierarchyTestProcessLevelOrder<MakeBIHType>>(details::makeBIH, "process-level-order-bih"));
             this->add_test(std::make_unique<HierarchyTestPreOrderIterator<MakeKWEHType>>(details::makeKWEH, "pre-order-iterator-kweh"));
             this->add_test(std::make_unique<HierarchyTestPreOrderIterator<MakeMWEHType>>(details::makeMWEH, "pre-order-iterator-mweh"));
+            this->add_test(std::make_unique<HierarchyTestPreOrderIterator<MakePMWEHType>>(details::makePMWEH, "pre-order-iterator-pmweh"));
             this->add_test(std::make_unique<HierarchyTestPreOrderIterator<MakeBIHType>>(details::makeBIH, "pre-order-iterator-bih"));
             this->add_test(std::make_unique<HierarchyTestPostOrderIterator<MakeKWEHType>>(details::makeKWEH, "post-order-iterator-kweh"));
             this->add_test(std::make_unique<HierarchyTestPostOrderIterator<MakeMWEHType>>(details::makeMWEH, "post-order-iterator-mweh"));
+            this->add_test(std::make_unique<HierarchyTestPostOrderIterator<MakePMWEHType>>(details::makePMWEH, "post-order-iterator-pmweh"));
             this->add_test(std::make_unique<HierarchyTestPostOrderIterator<MakeBIHType>>(details::makeBIH, "post-order-iterator-bih"));
             this->add_test(std::make_unique<BinaryHierarchyTestProcessInOrder<MakeBIHType>>(details::makeBIH, "process-in-order-bih"));
             this->add_test(std::make_unique<BinaryHierarchyTestProcessInOrder<MakeBEHType>>(details::makeBEH, "process-in-order-beh"));
             this->add_test(std::make_unique<BinaryHierarchyTestInOrderIterator<MakeBIHType>>(details::makeBIH, "in-order-iterator-bih"));
             this->add_test(std::make_unique<BinaryHierarchyTestInOrderIterator<MakeBEHType>>(details::makeBEH, "in-order-iterator-beh"));
+            this->add_test(std::make_unique<HierarchyTestProcessPostOrder<MakeDeepPMWEHType>>(details::makeDeepPMWEH, "process-post-order-deep"));
+            this->add_test(std::make_unique<HierarchyTestPreOrderIterator<MakeDeepPMWEHType>>(details::makeDeepPMWEH, "pre-order-iterator-deep"));
+            this->add_test(std::make_unique<HierarchyTestPostOrderIterator<MakeDeepPMWEHType>>(details::makeDeepPMWEH, "post-order-iterator-deep"));
+            this->add_test(std::make_unique<HierarchyTestParallelLevelOrder<MakeKWEHType>>(details::makeKWEH, "parallel-level-order-kweh"));
+            this->add_test(std::make_unique<HierarchyTestParallelLevelOrder<MakeMWEHType>>(details::makeMWEH, "parallel-level-order-mweh"));
+            this->add_test(std::make_unique<HierarchyTestParallelLevelOrder<MakeBIHType>>(details::makeBIH, "parallel-level-order-bih"));
+            this->add_test(std::make_unique<HierarchyTestParallelLevelOrder<MakeDeepPMWEHType>>(details::makeDeepPMWEH, "parallel-level-order-deep"));
+            this->add_test(std::make_unique<HierarchyTestParallelPreOrder<MakeKWEHType>>(details::makeKWEH, "parallel-pre-order-kweh"));
+            this->add_test(std::make_unique<HierarchyTestParallelPreOrder<MakeMWEHType>>(details::makeMWEH, "parallel-pre-order-mweh"));
+            this->add_test(std::make_unique<HierarchyTestParallelPreOrder<MakeBIHType>>(details::makeBIH, "parallel-pre-order-bih"));
+            this->add_test(std::make_unique<HierarchyTestParallelPreOrder<MakeDeepPMWEHType>>(details::makeDeepPMWEH, "parallel-pre-order-deep"));
+            this->add_test(std::make_unique<HierarchyTestProcessPreOrder<MakeDenseIKWEHType>>(&details::makeInlineKWEH<3>, "process-pre-order-ikweh"));
+            this->add_test(std::make_unique<HierarchyTestProcessPostOrder<MakeSparseIKWEHType>>(&details::makeInlineKWEH<256>, "process-post-order-ikweh-sparse"));
+            this->add_test(std::make_unique<HierarchyTestProcessLevelOrder<MakeSparseIKWEHType>>(&details::makeInlineKWEH<256>, "process-level-order-ikweh-sparse"));
+            this->add_test(std::make_unique<HierarchyTestPreOrderIterator<MakeSparseIKWEHType>>(&details::makeInlineKWEH<256>, "pre-order-iterator-ikweh-sparse"));
+            this->add_test(std::make_unique<HierarchyTestIteratorCopy<MakeMWEHType>>(details::makeMWEH, "iterator-copy-mweh"));
+            this->add_test(std::make_unique<HierarchyTestIteratorCopy<MakeDeepPMWEHType>>(details::makeDeepPMWEH, "iterator-copy-deep"));
         }
     };
 }
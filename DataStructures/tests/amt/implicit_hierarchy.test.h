@@ -3,6 +3,7 @@
 #include <libds/amt/implicit_hierarchy.h>
 #include <tests/_details/test.hpp>
 #include <memory>
+#include <vector>
 
 namespace ds::tests
 {
@@ -245,6 +246,134 @@ namespace ds::tests
         }
     };
 
+    /**
+     *  @brief Tests that a hierarchy with the given layout behaves as the breadth-first one.
+     */
+    template<typename Layout>
+    class ImplicitHierarchyTestLayout : public LeafTest
+    {
+    public:
+        explicit ImplicitHierarchyTestLayout(const std::string& name) :
+            LeafTest(name)
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            constexpr int n = 100;
+            amt::ImplicitHierarchy<int, 3, Layout> hierarchy;
+            for (int i = 0; i < n; ++i)
+            {
+                hierarchy.insertLastLeaf().data_ = i;
+            }
+            this->assert_equals(static_cast<size_t>(n), hierarchy.size());
+            this->assert_equals(static_cast<size_t>(n), hierarchy.nodeCount(*hierarchy.accessRoot()));
+            this->assert_equals(0, hierarchy.accessRoot()->data_);
+
+            bool linksMatch = true;
+            std::vector<amt::MemoryBlock<int>*> level = { hierarchy.accessRoot() };
+            while (!level.empty())
+            {
+                std::vector<amt::MemoryBlock<int>*> nextLevel;
+                for (auto* node : level)
+                {
+                    for (size_t order = 0; order < 3; ++order)
+                    {
+                        const int expected = 3 * node->data_ + static_cast<int>(order) + 1;
+                        auto* son = hierarchy.accessSon(*node, order);
+                        if (expected < n)
+                        {
+                            linksMatch = linksMatch && son != nullptr && son->data_ == expected && hierarchy.accessParent(*son) == node;
+                            nextLevel.push_back(son);
+                        }
+                        else
+                        {
+                            linksMatch = linksMatch && son == nullptr;
+                        }
+                    }
+                }
+                level = std::move(nextLevel);
+            }
+            this->assert_true(linksMatch, "Sons and parents follow breadth-first indices.");
+
+            auto* lastLeaf = hierarchy.accessLastLeaf();
+            this->assert_equals(n - 1, lastLeaf->data_);
+            this->assert_equals(static_cast<size_t>(4), hierarchy.level(*lastLeaf));
+            this->assert_equals(static_cast<size_t>(3), hierarchy.degree(*hierarchy.accessParent(*lastLeaf)));
+
+            auto copy(hierarchy);
+            this->assert_true(copy.equals(hierarchy), "Copy is the same.");
+            for (int i = 0; i < 70; ++i)
+            {
+                hierarchy.removeLastLeaf();
+            }
+            this->assert_equals(static_cast<size_t>(n - 70), hierarchy.size());
+            this->assert_equals(n - 71, hierarchy.accessLastLeaf()->data_);
+            this->assert_false(copy.equals(hierarchy), "Modified copy is different.");
+
+            amt::ImplicitHierarchy<int, 3, Layout> assigned;
+            assigned.assign(hierarchy);
+            this->assert_true(assigned.equals(hierarchy), "Assigned hierarchy is the same.");
+            this->assert_equals(static_cast<size_t>(3), assigned.degree(*assigned.accessSon(*assigned.accessRoot(), 1)));
+
+            hierarchy.clear();
+            this->assert_true(hierarchy.isEmpty(), "Cleared hierarchy is empty.");
+            this->assert_null(hierarchy.accessRoot());
+        }
+    };
+
+    /**
+     *  @brief Tests that van Emde Boas index mapping is a bijection and its inverse.
+     */
+    class ImplicitHierarchyTestVanEmdeBoasIndices : public LeafTest
+    {
+    public:
+        ImplicitHierarchyTestVanEmdeBoasIndices() :
+            LeafTest("veb-indices")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            using Layout = amt::VanEmdeBoasLayout;
+            //      0                   0
+            //    1   2    stored as    1 3 4  2 5 6
+            //   3 4 5 6
+            const size_t expected[] = {0, 1, 4, 2, 3, 5, 6};
+            for (size_t i = 0; i < 7; ++i)
+            {
+                this->assert_equals(expected[i], Layout::physicalIndex<2>(i, 3));
+            }
+
+            this->assert_true(this->isBijection<2>(), "Binary mapping is a bijection.");
+            this->assert_true(this->isBijection<3>(), "Ternary mapping is a bijection.");
+        }
+
+    private:
+        template<size_t K>
+        bool isBijection()
+        {
+            using Layout = amt::VanEmdeBoasLayout;
+            for (size_t height = 1; height <= 7; ++height)
+            {
+                const size_t count = Layout::completeSize<K>(height);
+                std::vector<bool> used(count, false);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const size_t physical = Layout::physicalIndex<K>(i, height);
+                    if (physical >= count || used[physical] || Layout::logicalIndex<K>(physical, height) != i)
+                    {
+                        return false;
+                    }
+                    used[physical] = true;
+                }
+            }
+            return true;
+        }
+    };
+
     /**
      * @brief All ImplicitHierarchy tests.
      */
@@ -260,6 +389,10 @@ namespace ds::tests
             this->add_test(std::make_unique<ImplicitHierarchyTestLevelsCountsDegs>());
             this->add_test(std::make_unique<ImplicitHierarchyTestRemove>());
             this->add_test(std::make_unique<ImplicitHierarchyTestCopyAssign>());
+            this->add_test(std::make_unique<ImplicitHierarchyTestLayout<amt::BreadthFirstLayout>>("layout-bfs"));
+            this->add_test(std::make_unique<ImplicitHierarchyTestLayout<amt::EytzingerLayout>>("layout-eytzinger"));
+            this->add_test(std::make_unique<ImplicitHierarchyTestLayout<amt::VanEmdeBoasLayout>>("layout-veb"));
+            this->add_test(std::make_unique<ImplicitHierarchyTestVanEmdeBoasIndices>());
         }
     };
 }
\ No newline at end of file
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <tests/_details/test.hpp>
+#include <libds/amt/explicit_network.h>
+#include <memory>
+
+namespace ds::tests
+{
+    namespace details
+    {
+        /**
+         *  0 - 1 - 2
+         *   \  |
+         *      3   4
+         */
+        template<class Network>
+        std::unique_ptr<Network> makeNetwork()
+        {
+            auto network = std::make_unique<Network>();
+            for (int i = 0; i < 5; ++i)
+            {
+                network->insert().data_ = i * 10;
+            }
+            network->connect(*network->accessNodeFromGate(0), *network->accessNodeFromGate(1));
+            network->connect(*network->accessNodeFromGate(1), *network->accessNodeFromGate(2));
+            network->connect(*network->accessNodeFromGate(3), *network->accessNodeFromGate(1));
+            network->connect(*network->accessNodeFromGate(0), *network->accessNodeFromGate(3));
+            return network;
+        }
+    }
+
+    /**
+     *  @brief Tests that an assigned network has the same nodes and relations.
+     */
+    template<class Network>
+    class NetworkTestAssign : public LeafTest
+    {
+    public:
+        explicit NetworkTestAssign(const std::string& name) :
+            LeafTest(name)
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            auto network = details::makeNetwork<Network>();
+            Network copy;
+            copy.assign(*network);
+            this->assert_equals(network->size(), copy.size());
+            this->assert_equals(network->relationCount(), copy.relationCount());
+            for (size_t i = 0; i < network->size(); ++i)
+            {
+                auto* node = network->accessNodeFromGate(i);
+                auto* copyNode = copy.accessNodeFromGate(i);
+                this->assert_equals(node->data_, copyNode->data_);
+                this->assert_equals(network->degree(*node), copy.degree(*copyNode));
+            }
+            this->assert_true(copy.relationExists(*copy.accessNodeFromGate(3), *copy.accessNodeFromGate(0)), "Relation copied.");
+            this->assert_false(copy.relationExists(*copy.accessNodeFromGate(2), *copy.accessNodeFromGate(3)), "No extra relation.");
+        }
+    };
+
+    /**
+     *  @brief Tests the compressed network created by freeze.
+     */
+    template<class Network>
+    class NetworkTestFreeze : public LeafTest
+    {
+    public:
+        explicit NetworkTestFreeze(const std::string& name) :
+            LeafTest(name)
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            auto network = details::makeNetwork<Network>();
+            auto frozen = network->freeze();
+            this->assert_equals(size_t(5), frozen.size());
+            this->assert_equals(network->relationCount(), frozen.relationCount());
+
+            const size_t degrees[] = {2, 3, 1, 2, 0};
+            for (size_t i = 0; i < frozen.size(); ++i)
+            {
+                auto* node = frozen.accessNodeFromGate(i);
+                this->assert_equals(static_cast<int>(i) * 10, node->data_);
+                this->assert_equals(degrees[i], frozen.degree(*node));
+            }
+
+            auto* one = frozen.accessNodeFromGate(1);
+            this->assert_equals(0, frozen.accessNodeFromNode(*one, 0)->data_);
+            this->assert_equals(20, frozen.accessNodeFromNode(*one, 1)->data_);
+            this->assert_equals(30, frozen.accessNodeFromNode(*one, 2)->data_);
+            this->assert_true(frozen.accessNodeFromNode(*one, 3) == nullptr, "Order out of range.");
+
+            this->assert_true(frozen.relationExists(*frozen.accessNodeFromGate(3), *one), "Relation exists.");
+            this->assert_false(frozen.relationExists(*frozen.accessNodeFromGate(2), *frozen.accessNodeFromGate(4)), "Relation does not exist.");
+
+            amt::CompressedNetwork<int> copy(frozen);
+            this->assert_true(copy.equals(frozen), "Copy equals original.");
+            this->assert_throws([&frozen]() { frozen.insert(); });
+            this->assert_throws([&frozen, one]() { frozen.connect(*one, *one); });
+        }
+    };
+
+    /**
+     *  @brief Tests a hub node whose relations outgrow the inline array of the hashed relation set.
+     */
+    class NetworkTestHashedRelations : public LeafTest
+    {
+    public:
+        NetworkTestHashedRelations() :
+            LeafTest("hashed-relations")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            constexpr size_t leafCount = 1000;
+
+            amt::IGHRNetwork<int> network;
+            auto& hub = network.insert();
+            for (size_t i = 0; i < leafCount; ++i)
+            {
+                auto& leaf = network.insert();
+                leaf.data_ = static_cast<int>(i);
+                network.connect(hub, leaf);
+            }
+            this->assert_true(hub.relations_->isHashed(), "Hub relations are hashed.");
+            this->assert_false(network.accessNodeFromGate(1)->relations_->isHashed(), "Leaf relations stay inline.");
+            this->assert_equals(leafCount, network.degree(hub));
+
+            network.connect(hub, *network.accessNodeFromGate(1));
+            this->assert_equals(leafCount, network.degree(hub));
+
+            for (size_t i = 1; i <= leafCount; i += 2)
+            {
+                network.disconnect(hub, *network.accessNodeFromGate(i));
+            }
+            this->assert_equals(leafCount / 2, network.degree(hub));
+
+            bool relationsMatch = true;
+            for (size_t i = 1; i <= leafCount; ++i)
+            {
+                auto& leaf = *network.accessNodeFromGate(i);
+                const bool expected = i % 2 == 0;
+                relationsMatch = relationsMatch
+                    && network.relationExists(hub, leaf) == expected
+                    && network.relationExists(leaf, hub) == expected
+                    && network.degree(leaf) == (expected ? 1 : 0);
+            }
+            this->assert_true(relationsMatch, "Remaining relations exist in both directions.");
+
+            auto frozen = network.freeze();
+            this->assert_equals(leafCount / 2, frozen.degree(*frozen.accessNodeFromGate(0)));
+            this->assert_equals(1, frozen.accessNodeFromNode(*frozen.accessNodeFromGate(0), 0)->data_);
+
+            network.remove(&hub);
+            this->assert_equals(leafCount, network.size());
+            this->assert_equals(size_t(0), network.relationCount());
+        }
+    };
+
+    /**
+     *  @brief All network tests.
+     */
+    class NetworkTest : public CompositeTest
+    {
+    public:
+        NetworkTest() :
+            CompositeTest("Network")
+        {
+            this->add_test(std::make_unique<NetworkTestAssign<amt::IGIRNetwork<int>>>("assign-igir"));
+            this->add_test(std::make_unique<NetworkTestAssign<amt::EGERNetwork<int>>>("assign-eger"));
+            this->add_test(std::make_unique<NetworkTestFreeze<amt::IGIRNetwork<int>>>("freeze-igir"));
+            this->add_test(std::make_unique<NetworkTestFreeze<amt::EGERNetwork<int>>>("freeze-eger"));
+            this->add_test(std::make_unique<NetworkTestAssign<amt::IGHRNetwork<int>>>("assign-ighr"));
+            this->add_test(std::make_unique<NetworkTestFreeze<amt::IGHRNetwork<int>>>("freeze-ighr"));
+            this->add_test(std::make_unique<NetworkTestHashedRelations>());
+        }
+    };
+}
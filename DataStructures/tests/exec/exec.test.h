@@ -0,0 +1,18 @@
+﻿#pragma once
+
+#include <tests/_details/test.hpp>
+#include <tests/exec/thread_pool.test.h>
+#include <memory>
+
+namespace ds::tests
+{
+    class ExecTest : public CompositeTest
+    {
+    public:
+        ExecTest() :
+            CompositeTest("exec")
+        {
+            this->add_test(std::make_unique<ThreadPoolTest>());
+        }
+    };
+}
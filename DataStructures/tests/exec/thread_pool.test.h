@@ -0,0 +1,277 @@
+#pragma once
+
+#include <tests/_details/test.hpp>
+#include <libds/exec/thread_pool.h>
+#include <libds/exec/work_stealing_deque.h>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ds::tests
+{
+    /**
+     * @brief Tests owner push and pop of the work-stealing deque.
+     */
+    class WorkStealingDequeTestPushPop : public LeafTest
+    {
+    public:
+        WorkStealingDequeTestPushPop() :
+            LeafTest("push-pop")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            constexpr int n = 1000;
+
+            exec::WorkStealingDeque<int> deque(4);
+            int item = 0;
+            this->assert_false(deque.pop(item), "Pop from empty deque fails.");
+
+            for (int i = 0; i < n; ++i)
+            {
+                deque.push(i);
+            }
+            this->assert_equals(static_cast<size_t>(n), deque.size());
+
+            this->assert_true(deque.steal(item), "Steal from non-empty deque succeeds.");
+            this->assert_equals(0, item);
+
+            bool lifo = true;
+            for (int i = n - 1; i >= 1; --i)
+            {
+                lifo = deque.pop(item) && item == i && lifo;
+            }
+            this->assert_true(lifo, "Owner pops items in reverse order.");
+            this->assert_true(deque.isEmpty(), "Deque is empty.");
+        }
+    };
+
+    /**
+     * @brief Owner pushes and pops while other threads steal; every item must be taken exactly once.
+     */
+    class WorkStealingDequeTestSteal : public LeafTest
+    {
+    public:
+        WorkStealingDequeTestSteal() :
+            LeafTest("steal")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            constexpr int thiefCount = 3;
+            constexpr long long n = 100'000;
+
+            exec::WorkStealingDeque<long long> deque(16);
+            std::atomic<long long> sum(0);
+            std::atomic<long long> taken(0);
+            std::vector<std::thread> thieves;
+            for (int t = 0; t < thiefCount; ++t)
+            {
+                thieves.emplace_back([&]()
+                    {
+                        long long item = 0;
+                        while (taken.load() < n)
+                        {
+                            if (deque.steal(item))
+                            {
+                                sum += item;
+                                ++taken;
+                            }
+                        }
+                    });
+            }
+
+            long long item = 0;
+            for (long long i = 1; i <= n; ++i)
+            {
+                deque.push(i);
+                if (i % 3 == 0 && deque.pop(item))
+                {
+                    sum += item;
+                    ++taken;
+                }
+            }
+            while (deque.pop(item))
+            {
+                sum += item;
+                ++taken;
+            }
+
+            for (std::thread& thief : thieves)
+            {
+                thief.join();
+            }
+
+            this->assert_equals(n, taken.load());
+            this->assert_equals(n * (n + 1) / 2, sum.load());
+        }
+    };
+
+    /**
+     * @brief Tests submit, parallelFor and parallelReduce of the thread pool.
+     */
+    class ThreadPoolTestParallelFor : public LeafTest
+    {
+    public:
+        ThreadPoolTestParallelFor() :
+            LeafTest("submit-parallelFor-parallelReduce")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            constexpr size_t n = 100'000;
+
+            exec::ThreadPool pool(4);
+
+            std::atomic<int> submitted(0);
+            {
+                exec::TaskGroup group(pool);
+                for (int i = 0; i < 100; ++i)
+                {
+                    group.run([&submitted]() { ++submitted; });
+                }
+                group.wait();
+            }
+            this->assert_equals(100, submitted.load());
+
+            std::vector<int> visits(n, 0);
+            pool.parallelFor(0, n, 1000, [&visits](size_t i) { ++visits[i]; });
+            bool once = true;
+            for (int v : visits)
+            {
+                once = once && v == 1;
+            }
+            this->assert_true(once, "Every index is visited exactly once.");
+
+            const unsigned long long sum = pool.parallelReduce(0, n, 1000, 0ULL,
+                [](size_t first, size_t last)
+                {
+                    unsigned long long partial = 0;
+                    for (size_t i = first; i < last; ++i)
+                    {
+                        partial += i;
+                    }
+                    return partial;
+                },
+                [](unsigned long long a, unsigned long long b) { return a + b; });
+            this->assert_equals(static_cast<unsigned long long>(n) * (n - 1) / 2, sum);
+
+            std::atomic<int> detached(0);
+            for (int i = 0; i < 100; ++i)
+            {
+                pool.submit([&detached]() { ++detached; });
+            }
+            while (detached.load() < 100)
+            {
+                std::this_thread::yield();
+            }
+            this->assert_equals(100, detached.load());
+        }
+    };
+
+    /**
+     * @brief Tests nested task groups and exception propagation.
+     */
+    class ThreadPoolTestTaskGroup : public LeafTest
+    {
+    public:
+        ThreadPoolTestTaskGroup() :
+            LeafTest("task-group")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            exec::ThreadPool pool(2);
+
+            std::atomic<int> leaves(0);
+            exec::TaskGroup outer(pool);
+            for (int i = 0; i < 8; ++i)
+            {
+                outer.run([&pool, &leaves]()
+                    {
+                        pool.parallelFor(0, 64, 4, [&leaves](size_t) { ++leaves; });
+                    });
+            }
+            outer.wait();
+            this->assert_equals(8 * 64, leaves.load());
+
+            this->assert_throws([&pool]()
+                {
+                    exec::TaskGroup group(pool);
+                    group.run([]() { throw std::runtime_error("task failed"); });
+                    group.wait();
+                },
+                "Exception thrown by a task is rethrown by wait."
+            );
+        }
+    };
+
+    /**
+     * @brief Tasks submitted by a thread that is not a worker run on workers; their blocks must return
+     * to the arena they came from, so repeated submissions do not allocate new chunks.
+     */
+    class ThreadPoolTestTaskRecycling : public LeafTest
+    {
+    public:
+        ThreadPoolTestTaskRecycling() :
+            LeafTest("task-recycling")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            constexpr int warmUp = 1'000;
+            constexpr int rounds = 20'000;
+
+            exec::ThreadPool pool(4);
+            std::atomic<int> visits(0);
+            auto round = [&pool, &visits]()
+                {
+                    pool.parallelFor(0, 64, 4, [&visits](size_t) { ++visits; });
+                };
+
+            for (int i = 0; i < warmUp; ++i)
+            {
+                round();
+            }
+            const size_t chunksAfterWarmUp = pool.getTaskChunkCount();
+            for (int i = 0; i < rounds; ++i)
+            {
+                round();
+            }
+            const size_t chunks = pool.getTaskChunkCount();
+
+            this->assert_equals((warmUp + rounds) * 64, visits.load());
+            this->assert_true(chunks <= chunksAfterWarmUp + pool.getThreadCount() + 1,
+                "Task chunks stay bounded: " + std::to_string(chunksAfterWarmUp) + " after warm-up, " + std::to_string(chunks) + " at the end.");
+        }
+    };
+
+    /**
+     * @brief All thread pool tests.
+     */
+    class ThreadPoolTest : public CompositeTest
+    {
+    public:
+        ThreadPoolTest() :
+            CompositeTest("ThreadPool")
+        {
+            this->add_test(std::make_unique<WorkStealingDequeTestPushPop>());
+            this->add_test(std::make_unique<WorkStealingDequeTestSteal>());
+            this->add_test(std::make_unique<ThreadPoolTestParallelFor>());
+            this->add_test(std::make_unique<ThreadPoolTestTaskGroup>());
+            this->add_test(std::make_unique<ThreadPoolTestTaskRecycling>());
+        }
+    };
+}
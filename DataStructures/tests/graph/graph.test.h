@@ -0,0 +1,18 @@
+﻿#pragma once
+
+#include <tests/_details/test.hpp>
+#include <tests/graph/graph_algorithms.test.h>
+#include <memory>
+
+namespace ds::tests
+{
+    class GraphTest : public CompositeTest
+    {
+    public:
+        GraphTest() :
+            CompositeTest("graph")
+        {
+            this->add_test(std::make_unique<GraphAlgorithmsTest>());
+        }
+    };
+}
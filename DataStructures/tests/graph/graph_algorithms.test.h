@@ -0,0 +1,245 @@
+#pragma once
+
+#include <tests/_details/test.hpp>
+#include <libds/graph/graph_view.h>
+#include <libds/graph/breadth_first_search.h>
+#include <libds/graph/shortest_paths.h>
+#include <libds/graph/connected_components.h>
+#include <libds/amt/explicit_network.h>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace ds::tests
+{
+    namespace details
+    {
+        /**
+         *  @brief Random network with nodeCount nodes holding random data and about nodeCount * degree / 2 connections.
+         *         Nodes with index >= connectedCount are left isolated.
+         */
+        inline std::unique_ptr<amt::IGIRNetwork<int>> makeRandomNetwork(size_t nodeCount, size_t degree, size_t connectedCount, unsigned seed)
+        {
+            std::mt19937 rng(seed);
+            auto network = std::make_unique<amt::IGIRNetwork<int>>();
+            for (size_t i = 0; i < nodeCount; ++i)
+            {
+                network->insert().data_ = static_cast<int>(rng() % 1000);
+            }
+            for (size_t i = 0; i < connectedCount * degree / 2; ++i)
+            {
+                const size_t a = rng() % connectedCount;
+                const size_t b = rng() % connectedCount;
+                if (a != b)
+                {
+                    network->connect(*network->accessNodeFromGate(a), *network->accessNodeFromGate(b));
+                }
+            }
+            return network;
+        }
+
+        inline double nodeDataWeight(const int& from, const int& to)
+        {
+            return static_cast<double>(std::abs(from - to) % 23) / 8.0;
+        }
+    }
+
+    /**
+     *  @brief Tests that views of an explicit network, its frozen copy and the generic conversion agree.
+     */
+    class GraphViewTest : public LeafTest
+    {
+    public:
+        GraphViewTest() :
+            LeafTest("graph-view")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            auto network = details::makeRandomNetwork(200, 6, 200, 7);
+            const amt::Network<amt::IRNetworkBlock<int>>& abstractNetwork = *network;
+            auto frozen = network->freeze();
+
+            graph::GraphView<int> fromExplicit(*network);
+            graph::GraphView<int> fromGeneric(abstractNetwork);
+            graph::GraphView<int> fromCompressed(frozen);
+
+            this->assert_equals(network->size(), fromGeneric.nodeCount());
+            this->assert_equals(network->relationCount(), fromGeneric.relationCount());
+            this->assert_true(&fromCompressed.getNetwork() == &frozen, "Compressed network is not copied.");
+            this->assert_true(frozen.equals(fromExplicit.getNetwork()), "Explicit network is frozen.");
+            this->assert_true(frozen.equals(fromGeneric.getNetwork()), "Generic conversion matches freeze.");
+        }
+    };
+
+    /**
+     *  @brief Compares parallel BFS levels with a sequential BFS.
+     */
+    class BreadthFirstSearchTest : public LeafTest
+    {
+    public:
+        BreadthFirstSearchTest() :
+            LeafTest("breadth-first-search")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            auto network = details::makeRandomNetwork(20'000, 12, 19'000, 11);
+            graph::GraphView<int> view(*network);
+
+            std::vector<size_t> expected(view.nodeCount(), graph::BreadthFirstSearch::UNREACHED);
+            std::queue<size_t> queue;
+            expected[0] = 0;
+            queue.push(0);
+            while (!queue.empty())
+            {
+                const size_t node = queue.front();
+                queue.pop();
+                for (size_t k = 0; k < view.degree(node); ++k)
+                {
+                    const size_t neighbour = view.accessNeighbours(node)[k];
+                    if (expected[neighbour] == graph::BreadthFirstSearch::UNREACHED)
+                    {
+                        expected[neighbour] = expected[node] + 1;
+                        queue.push(neighbour);
+                    }
+                }
+            }
+
+            graph::BreadthFirstSearch bfs;
+            const std::vector<size_t> levels = bfs.run(view, 0);
+            this->assert_true(levels == expected, "Levels match sequential BFS.");
+            this->assert_true(bfs.getBottomUpStepCount() > 0, "Some levels were expanded bottom-up.");
+            this->assert_true(bfs.getTopDownStepCount() > 0, "Some levels were expanded top-down.");
+            this->assert_throws([&bfs, &view]() { bfs.run(view, view.nodeCount()); });
+        }
+    };
+
+    /**
+     *  @brief Compares delta-stepping distances with Dijkstra's algorithm.
+     */
+    class ShortestPathsTest : public LeafTest
+    {
+    public:
+        ShortestPathsTest() :
+            LeafTest("delta-stepping")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            auto network = details::makeRandomNetwork(5'000, 8, 4'800, 13);
+            graph::GraphView<int> view(*network);
+
+            using Item = std::pair<double, size_t>;
+            std::vector<double> expected(view.nodeCount(), graph::DeltaSteppingShortestPaths::UNREACHED);
+            std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+            expected[0] = 0.0;
+            queue.emplace(0.0, 0);
+            while (!queue.empty())
+            {
+                const Item item = queue.top();
+                queue.pop();
+                if (item.first > expected[item.second])
+                {
+                    continue;
+                }
+                for (size_t k = 0; k < view.degree(item.second); ++k)
+                {
+                    const size_t neighbour = view.accessNeighbours(item.second)[k];
+                    const double candidate = item.first + details::nodeDataWeight(view.accessData(item.second), view.accessData(neighbour));
+                    if (candidate < expected[neighbour])
+                    {
+                        expected[neighbour] = candidate;
+                        queue.emplace(candidate, neighbour);
+                    }
+                }
+            }
+
+            graph::DeltaSteppingShortestPaths sssp(1.0);
+            const std::vector<double> distances = sssp.run(view, 0, details::nodeDataWeight);
+            bool equal = true;
+            for (size_t i = 0; i < expected.size(); ++i)
+            {
+                equal = equal && (expected[i] == distances[i] || std::abs(expected[i] - distances[i]) < 1e-9);
+            }
+            this->assert_true(equal, "Distances match Dijkstra.");
+            this->assert_throws([]() { graph::DeltaSteppingShortestPaths(0.0); });
+        }
+    };
+
+    /**
+     *  @brief Tests component labels on a network with isolated nodes and two separate parts.
+     */
+    class ConnectedComponentsTest : public LeafTest
+    {
+    public:
+        ConnectedComponentsTest() :
+            LeafTest("connected-components")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            auto network = details::makeRandomNetwork(10'000, 10, 9'000, 17);
+            // Chain of the isolated nodes 9000 ... 9099 forms one more component.
+            for (size_t i = 9'000; i < 9'099; ++i)
+            {
+                network->connect(*network->accessNodeFromGate(i), *network->accessNodeFromGate(i + 1));
+            }
+            graph::GraphView<int> view(*network);
+
+            graph::BreadthFirstSearch bfs;
+            const std::vector<size_t> fromZero = bfs.run(view, 0);
+            size_t expectedCount = 1;
+            bool labelsMatch = true;
+            graph::ConnectedComponents components;
+            const std::vector<size_t> labels = components.run(view);
+            for (size_t i = 0; i < view.nodeCount(); ++i)
+            {
+                if (fromZero[i] != graph::BreadthFirstSearch::UNREACHED)
+                {
+                    labelsMatch = labelsMatch && labels[i] == 0;
+                }
+                else if (i >= 9'000 && i < 9'100)
+                {
+                    labelsMatch = labelsMatch && labels[i] == 9'000;
+                }
+                else
+                {
+                    labelsMatch = labelsMatch && labels[i] == i;
+                }
+                expectedCount += fromZero[i] == graph::BreadthFirstSearch::UNREACHED && (i < 9'000 || i >= 9'100) ? 1 : 0;
+            }
+            ++expectedCount;
+
+            this->assert_true(labelsMatch, "Labels are the smallest node index of each component.");
+            this->assert_equals(expectedCount, components.getComponentCount());
+        }
+    };
+
+    /**
+     *  @brief All graph algorithm tests.
+     */
+    class GraphAlgorithmsTest : public CompositeTest
+    {
+    public:
+        GraphAlgorithmsTest() :
+            CompositeTest("Graph")
+        {
+            this->add_test(std::make_unique<GraphViewTest>());
+            this->add_test(std::make_unique<BreadthFirstSearchTest>());
+            this->add_test(std::make_unique<ShortestPathsTest>());
+            this->add_test(std::make_unique<ConnectedComponentsTest>());
+        }
+    };
+}
@@ -3,6 +3,7 @@
 #include <tests/_details/test.hpp>
 #include <tests/mm/memory_manager.test.h>
 #include <tests/mm/compact_memory_manager.test.h>
+#include <tests/mm/pool_memory_manager.test.h>
 #include <memory>
 
 namespace ds::tests
@@ -15,6 +16,7 @@ namespace ds::tests
         {
             this->add_test(std::make_unique<MemoryManagerTest>());
             this->add_test(std::make_unique<CompactMemoryManagerTest>());
+            this->add_test(std::make_unique<PoolMemoryManagerTest>());
         }
     };
 }
\ No newline at end of file
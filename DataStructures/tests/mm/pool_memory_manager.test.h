@@ -0,0 +1,98 @@
+#pragma once
+
+#include <tests/_details/test.hpp>
+#include <libds/mm/pool_memory_manager.h>
+#include <memory>
+#include <vector>
+
+namespace ds::tests
+{
+    /**
+     * @brief Tests that blocks are taken from chunks and counted.
+     */
+    class PoolMemoryManagerTestAllocate : public LeafTest
+    {
+    public:
+        PoolMemoryManagerTestAllocate() :
+            LeafTest("allocate")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            using ManagerType = mm::PoolMemoryManager<int>;
+            const size_t count = ManagerType::CHUNK_SIZE + 1;
+
+            ManagerType manager;
+            this->assert_equals(static_cast<size_t>(0), manager.getCapacity());
+
+            std::vector<int*> blocks;
+            for (size_t i = 0; i < count; ++i)
+            {
+                blocks.push_back(manager.allocateMemory());
+                *blocks.back() = static_cast<int>(i);
+            }
+            this->assert_equals(count, manager.getAllocatedBlockCount());
+            this->assert_equals(2 * ManagerType::CHUNK_SIZE, manager.getCapacity());
+            this->assert_equals(0, *blocks.front());
+            this->assert_equals(static_cast<int>(count - 1), *blocks.back());
+
+            for (int* block : blocks)
+            {
+                manager.releaseMemory(block);
+            }
+            this->assert_equals(static_cast<size_t>(0), manager.getAllocatedBlockCount());
+        }
+    };
+
+    /**
+     * @brief Tests that released blocks are reused before a new chunk is allocated.
+     */
+    class PoolMemoryManagerTestReuse : public LeafTest
+    {
+    public:
+        PoolMemoryManagerTestReuse() :
+            LeafTest("reuse")
+        {
+        }
+
+    protected:
+        void test() override
+        {
+            using ManagerType = mm::PoolMemoryManager<int>;
+
+            ManagerType manager;
+            std::vector<int*> blocks;
+            for (size_t i = 0; i < ManagerType::CHUNK_SIZE; ++i)
+            {
+                blocks.push_back(manager.allocateMemory());
+            }
+
+            int* released = blocks[10];
+            manager.releaseMemory(released);
+            blocks[10] = manager.allocateMemory();
+            this->assert_equals(released, blocks[10]);
+            this->assert_equals(ManagerType::CHUNK_SIZE, manager.getCapacity());
+
+            for (int* block : blocks)
+            {
+                manager.releaseMemory(block);
+            }
+        }
+    };
+
+    /**
+     * @brief All PoolMemoryManager tests.
+     */
+    class PoolMemoryManagerTest : public CompositeTest
+    {
+    public:
+        PoolMemoryManagerTest() :
+            CompositeTest("PoolMemoryManager")
+        {
+            this->add_test(std::make_unique<PoolMemoryManagerTestAllocate>());
+            this->add_test(std::make_unique<PoolMemoryManagerTestReuse>());
+        }
+    };
+}
@@ -4,6 +4,8 @@
 #include <tests/adt/adt.test.h>
 #include <tests/amt/amt.test.h>
 #include <tests/mm/mm.test.h>
+#include <tests/exec/exec.test.h>
+#include <tests/graph/graph.test.h>
 #include <memory>
 
 namespace ds::tests
@@ -17,6 +19,8 @@ namespace ds::tests
             this->add_test(std::make_unique<MMTest>());
             this->add_test(std::make_unique<AMTTest>());
             this->add_test(std::make_unique<ADTTest>());
+            this->add_test(std::make_unique<ExecTest>());
+            this->add_test(std::make_unique<GraphTest>());
         }
     };
 }
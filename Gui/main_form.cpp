@@ -6,6 +6,10 @@
 #include <msclr\marshal_cppstd.h>
 
 #include "complexities/queue_analyzer.h"
+#include "complexities/concurrent_queue_analyzer.h"
+#include "complexities/network_analyzer.h"
+#include "complexities/implicit_hierarchy_analyzer.h"
+#include "complexities/hierarchy_analyzer.h"
 
 namespace WF = System::Windows::Forms;
 namespace Col = System::Collections::Generic;
@@ -17,11 +21,14 @@ std::vector<std::unique_ptr<ds::tests::Test>> createTests()
     auto mm   = std::make_unique<ds::tests::CompositeTest>("mm");
 	auto amt  = std::make_unique<ds::tests::CompositeTest>("amt");
 	auto adt  = std::make_unique<ds::tests::CompositeTest>("adt");
+	auto exec = std::make_unique<ds::tests::CompositeTest>("exec");
+	auto graph = std::make_unique<ds::tests::CompositeTest>("graph");
 
 	mm->add_test(std::make_unique<ds::tests::MemoryManagerTest>());
 
 	// TODO 02
 	mm->add_test(std::make_unique<ds::tests::CompactMemoryManagerTest>());
+	mm->add_test(std::make_unique<ds::tests::PoolMemoryManagerTest>());
 
 	// TODO 03
 	amt->add_test(std::make_unique<ds::tests::ImplicitSequenceTest>());
@@ -35,6 +42,7 @@ std::vector<std::unique_ptr<ds::tests::Test>> createTests()
 	// TODO 07
 	amt->add_test(std::make_unique<ds::tests::ExplicitHierarchyTest>());
 	amt->add_test(std::make_unique<ds::tests::HierarchyTest>());
+	amt->add_test(std::make_unique<ds::tests::NetworkTest>());
 
 	// TODO 08
 	adt->add_test(std::make_unique<ds::tests::ListTest>());
@@ -54,9 +62,15 @@ std::vector<std::unique_ptr<ds::tests::Test>> createTests()
 	// TODO 12
 	adt->add_test(std::make_unique<ds::tests::SortTest>());
 
+	exec->add_test(std::make_unique<ds::tests::ThreadPoolTest>());
+
+	graph->add_test(std::make_unique<ds::tests::GraphAlgorithmsTest>());
+
 	root->add_test(std::move(mm));
 	root->add_test(std::move(amt));
 	root->add_test(std::move(adt));
+	root->add_test(std::move(exec));
+	root->add_test(std::move(graph));
 	std::vector<std::unique_ptr<ds::tests::Test>> tests;
 	tests.emplace_back(std::move(root));
 	return tests;
@@ -70,6 +84,11 @@ std::vector<std::unique_ptr<ds::utils::Analyzer>> createAnalyzers()
 	analyzers.emplace_back(std::make_unique<ds::utils::ListsAnalyzer>());
 	analyzers.emplace_back(std::make_unique<ds::utils::TablesAnalyzer>());
 	analyzers.emplace_back(std::make_unique<ds::utils::QueuesAnalyzer>());
+	analyzers.emplace_back(std::make_unique<ds::utils::ConcurrentQueuesAnalyzer>());
+	analyzers.emplace_back(std::make_unique<ds::utils::NetworksAnalyzer>());
+	analyzers.emplace_back(std::make_unique<ds::utils::ImplicitHierarchiesAnalyzer>());
+	analyzers.emplace_back(std::make_unique<ds::utils::HierarchyTraversalsAnalyzer>());
+	analyzers.emplace_back(std::make_unique<ds::utils::KWayHierarchiesAnalyzer>());
 
 
 	return analyzers;
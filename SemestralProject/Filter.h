@@ -8,20 +8,14 @@ auto matchLifetime = [](const RoutingTableRow& row, unsigned int startTime, unsi
     return false;
 };
 
-auto matchWithAddress = [](const RoutingTableRow& row, const std::bitset<32>& addressToCompare) {
-    std::bitset<32> ipAddress = row.ipAddress;
-    for (int i = 0; i < row.prefix; ++i) {
-        if (ipAddress[ipAddress.size() - i - 1] != addressToCompare[addressToCompare.size() - i - 1]) {
-            return false;
-        }
-    }
-    return true;
+auto matchWithAddress = [](const RoutingTableRow& row, const IPv4Prefix& addressToCompare) {
+    return row.ipAddress.contains(addressToCompare.address);
 };
 
 class Filter {
 public:
     static void chooseLifetime(unsigned int& startingLifetime, unsigned int& endingLifetime);
-    static void chooseAddress(std::bitset<32>& ipAddressToCompare);
+    static void chooseAddress(IPv4Prefix& ipAddressToCompare);
     template<typename Pred, typename Seq, typename Iterator>
     static void filterEntries(Iterator begin, Iterator end, Pred predicate, Seq& sequence);
 };
@@ -57,14 +51,14 @@ void Filter::chooseLifetime(unsigned int& startingLifetime, unsigned int& ending
     std::cout << "Selected lifetime: " << startingLifetime << "(s) - " << endingLifetime << "(s)" << std::endl;
 }
 
-void Filter::chooseAddress(std::bitset<32>& ipAddressToCompare) {
+void Filter::chooseAddress(IPv4Prefix& ipAddressToCompare) {
     bool validIpAddress = false;
     while (!validIpAddress) {
         std::cout << "Insert IP address to filter (W.X.Y.Z): ";
         std::string ipAddressString;
         std::cin >> ipAddressString;
         try {
-            ipAddressToCompare = RoutingTableOperations::processIPAddress(ipAddressString, nullptr);
+            ipAddressToCompare = RoutingTableOperations::processIPAddress(ipAddressString);
             validIpAddress = true;
         } catch (const std::exception& e) {
             std::cerr << e.what() << std::endl;
@@ -1,9 +1,12 @@
+#pragma once
 #include <libds/amt/explicit_hierarchy.h>
 #include "RoutingTable.h"
+#include "RowStore.h"
+#include <climits>
 #include <libds/heap_monitor.h>
 
 struct Node {
-    std::bitset<8> octet;
+    uint8_t octet = 0;
     RoutingTableRow* pData = nullptr;
     bool operator==(const Node& other) const {
         return octet == other.octet && pData == other.pData;
@@ -20,145 +23,295 @@ auto matchLifetimeHierarchy = [](const Node& node, unsigned int startTime, unsig
     return false;
     };
 
-auto matchWithAddressHierarchy = [](const Node& node, const std::bitset<32>& addressToCompare) {
-    if (node.pData != nullptr) {
-        std::bitset<32> ipAddress = node.pData->ipAddress;
-        for (int i = 0; i < node.pData->prefix; ++i) {
-            if (ipAddress[ipAddress.size() - i - 1] != addressToCompare[addressToCompare.size() - i - 1]) {
-                return false;
-            }
-        }
-        return true;
-    }
-    return false;
+auto matchWithAddressHierarchy = [](const Node& node, const IPv4Prefix& addressToCompare) {
+    return node.pData != nullptr && node.pData->ipAddress.contains(addressToCompare.address);
     };
 
+// Range of lifetimes of routes in a subtree, lets lifetime filters skip subtrees without a matching route.
+struct LifetimeRange {
+    struct ValueType {
+        unsigned int min;
+        unsigned int max;
+    };
+
+    static ValueType identity() { return { UINT_MAX, 0 }; }
+    static ValueType of(const Node& node) {
+        return node.pData != nullptr ? ValueType{ node.pData->lifetime, node.pData->lifetime } : identity();
+    }
+    static ValueType combine(const ValueType& a, const ValueType& b) {
+        return { std::min(a.min, b.min), std::max(a.max, b.max) };
+    }
+};
+
+using RoutingHierarchy = ds::amt::PooledMultiWayEH<Node, LifetimeRange>;
+using RoutingBlock = ds::amt::PMWEHBlock<Node, LifetimeRange>;
+
 class HierarchyManager {
 public:
-    ds::amt::MultiWayEH<Node> hierarchy;
+    RoutingHierarchy hierarchy;
+
+    RoutingBlock* findSon(RoutingBlock& node, uint8_t octetParam) {
+        for (size_t i = 0; i < hierarchy.degree(node); ++i) {
+            auto* son = hierarchy.accessSon(node, i);
+            if (son->data_.octet == octetParam) {
+                return son;
+            }
+        }
+        return nullptr;
+    }
 
-    auto findSon(ds::amt::MWEHBlock<Node>& node, std::bitset<8> octetParam) {
-        auto predicate = [&](ds::amt::MemoryBlock<ds::amt::MWEHBlock<Node>*>* block) {
-            return block->data_->data_.octet == octetParam;
-            };
-        return node.sons_->findBlockWithProperty(predicate);
+    RoutingBlock* lastSon(RoutingBlock& node) {
+        return hierarchy.isLeaf(node) ? nullptr : hierarchy.accessSon(node, hierarchy.degree(node) - 1);
     }
 
     HierarchyManager();
-    bool existsLastSonWithOctet(ds::amt::MWEHBlock<Node>& node, std::bitset<8> octetParam);
-    void addBranch(std::bitset<32> sourceIP, RoutingTableRow* pVector);
-    void print(ds::amt::MWEHBlock<Node>& node);
-    void printNodeInfo(ds::amt::MWEHBlock<Node>& node);
-    void printSons(ds::amt::MWEHBlock<Node>& node);
-    std::string getOctetsToNode(ds::amt::MWEHBlock<Node>& node);
+    bool existsLastSonWithOctet(RoutingBlock& node, uint8_t octetParam);
+    void addBranch(const IPv4Prefix& sourceIP, RoutingTableRow* pVector);
+    void insertBranch(const IPv4Prefix& sourceIP, RoutingTableRow* pVector);
+    void removeBranch(const RoutingTableRow* pVector);
+    RoutingBlock* findLeaf(RoutingBlock& node, const RoutingTableRow* pVector);
+    void print(RoutingBlock& node);
+    void printNodeInfo(RoutingBlock& node);
+    void printSons(RoutingBlock& node);
+    std::string getOctetsToNode(RoutingBlock& node);
+    template<typename Pred>
+    void filterByLifetime(RoutingBlock& node, unsigned int startTime, unsigned int endTime, Pred predicate, ds::amt::IS<Node*>& sequence);
+    void filterByLifetime(RoutingBlock& node, unsigned int startTime, unsigned int endTime, RowStore& rows, ds::amt::IS<RoutingTableRow*>& sequence);
+
+private:
+    template<typename Function>
+    void forEachInLifetime(RoutingBlock& node, unsigned int startTime, unsigned int endTime, Function function);
 };
 
 HierarchyManager::HierarchyManager() {
     auto& root = hierarchy.emplaceRoot();
 }
 
-bool HierarchyManager::existsLastSonWithOctet(ds::amt::MWEHBlock<Node>& node, std::bitset<8> octetParam) {
-    auto last = node.sons_->accessLast();
+bool HierarchyManager::existsLastSonWithOctet(RoutingBlock& node, uint8_t octetParam) {
+    auto last = lastSon(node);
     if (last == nullptr) {
         return false;
     }
-    if (last->data_->data_.octet == octetParam) {
+    if (last->data_.octet == octetParam) {
         return true;
     }
     return false;
 }
 
-void HierarchyManager::addBranch(std::bitset<32> sourceIP, RoutingTableRow* pVector) {
+void HierarchyManager::addBranch(const IPv4Prefix& sourceIP, RoutingTableRow* pVector) {
     auto root = hierarchy.accessRoot();
-    if (existsLastSonWithOctet(*root, std::bitset<8>((sourceIP >> 24).to_ulong()))) {
-        if (existsLastSonWithOctet(*root->sons_->accessLast()->data_, std::bitset<8>((sourceIP >> 16).to_ulong() & 0xFF))) {
-            if (existsLastSonWithOctet(*root->sons_->accessLast()->data_->sons_->accessLast()->data_, std::bitset<8>((sourceIP >> 8).to_ulong() & 0xFF))) {
-                auto& fourthLevel = hierarchy.emplaceSon(*root->sons_->accessLast()->data_->sons_->accessLast()->data_->sons_->accessLast()->data_, hierarchy.degree(*root->sons_->accessLast()->data_->sons_->accessLast()->data_->sons_->accessLast()->data_));
-                fourthLevel.data_.octet = std::bitset<8>((sourceIP.to_ulong()) & 0xFF);
+    if (existsLastSonWithOctet(*root, sourceIP.octet(0))) {
+        if (existsLastSonWithOctet(*lastSon(*root), sourceIP.octet(1))) {
+            if (existsLastSonWithOctet(*lastSon(*lastSon(*root)), sourceIP.octet(2))) {
+                auto& fourthLevel = hierarchy.emplaceSon(*lastSon(*lastSon(*lastSon(*root))), hierarchy.degree(*lastSon(*lastSon(*lastSon(*root)))));
+                fourthLevel.data_.octet = sourceIP.octet(3);
                 fourthLevel.data_.pData = pVector;
+                hierarchy.refresh(fourthLevel);
             } else {
-                auto& thirdLevel = hierarchy.emplaceSon(*root->sons_->accessLast()->data_->sons_->accessLast()->data_, hierarchy.degree(*root->sons_->accessLast()->data_->sons_->accessLast()->data_));
-                thirdLevel.data_.octet = std::bitset<8>((sourceIP >> 8).to_ulong() & 0xFF);
+                auto& thirdLevel = hierarchy.emplaceSon(*lastSon(*lastSon(*root)), hierarchy.degree(*lastSon(*lastSon(*root))));
+                thirdLevel.data_.octet = sourceIP.octet(2);
                 auto& fourthLevel = hierarchy.emplaceSon(thirdLevel, hierarchy.degree(thirdLevel));
-                fourthLevel.data_.octet = std::bitset<8>((sourceIP.to_ulong()) & 0xFF);
+                fourthLevel.data_.octet = sourceIP.octet(3);
                 fourthLevel.data_.pData = pVector;
+                hierarchy.refresh(fourthLevel);
             }
         } else {
-            auto& secondLevel = hierarchy.emplaceSon(*root->sons_->accessLast()->data_, hierarchy.degree(*root->sons_->accessLast()->data_));
-            secondLevel.data_.octet = std::bitset<8>((sourceIP >> 16).to_ulong() & 0xFF);
+            auto& secondLevel = hierarchy.emplaceSon(*lastSon(*root), hierarchy.degree(*lastSon(*root)));
+            secondLevel.data_.octet = sourceIP.octet(1);
             auto& thirdLevel = hierarchy.emplaceSon(secondLevel, hierarchy.degree(secondLevel));
-            thirdLevel.data_.octet = std::bitset<8>((sourceIP >> 8).to_ulong() & 0xFF);
+            thirdLevel.data_.octet = sourceIP.octet(2);
             auto& fourthLevel = hierarchy.emplaceSon(thirdLevel, hierarchy.degree(thirdLevel));
-            fourthLevel.data_.octet = std::bitset<8>((sourceIP.to_ulong()) & 0xFF);
+            fourthLevel.data_.octet = sourceIP.octet(3);
             fourthLevel.data_.pData = pVector;
+            hierarchy.refresh(fourthLevel);
         }
     } else {
         auto& firstLevel = hierarchy.emplaceSon(*root, hierarchy.degree(*root));
-        firstLevel.data_.octet = std::bitset<8>((sourceIP >> 24).to_ulong());
+        firstLevel.data_.octet = sourceIP.octet(0);
         auto& secondLevel = hierarchy.emplaceSon(firstLevel, hierarchy.degree(firstLevel));
-        secondLevel.data_.octet = std::bitset<8>((sourceIP >> 16).to_ulong() & 0xFF);
+        secondLevel.data_.octet = sourceIP.octet(1);
         auto& thirdLevel = hierarchy.emplaceSon(secondLevel, hierarchy.degree(secondLevel));
-        thirdLevel.data_.octet = std::bitset<8>((sourceIP >> 8).to_ulong() & 0xFF);
+        thirdLevel.data_.octet = sourceIP.octet(2);
         auto& fourthLevel = hierarchy.emplaceSon(thirdLevel, hierarchy.degree(thirdLevel));
-        fourthLevel.data_.octet = std::bitset<8>((sourceIP.to_ulong()) & 0xFF);
+        fourthLevel.data_.octet = sourceIP.octet(3);
         fourthLevel.data_.pData = pVector;
+        hierarchy.refresh(fourthLevel);
+    }
+}
+
+// Unlike addBranch, which expects rows in the order of the loaded file, any existing son with the octet is
+// followed, so a route added to a loaded hierarchy joins the branch of its first three octets.
+void HierarchyManager::insertBranch(const IPv4Prefix& sourceIP, RoutingTableRow* pVector) {
+    RoutingBlock* node = hierarchy.accessRoot();
+    for (unsigned int level = 0; level < 3; ++level) {
+        RoutingBlock* son = findSon(*node, sourceIP.octet(level));
+        if (son == nullptr) {
+            son = &hierarchy.emplaceSon(*node, hierarchy.degree(*node));
+            son->data_.octet = sourceIP.octet(level);
+        }
+        node = son;
+    }
+    auto& fourthLevel = hierarchy.emplaceSon(*node, hierarchy.degree(*node));
+    fourthLevel.data_.octet = sourceIP.octet(3);
+    fourthLevel.data_.pData = pVector;
+    hierarchy.refresh(fourthLevel);
+}
+
+// Removes the leaf of the row together with its ancestors left without sons.
+void HierarchyManager::removeBranch(const RoutingTableRow* pVector) {
+    RoutingBlock* node = findLeaf(*hierarchy.accessRoot(), pVector);
+    if (node == nullptr) {
+        throw std::logic_error("Row is not in the hierarchy!");
+    }
+    RoutingBlock* parent = hierarchy.accessParent(*node);
+    while (parent->parent_ != nullptr && hierarchy.degree(*parent) == 1) {
+        node = parent;
+        parent = hierarchy.accessParent(*node);
+    }
+    size_t sonOrder = 0;
+    while (hierarchy.accessSon(*parent, sonOrder) != node) {
+        ++sonOrder;
+    }
+    hierarchy.removeSon(*parent, sonOrder);
+}
+
+// Branches are searched only through sons with the octets of the row. Unsorted files repeat a branch of
+// the same octets, so every matching son is tried.
+RoutingBlock* HierarchyManager::findLeaf(RoutingBlock& node, const RoutingTableRow* pVector) {
+    size_t level = hierarchy.level(node);
+    for (size_t i = 0; i < hierarchy.degree(node); ++i) {
+        auto* son = hierarchy.accessSon(node, i);
+        if (son->data_.octet != pVector->ipAddress.octet(static_cast<unsigned int>(level))) {
+            continue;
+        }
+        if (level == 3) {
+            if (son->data_.pData == pVector) {
+                return son;
+            }
+        } else if (RoutingBlock* leaf = findLeaf(*son, pVector)) {
+            return leaf;
+        }
     }
+    return nullptr;
 }
 
-void HierarchyManager::print(ds::amt::MWEHBlock<Node>& node) {
+void HierarchyManager::print(RoutingBlock& node) {
     size_t index = 0;
-    hierarchy.processLevelOrder(&node, std::function<void(ds::amt::MWEHBlock<Node>*)>([&](ds::amt::MWEHBlock<Node>* node) {
+    hierarchy.processLevelOrder(&node, [&](RoutingBlock* node) {
         if (node->data_.pData != nullptr && hierarchy.level(*node) == 4) {
             RoutingTableOperations::printRow(*node->data_.pData);
             ++index;
         }
-        }));
+        });
     std::cout << "-------------------------\nPrinted: " << index << " values" << std::endl;
 }
 
-void HierarchyManager::printNodeInfo(ds::amt::MWEHBlock<Node>& node) {
+void HierarchyManager::printNodeInfo(RoutingBlock& node) {
     if (node.parent_ == nullptr) {
         std::cout << "You are on root node!" << std::endl;
     } else {
         if (hierarchy.level(node) == 1) {
             std::cout << "Parent octet is root" << std::endl;
         } else {
-            std::cout << "Parent octet value: " << node.parent_->data_.octet.to_ulong() << std::endl;
+            std::cout << "Parent octet value: " << int(node.parent_->data_.octet) << std::endl;
         }
-        std::cout << "You are on octet number: " << hierarchy.level(node) << " Node octet value: " << node.data_.octet.to_ulong() << std::endl;
+        std::cout << "You are on octet number: " << hierarchy.level(node) << " Node octet value: " << int(node.data_.octet) << std::endl;
     }
     std::cout << "---------------------" << std::endl;
-    if (node.sons_->isEmpty()) {
+    if (hierarchy.isLeaf(node)) {
         std::cout << "No sons" << std::endl;
     } else {
         std::cout << "Number of sons: " << (hierarchy.degree(node)) << std::endl;
     }
 }
 
-void HierarchyManager::printSons(ds::amt::MWEHBlock<Node>& node) {
+void HierarchyManager::printSons(RoutingBlock& node) {
     std::cout << "---------------------" << std::endl;
-    if (!node.sons_->isEmpty()) {
+    if (!hierarchy.isLeaf(node)) {
         std::cout << "#   " << (hierarchy.level(node)) + 1 << ". Octet Values" << std::endl;
-        for (size_t i = 0; i < node.sons_->size(); ++i) {
-            std::cout << i << ". Son octet: " << node.sons_->access(i)->data_->data_.octet.to_ulong() << std::endl;
+        for (size_t i = 0; i < hierarchy.degree(node); ++i) {
+            std::cout << i << ". Son octet: " << int(hierarchy.accessSon(node, i)->data_.octet) << std::endl;
         }
     }
     std::cout << "---------------------" << std::endl;
 }
 
-std::string HierarchyManager::getOctetsToNode(ds::amt::MWEHBlock<Node>& node) {
+std::string HierarchyManager::getOctetsToNode(RoutingBlock& node) {
     switch (hierarchy.level(node)) {
     case 0:
         return "";
     case 1:
-        return std::to_string(node.data_.octet.to_ulong()) + ".";
+        return std::to_string(node.data_.octet) + ".";
     case 2:
-        return std::to_string(node.parent_->data_.octet.to_ulong()) + "." + std::to_string(node.data_.octet.to_ulong()) + ".";
+        return std::to_string(node.parent_->data_.octet) + "." + std::to_string(node.data_.octet) + ".";
     case 3:
-        return std::to_string(node.parent_->parent_->data_.octet.to_ulong()) + "." + std::to_string(node.parent_->data_.octet.to_ulong()) + "." + std::to_string(node.data_.octet.to_ulong()) + ".";
+        return std::to_string(node.parent_->parent_->data_.octet) + "." + std::to_string(node.parent_->data_.octet) + "." + std::to_string(node.data_.octet) + ".";
     case 4:
-        return std::to_string(node.parent_->parent_->parent_->data_.octet.to_ulong()) + "." + std::to_string(node.parent_->parent_->data_.octet.to_ulong()) + "." + std::to_string(node.parent_->data_.octet.to_ulong()) + "." + std::to_string(node.data_.octet.to_ulong()) + ".";
+        return std::to_string(node.parent_->parent_->parent_->data_.octet) + "." + std::to_string(node.parent_->parent_->data_.octet) + "." + std::to_string(node.parent_->data_.octet) + "." + std::to_string(node.data_.octet) + ".";
     default:
         return "";
     }
-}
\ No newline at end of file
+}
+
+// Pre-order filter like filtering with PreOrderHierarchyIterator.
+template<typename Pred>
+void HierarchyManager::filterByLifetime(RoutingBlock& node, unsigned int startTime, unsigned int endTime, Pred predicate, ds::amt::IS<Node*>& sequence) {
+    forEachInLifetime(node, startTime, endTime, [&predicate, &sequence](Node& data) {
+        if (predicate(data)) {
+            sequence.insertLast().data_ = &data;
+        }
+    });
+}
+
+// Rows of a subtree are the rows whose addresses start with the octets of the subtree, so rows found by the
+// lifetime index are intersected with the range of those addresses. Unsorted files repeat a branch of the
+// same octets and the copies share the range, then findLeaf tells whose rows they are. A leaf, or a subtree
+// with fewer nodes than rows found by the index, is walked instead. Rows are collected in the order of
+// slots, which is the pre-order of a sorted file.
+void HierarchyManager::filterByLifetime(RoutingBlock& node, unsigned int startTime, unsigned int endTime, RowStore& rows, ds::amt::IS<RoutingTableRow*>& sequence) {
+    std::vector<size_t> slots;
+    size_t level = hierarchy.level(node);
+    if (level == 4 || rows.countInLifetime(startTime, endTime) > hierarchy.nodeCount(node)) {
+        forEachInLifetime(node, startTime, endTime, [&rows, &slots](Node& data) {
+            slots.push_back(rows.slotOf(data.pData));
+        });
+        rows.collect(slots, sequence);
+        return;
+    }
+    uint32_t first = 0;
+    bool repeated = false;
+    RoutingBlock* block = &node;
+    for (size_t blockLevel = level; blockLevel > 0; --blockLevel) {
+        first |= static_cast<uint32_t>(block->data_.octet) << (32 - 8 * blockLevel);
+        RoutingBlock* parent = hierarchy.accessParent(*block);
+        for (size_t i = 0; i < hierarchy.degree(*parent) && !repeated; ++i) {
+            RoutingBlock* son = hierarchy.accessSon(*parent, i);
+            repeated = son != block && son->data_.octet == block->data_.octet;
+        }
+        block = parent;
+    }
+    uint32_t last = first | (UINT32_MAX >> (8 * level));
+    rows.forEachInLifetime(startTime, endTime, [&](size_t slot) {
+        RoutingTableRow& row = rows[slot];
+        if (row.ipAddress.address >= first && row.ipAddress.address <= last && (!repeated || findLeaf(node, &row) != nullptr)) {
+            slots.push_back(slot);
+        }
+    });
+    rows.collect(slots, sequence);
+}
+
+// Pre-order walk like PreOrderHierarchyIterator, subtrees whose lifetime range misses <startTime, endTime>
+// are skipped.
+template<typename Function>
+void HierarchyManager::forEachInLifetime(RoutingBlock& node, unsigned int startTime, unsigned int endTime, Function function) {
+    const LifetimeRange::ValueType& range = hierarchy.aggregate(node);
+    if (range.max < startTime || range.min > endTime) {
+        return;
+    }
+    if (matchLifetimeHierarchy(node.data_, startTime, endTime)) {
+        function(node.data_);
+    }
+    for (size_t i = 0; i < hierarchy.degree(node); ++i) {
+        forEachInLifetime(*hierarchy.accessSon(node, i), startTime, endTime, function);
+    }
+}
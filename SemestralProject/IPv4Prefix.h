@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <libds/heap_monitor.h>
+
+// IPv4 address packed into an integer with the first octet in the most significant byte, together with
+// the length of its prefix. Plain addresses (next hops, addresses to filter by) have a prefix of length 32.
+// Prefixes are ordered by address and then by length, which is the order of sorting by IP.
+struct IPv4Prefix {
+    uint32_t address = 0;
+    uint8_t length = 32;
+
+    static uint32_t maskOf(unsigned int length) {
+        return length == 0 ? 0 : UINT32_MAX << (32 - length);
+    }
+
+    uint32_t mask() const {
+        return maskOf(length);
+    }
+
+    uint32_t network() const {
+        return address & mask();
+    }
+
+    uint8_t octet(unsigned int index) const {
+        return static_cast<uint8_t>(address >> (24 - 8 * index));
+    }
+
+    bool contains(uint32_t otherAddress) const {
+        return ((address ^ otherAddress) & mask()) == 0;
+    }
+
+    bool contains(const IPv4Prefix& other) const {
+        return other.length >= length && contains(other.address);
+    }
+
+    std::string addressString() const {
+        return std::to_string(octet(0)) + "." + std::to_string(octet(1)) + "." + std::to_string(octet(2)) + "." + std::to_string(octet(3));
+    }
+
+    bool operator==(const IPv4Prefix& other) const {
+        return address == other.address && length == other.length;
+    }
+
+    bool operator!=(const IPv4Prefix& other) const {
+        return !(*this == other);
+    }
+
+    bool operator<(const IPv4Prefix& other) const {
+        return address != other.address ? address < other.address : length < other.length;
+    }
+
+    bool operator>(const IPv4Prefix& other) const {
+        return other < *this;
+    }
+};
+
+template<>
+struct std::hash<IPv4Prefix> {
+    size_t operator()(const IPv4Prefix& prefix) const {
+        return std::hash<uint64_t>()((uint64_t(prefix.address) << 8) | prefix.length);
+    }
+};
@@ -0,0 +1,142 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <libds/heap_monitor.h>
+
+// Slots of rows ordered by lifetime, so rows with lifetimes in a range are found by a binary search and read
+// as a contiguous run. Entries are kept in sorted blocks of at most 2 * BLOCK_SIZE entries and blocks are
+// ordered by their entries, which makes the index a B+-tree of two levels: a lookup searches the blocks and
+// then one block, a change moves entries of one block only. Entries with the same lifetime are ordered by
+// slot, so an entry is found exactly when its row is withdrawn or its lifetime changes.
+class LifetimeIndex {
+public:
+    static const size_t BLOCK_SIZE = 512;
+
+    struct Entry {
+        uint32_t lifetime;
+        uint32_t slot;
+
+        bool operator<(const Entry& other) const {
+            return lifetime != other.lifetime ? lifetime < other.lifetime : slot < other.slot;
+        }
+        bool operator==(const Entry& other) const {
+            return lifetime == other.lifetime && slot == other.slot;
+        }
+    };
+
+    size_t size() const;
+    void assign(std::vector<Entry>& entries);
+    void insert(Entry entry);
+    void erase(Entry entry);
+    size_t count(unsigned int startTime, unsigned int endTime) const;
+
+    template<typename Function>
+    void forEachInRange(unsigned int startTime, unsigned int endTime, Function function) const;
+
+private:
+    // First block whose last entry is not less than entry, the only block that may hold it.
+    size_t blockFor(const Entry& entry) const;
+
+    std::vector<std::vector<Entry>> blocks;
+    size_t entryCount = 0;
+};
+
+size_t LifetimeIndex::size() const {
+    return entryCount;
+}
+
+// Entries are sorted once and cut into full blocks.
+void LifetimeIndex::assign(std::vector<Entry>& entries) {
+    std::sort(entries.begin(), entries.end());
+    blocks.clear();
+    for (size_t start = 0; start < entries.size(); start += BLOCK_SIZE) {
+        size_t end = std::min(entries.size(), start + BLOCK_SIZE);
+        blocks.emplace_back(entries.begin() + start, entries.begin() + end);
+    }
+    entryCount = entries.size();
+}
+
+void LifetimeIndex::insert(Entry entry) {
+    // blockFor reads the last entry of blocks, so an empty block is never kept.
+    if (blocks.empty()) {
+        blocks.push_back({ entry });
+        ++entryCount;
+        return;
+    }
+    size_t index = std::min(blockFor(entry), blocks.size() - 1);
+    std::vector<Entry>& block = blocks[index];
+    block.insert(std::upper_bound(block.begin(), block.end(), entry), entry);
+    ++entryCount;
+    if (block.size() > 2 * BLOCK_SIZE) {
+        std::vector<Entry> upperHalf(block.begin() + BLOCK_SIZE, block.end());
+        block.resize(BLOCK_SIZE);
+        blocks.insert(blocks.begin() + index + 1, std::move(upperHalf));
+    }
+}
+
+void LifetimeIndex::erase(Entry entry) {
+    size_t index = blockFor(entry);
+    if (index == blocks.size()) {
+        throw std::logic_error("Lifetime is not in the index!");
+    }
+    std::vector<Entry>& block = blocks[index];
+    auto position = std::lower_bound(block.begin(), block.end(), entry);
+    if (position == block.end() || !(*position == entry)) {
+        throw std::logic_error("Lifetime is not in the index!");
+    }
+    block.erase(position);
+    --entryCount;
+    if (block.empty()) {
+        blocks.erase(blocks.begin() + index);
+    }
+}
+
+// Blocks between the first and the last entry of the range are counted by their sizes.
+size_t LifetimeIndex::count(unsigned int startTime, unsigned int endTime) const {
+    if (startTime > endTime) {
+        return 0;
+    }
+    Entry first = { startTime, 0 };
+    Entry last = { endTime, UINT32_MAX };
+    size_t firstBlock = blockFor(first);
+    size_t lastBlock = blockFor(last);
+    if (firstBlock == blocks.size()) {
+        return 0;
+    }
+    const std::vector<Entry>& block = blocks[firstBlock];
+    size_t result = static_cast<size_t>(block.end() - std::lower_bound(block.begin(), block.end(), first));
+    for (size_t index = firstBlock + 1; index <= lastBlock && index < blocks.size(); ++index) {
+        result += blocks[index].size();
+    }
+    if (lastBlock < blocks.size()) {
+        const std::vector<Entry>& end = blocks[lastBlock];
+        result -= static_cast<size_t>(end.end() - std::upper_bound(end.begin(), end.end(), last));
+    }
+    return result;
+}
+
+// Calls function with slots of rows with lifetimes in <startTime, endTime> in the order of lifetimes.
+template<typename Function>
+void LifetimeIndex::forEachInRange(unsigned int startTime, unsigned int endTime, Function function) const {
+    if (startTime > endTime) {
+        return;
+    }
+    Entry first = { startTime, 0 };
+    for (size_t index = blockFor(first); index < blocks.size(); ++index) {
+        const std::vector<Entry>& block = blocks[index];
+        for (auto it = std::lower_bound(block.begin(), block.end(), first); it != block.end(); ++it) {
+            if (it->lifetime > endTime) {
+                return;
+            }
+            function(static_cast<size_t>(it->slot));
+        }
+    }
+}
+
+size_t LifetimeIndex::blockFor(const Entry& entry) const {
+    return std::partition_point(blocks.begin(), blocks.end(), [&entry](const std::vector<Entry>& block) {
+        return block.back() < entry;
+    }) - blocks.begin();
+}
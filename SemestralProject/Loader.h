@@ -1,53 +1,177 @@
 #include "HierarchyManager.h"
 #include "TableManager.h"
+#include "PrefixTrie.h"
 #include "RoutingTable.h"
+#include "MappedFile.h"
+#include <array>
+#include <cstring>
+#include <libds/exec/thread_pool.h>
 #include <libds/heap_monitor.h>
 
+// Loads the routing table from a memory mapped CSV file. Lines and cells are string_views into the mapping,
+// so no line is copied and no cell is allocated, parsed rows are the only data written while loading.
+// The file is split at line breaks into chunks of about CHUNK_SIZE bytes parsed in parallel, each into its
+// own row buffer. Chunks do not know their first line number, so their messages keep lines relative to the
+// chunk and the merge stage prints them in file order with line numbers of the file. The merge stage copies
+// the rows into the store and then builds the hierarchy, the destination table and the prefix trie, which
+// are independent of each other, in parallel.
 class Loader {
 public:
-    static void loadFromCSV(const std::string& filename, std::vector<RoutingTableRow>& saveToVector, HierarchyManager& hierarchy, TableManager& tableManager);
+    static const size_t MAX_CELLS = 6;
+    static const size_t CHUNK_SIZE = size_t(1) << 20;
+
+    static void loadFromCSV(const std::string& filename, RowStore& rows, HierarchyManager& hierarchy, TableManager& tableManager, PrefixTrie& prefixTrie,
+                            ds::exec::ThreadPool& pool = ds::exec::ThreadPool::getDefault());
+
+private:
+    struct Message {
+        size_t line;
+        bool isError;
+        std::string text;
+    };
+
+    struct ParsedChunk {
+        std::vector<RoutingTableRow> rows;
+        std::vector<Message> messages;
+        size_t lineCount = 0;
+        // Line with an invalid number of cells, parsing of the chunk stops at it.
+        size_t invalidLine = 0;
+    };
+
+    static std::vector<std::string_view> splitChunks(std::string_view contents);
+    static void parseChunk(std::string_view chunk, ParsedChunk& parsed);
+    static size_t splitCells(std::string_view line, std::array<std::string_view, MAX_CELLS>& cells);
+    static std::string_view nextLine(std::string_view contents, size_t& position);
 };
 
-void Loader::loadFromCSV(const std::string& filename, std::vector<RoutingTableRow>& saveToVector, HierarchyManager& hierarchy, TableManager& tableManager) {
-    std::ifstream file(filename);
-    saveToVector.reserve(20000);
-    if (!file.is_open()) {
-        throw std::runtime_error("Error: Could not open file.\n");
+void Loader::loadFromCSV(const std::string& filename, RowStore& rows, HierarchyManager& hierarchy, TableManager& tableManager, PrefixTrie& prefixTrie,
+                         ds::exec::ThreadPool& pool) {
+    MappedFile file(filename);
+    std::string_view contents = file.contents();
+    size_t position = 0;
+    if (!contents.empty()) {
+        nextLine(contents, position);
+    }
+    std::vector<std::string_view> chunks = splitChunks(contents.substr(std::min(position, contents.size())));
+    std::vector<ParsedChunk> parsedChunks(chunks.size());
+    pool.parallelFor(0, chunks.size(), 1, [&chunks, &parsedChunks](size_t i) {
+        parseChunk(chunks[i], parsedChunks[i]);
+    });
+
+    size_t rowCount = 0;
+    for (const ParsedChunk& parsed : parsedChunks) {
+        rowCount += parsed.rows.size();
+    }
+    rows.reserve(rows.slotCount() + rowCount);
+    size_t firstRow = rows.slotCount();
+    size_t rowNumber = 1;
+    for (const ParsedChunk& parsed : parsedChunks) {
+        for (const Message& message : parsed.messages) {
+            (message.isError ? std::cerr : std::cout) << message.text << rowNumber + message.line << std::endl;
+        }
+        if (parsed.invalidLine != 0) {
+            throw std::runtime_error("Error: Invalid CSV format. Error found on line: " + std::to_string(rowNumber + parsed.invalidLine) + "\n");
+        }
+        for (const RoutingTableRow& row : parsed.rows) {
+            rows.append(row);
+        }
+        rowNumber += parsed.lineCount;
     }
-    std::string line;
-    unsigned int rowNumber = 1;
-    std::getline(file, line);
-    while (std::getline(file, line)) {
-        ++rowNumber;
-        std::istringstream ss(line);
-        std::vector<std::string> cells;
-        std::string cell;
-        while (std::getline(ss, cell, ';')) {
-            cells.push_back(cell);
-        }
-        if (cells.size() == 5 || cells.size() == 4) {
-            RoutingTableRow entry;
+    parsedChunks.clear();
+
+    ds::exec::TaskGroup group(pool);
+    group.run([&rows, &hierarchy, firstRow]() {
+        hierarchy.hierarchy.deferAggregates();
+        for (size_t i = firstRow; i < rows.slotCount(); ++i) {
+            hierarchy.addBranch(rows[i].ipAddress, &rows[i]);
+        }
+        hierarchy.hierarchy.resumeAggregates();
+    });
+    group.run([&rows, &tableManager, firstRow]() {
+        for (size_t i = firstRow; i < rows.slotCount(); ++i) {
+            tableManager.addEntry(rows[i].destinationIP, &rows[i]);
+        }
+    });
+    prefixTrie.build(rows);
+    group.wait();
+}
+
+// Every chunk except the last one ends right after a line break, so no line is split between two chunks.
+std::vector<std::string_view> Loader::splitChunks(std::string_view contents) {
+    std::vector<std::string_view> chunks;
+    size_t start = 0;
+    while (start < contents.size()) {
+        size_t end = contents.size();
+        if (contents.size() - start > CHUNK_SIZE) {
+            const char* lineBreak = static_cast<const char*>(std::memchr(contents.data() + start + CHUNK_SIZE, '\n', contents.size() - start - CHUNK_SIZE));
+            end = lineBreak != nullptr ? lineBreak - contents.data() + 1 : contents.size();
+        }
+        chunks.push_back(contents.substr(start, end - start));
+        start = end;
+    }
+    return chunks;
+}
+
+void Loader::parseChunk(std::string_view chunk, ParsedChunk& parsed) {
+    parsed.rows.reserve(std::count(chunk.begin(), chunk.end(), '\n') + 1);
+    std::array<std::string_view, MAX_CELLS> cells;
+    size_t position = 0;
+    while (position < chunk.size()) {
+        std::string_view line = nextLine(chunk, position);
+        size_t lineNumber = ++parsed.lineCount;
+        size_t cellCount = splitCells(line, cells);
+        if (cellCount != 5 && cellCount != 4) {
+            parsed.invalidLine = lineNumber;
+            return;
+        }
+        RoutingTableRow entry;
+        try {
+            entry.ipAddress = RoutingTableOperations::processIPAddress(cells[1]);
+        } catch (const std::exception& e) {
+            parsed.messages.push_back({ lineNumber, true, "Error: " + std::string(e.what()) + " Check line " });
+            continue;
+        }
+        if (cells[3].substr(0, 3) == "via") {
             try {
-                entry.ipAddress = RoutingTableOperations::processIPAddress(cells[1], &entry.prefix);
+                entry.destinationIP = RoutingTableOperations::processIPAddress(cells[3].substr(cells[3].size() > 3 && cells[3][3] == ' ' ? 4 : 3));
             } catch (const std::exception& e) {
-                std::cerr << "Error: " << e.what() << " Check line " << rowNumber << std::endl;
+                parsed.messages.push_back({ lineNumber, true, "Error: " + std::string(e.what()) + " Check line " });
                 continue;
             }
-            if (cells[3][0] == 'v' && cells[3][1] == 'i' && cells[3][2] == 'a') {
-                entry.destinationIP = cells[3][3] == ' ' ? RoutingTableOperations::processIPAddress(cells[3].substr(4), nullptr) : RoutingTableOperations::processIPAddress(cells[3].substr(3), nullptr);
-            } else {
-                std::cout << "Supported only next-hop ip address, check line " << rowNumber << std::endl;
-            }
-            if (cells.size() > 4 && (std::isdigit(cells[4][0]) || std::isalpha(cells[4][0]))) {
-                entry.lifetime = RoutingTableOperations::processLifetime(cells[4]);
-            } else {
-                entry.lifetime = UINT_MAX;
-            }
-            saveToVector.push_back(entry);
-            hierarchy.addBranch(entry.ipAddress, &saveToVector.back());
-            tableManager.addEntry(entry.destinationIP, &saveToVector.back());
         } else {
-            throw std::runtime_error("Error: Invalid CSV format. Error found on line: " + std::to_string(rowNumber) + "\n");
+            parsed.messages.push_back({ lineNumber, false, "Supported only next-hop ip address, check line " });
         }
+        if (cellCount > 4 && !cells[4].empty() && (std::isdigit(cells[4][0]) || std::isalpha(cells[4][0]))) {
+            entry.lifetime = RoutingTableOperations::processLifetime(cells[4]);
+        } else {
+            entry.lifetime = UINT_MAX;
+        }
+        parsed.rows.push_back(entry);
+    }
+}
+
+// Like reading cells with std::getline, an empty cell after the last separator is not counted. Lines with
+// more than MAX_CELLS cells report MAX_CELLS, which is never a valid count.
+size_t Loader::splitCells(std::string_view line, std::array<std::string_view, MAX_CELLS>& cells) {
+    size_t count = 0;
+    size_t start = 0;
+    while (start < line.size() && count < MAX_CELLS) {
+        const char* separator = static_cast<const char*>(std::memchr(line.data() + start, ';', line.size() - start));
+        size_t end = separator != nullptr ? separator - line.data() : line.size();
+        cells[count++] = line.substr(start, end - start);
+        start = end + 1;
+    }
+    return count;
+}
+
+// Returns the line starting at position without its line break and moves position to the next line.
+std::string_view Loader::nextLine(std::string_view contents, size_t& position) {
+    const char* lineBreak = static_cast<const char*>(std::memchr(contents.data() + position, '\n', contents.size() - position));
+    size_t end = lineBreak != nullptr ? lineBreak - contents.data() : contents.size();
+    std::string_view line = contents.substr(position, end - position);
+    position = end + 1;
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
     }
-}
\ No newline at end of file
+    return line;
+}
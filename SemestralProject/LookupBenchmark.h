@@ -0,0 +1,70 @@
+#pragma once
+#include "PrefixTrie.h"
+#include <chrono>
+#include <random>
+#include <libds/heap_monitor.h>
+
+// Throughput of longest prefix match lookups on the loaded routing table scaled up SCALE times. Copy c of
+// every row has its first octet XORed with c, so the scaled trie has SCALE times more nodes than the loaded
+// one and no longer fits into caches. Addresses are taken from random routes with random host bits, so
+// lookups descend to the levels of the routes instead of stopping at the root.
+class LookupBenchmark {
+public:
+    static const unsigned int SCALE = 256;
+    static const size_t LOOKUP_COUNT = size_t(1) << 22;
+
+    static void run(const RowStore& loadedRoutingTable);
+
+private:
+    static double lookupsPerSecond(std::chrono::steady_clock::duration duration);
+};
+
+void LookupBenchmark::run(const RowStore& loadedRoutingTable) {
+    if (loadedRoutingTable.empty()) {
+        std::cout << "No routes to benchmark!" << std::endl;
+        return;
+    }
+
+    RowStore scaledRoutingTable;
+    scaledRoutingTable.reserve(loadedRoutingTable.size() * SCALE);
+    for (unsigned int copy = 0; copy < SCALE; ++copy) {
+        for (const RoutingTableRow& row : loadedRoutingTable) {
+            RoutingTableRow scaledRow = row;
+            scaledRow.ipAddress.address ^= copy << 24;
+            scaledRoutingTable.append(scaledRow);
+        }
+    }
+    PrefixTrie prefixTrie;
+    prefixTrie.build(scaledRoutingTable);
+
+    std::mt19937 generator(144);
+    std::vector<uint32_t> ipAddresses(LOOKUP_COUNT);
+    for (uint32_t& ipAddress : ipAddresses) {
+        const RoutingTableRow& row = scaledRoutingTable[generator() % scaledRoutingTable.size()];
+        uint32_t hostMask = ~row.ipAddress.mask();
+        ipAddress = row.ipAddress.network() | (generator() & hostMask);
+    }
+
+    std::vector<const RoutingTableRow*> scalarResults(LOOKUP_COUNT);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < LOOKUP_COUNT; ++i) {
+        scalarResults[i] = prefixTrie.lookup(ipAddresses[i]);
+    }
+    auto scalarDuration = std::chrono::steady_clock::now() - start;
+
+    std::vector<const RoutingTableRow*> batchResults(LOOKUP_COUNT);
+    start = std::chrono::steady_clock::now();
+    prefixTrie.lookupBatch(ipAddresses.data(), LOOKUP_COUNT, batchResults.data());
+    auto batchDuration = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Routes: " << scaledRoutingTable.size() << ", trie nodes: " << prefixTrie.nodeCount() << ", lookups: " << LOOKUP_COUNT << std::endl;
+    std::cout << "lookup:      " << static_cast<size_t>(lookupsPerSecond(scalarDuration)) << " lookups/s" << std::endl;
+    std::cout << "lookupBatch: " << static_cast<size_t>(lookupsPerSecond(batchDuration)) << " lookups/s" << std::endl;
+    if (scalarResults != batchResults) {
+        std::cout << "Results of lookup and lookupBatch differ!" << std::endl;
+    }
+}
+
+double LookupBenchmark::lookupsPerSecond(std::chrono::steady_clock::duration duration) {
+    return LOOKUP_COUNT / std::chrono::duration<double>(duration).count();
+}
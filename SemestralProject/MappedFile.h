@@ -0,0 +1,113 @@
+#pragma once
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <libds/heap_monitor.h>
+
+// Read-only view of a whole file mapped into memory. Pages are loaded by the OS on first access, so the file
+// is never copied into buffers of the program and its contents can be tokenized in place.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view contents() const;
+
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& filename) {
+    file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    LARGE_INTEGER fileSize;
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize)) {
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+        throw std::runtime_error("Error: Could not open file.\n");
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+    // Empty files can not be mapped, they are left as an empty view.
+    if (size > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        data = mapping != nullptr ? static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+        if (data == nullptr) {
+            if (mapping != nullptr) {
+                CloseHandle(mapping);
+            }
+            CloseHandle(file);
+            throw std::runtime_error("Error: Could not map file.\n");
+        }
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& filename) {
+    int descriptor = open(filename.c_str(), O_RDONLY);
+    struct stat fileStat;
+    if (descriptor < 0 || fstat(descriptor, &fileStat) != 0) {
+        if (descriptor >= 0) {
+            close(descriptor);
+        }
+        throw std::runtime_error("Error: Could not open file.\n");
+    }
+    size = static_cast<size_t>(fileStat.st_size);
+    // Empty files can not be mapped, they are left as an empty view.
+    if (size > 0) {
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapped == MAP_FAILED) {
+            close(descriptor);
+            throw std::runtime_error("Error: Could not map file.\n");
+        }
+        madvise(mapped, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(mapped);
+    }
+    // The mapping keeps its own reference to the file.
+    close(descriptor);
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr) {
+        munmap(const_cast<char*>(data), size);
+    }
+}
+
+#endif
+
+std::string_view MappedFile::contents() const {
+    return std::string_view(data, size);
+}
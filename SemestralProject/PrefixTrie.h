@@ -0,0 +1,438 @@
+#pragma once
+#include "RowStore.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <libds/prefetch.h>
+#include <libds/heap_monitor.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PREFIX_TRIE_SSE2
+#endif
+
+// Multibit trie with a stride of 8 bits answering longest prefix match queries over the loaded routes.
+// Every trie node covers one octet of an address with 256 slots. A route with prefix length L is expanded
+// to all slots of level (L - 1) / 8 that share its first L bits, so a lookup reads at most one slot per
+// octet. Routes are inserted from the shortest one, longer routes overwrite slots of shorter ones and
+// a lookup keeps the last route found on its way down. Every route also remembers the longest route
+// covering it, so all matches of an address are the chain starting at its best match.
+// Routes are added and withdrawn in place. An added route takes over the slots of shorter routes in its range
+// and the chains of longer routes inside it. A withdrawn route stays in the chains as a tombstone skipped by
+// allMatches, only the slots it held are given to the next live route covering it. Once tombstones make up
+// more than half of the routes, compact drops them and renumbers the live routes.
+// lookupBatch resolves addresses in groups of BATCH_GROUP_SIZE and walks their paths level by level. Slots
+// of the next level are prefetched for the whole group before any of them is read, so misses of different
+// addresses overlap instead of following each other.
+class PrefixTrie {
+public:
+    static constexpr size_t BATCH_GROUP_SIZE = 16;
+
+    PrefixTrie();
+    void build(RowStore& rows);
+    void add(RoutingTableRow* row);
+    void remove(const RoutingTableRow* row);
+    RoutingTableRow* find(const IPv4Prefix& prefix, const IPv4Prefix& destination) const;
+    RoutingTableRow* lookup(uint32_t ipAddress) const;
+    void lookupBatch(const uint32_t* ipAddresses, size_t count, const RoutingTableRow** out) const;
+    void allMatches(uint32_t ipAddress, ds::amt::IS<RoutingTableRow*>& sequence) const;
+    size_t nodeCount() const;
+    size_t routeCount() const;
+
+private:
+    friend class Snapshot;
+
+    static const uint32_t NONE = UINT32_MAX;
+
+    struct Slot {
+        uint32_t route = NONE;
+        uint32_t child = 0;
+    };
+
+    struct TrieNode {
+        std::array<Slot, 256> slots;
+    };
+
+    struct Route {
+        // Null for a withdrawn route.
+        RoutingTableRow* row;
+        uint32_t cover;
+        uint8_t length;
+    };
+
+    static unsigned int octetOf(uint32_t ipAddress, unsigned int level);
+    static unsigned int levelOf(unsigned int length);
+    static void octetsOf(const uint32_t* ipAddresses, size_t count, unsigned int level, uint32_t* octets);
+    uint32_t lookupRoute(uint32_t ipAddress) const;
+    uint32_t findNode(uint32_t network, unsigned int level) const;
+    uint32_t findRoute(const IPv4Prefix& prefix, const IPv4Prefix* destination, const RoutingTableRow* row) const;
+    void insert(uint32_t routeIndex);
+    void takeOverChains(uint32_t routeIndex, uint32_t node);
+    void relinkChain(uint32_t route, uint32_t routeIndex);
+    void compact();
+
+    std::vector<TrieNode> nodes;
+    std::vector<Route> routes;
+    size_t tombstoneCount;
+};
+
+PrefixTrie::PrefixTrie() : nodes(1), tombstoneCount(0) {
+}
+
+void PrefixTrie::build(RowStore& rows) {
+    nodes.assign(1, TrieNode());
+    routes.clear();
+    tombstoneCount = 0;
+    routes.reserve(rows.size());
+
+    // Shorter prefixes first. Among rows with the same prefix length the first loaded row is inserted last,
+    // so it is the best match and its duplicates follow it in the chain of covering routes.
+    std::vector<size_t> order;
+    order.reserve(rows.size());
+    for (size_t slot = 0; slot < rows.slotCount(); ++slot) {
+        if (rows.isLive(slot)) {
+            order.push_back(slot);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&rows](size_t first, size_t second) {
+        if (rows[first].ipAddress.length != rows[second].ipAddress.length) {
+            return rows[first].ipAddress.length < rows[second].ipAddress.length;
+        }
+        return first > second;
+    });
+
+    for (size_t index : order) {
+        RoutingTableRow& row = rows[index];
+        routes.push_back({ &row, lookupRoute(row.ipAddress.network()), row.ipAddress.length });
+        insert(static_cast<uint32_t>(routes.size() - 1));
+    }
+}
+
+// The route covering the new one is the first route not longer than it in the chain of the slot at the level
+// of the new route. A live route with the same prefix keeps its slots and the new route goes after it.
+void PrefixTrie::add(RoutingTableRow* row) {
+    uint32_t network = row->ipAddress.network();
+    unsigned int length = row->ipAddress.length;
+    unsigned int targetLevel = levelOf(length);
+    uint32_t routeIndex = static_cast<uint32_t>(routes.size());
+
+    uint32_t cover = NONE;
+    uint32_t node = 0;
+    for (unsigned int level = 0; level <= targetLevel && node != NONE; ++level) {
+        const Slot& slot = nodes[node].slots[octetOf(network, level)];
+        if (slot.route != NONE) {
+            cover = slot.route;
+        }
+        node = slot.child != 0 ? slot.child : NONE;
+    }
+    while (cover != NONE && routes[cover].length > length) {
+        cover = routes[cover].cover;
+    }
+
+    uint32_t last = NONE;
+    bool hasLiveDuplicate = false;
+    for (uint32_t route = cover; route != NONE && routes[route].length == length; route = routes[route].cover) {
+        hasLiveDuplicate = hasLiveDuplicate || routes[route].row != nullptr;
+        last = route;
+    }
+    if (hasLiveDuplicate) {
+        routes.push_back({ row, routes[last].cover, static_cast<uint8_t>(length) });
+        routes[last].cover = routeIndex;
+        return;
+    }
+
+    routes.push_back({ row, cover, static_cast<uint8_t>(length) });
+    insert(routeIndex);
+    takeOverChains(routeIndex, findNode(network, targetLevel));
+}
+
+void PrefixTrie::remove(const RoutingTableRow* row) {
+    uint32_t routeIndex = findRoute(row->ipAddress, nullptr, row);
+    if (routeIndex == NONE) {
+        throw std::logic_error("Route is not in the trie!");
+    }
+    routes[routeIndex].row = nullptr;
+
+    uint32_t next = routes[routeIndex].cover;
+    while (next != NONE && routes[next].row == nullptr) {
+        next = routes[next].cover;
+    }
+    unsigned int targetLevel = levelOf(routes[routeIndex].length);
+    // Routes of upper levels are found on the way down, they are never stored in slots of this level.
+    if (next != NONE && levelOf(routes[next].length) != targetLevel) {
+        next = NONE;
+    }
+    uint32_t node = findNode(row->ipAddress.network(), targetLevel);
+    unsigned int first = octetOf(row->ipAddress.network(), targetLevel);
+    unsigned int count = 1u << (8 * (targetLevel + 1) - routes[routeIndex].length);
+    for (unsigned int slot = first; slot < first + count; ++slot) {
+        if (nodes[node].slots[slot].route == routeIndex) {
+            nodes[node].slots[slot].route = next;
+        }
+    }
+
+    if (++tombstoneCount > routes.size() / 2) {
+        compact();
+    }
+}
+
+RoutingTableRow* PrefixTrie::find(const IPv4Prefix& prefix, const IPv4Prefix& destination) const {
+    uint32_t route = findRoute(prefix, &destination, nullptr);
+    return route != NONE ? routes[route].row : nullptr;
+}
+
+RoutingTableRow* PrefixTrie::lookup(uint32_t ipAddress) const {
+    uint32_t route = lookupRoute(ipAddress);
+    return route != NONE ? routes[route].row : nullptr;
+}
+
+void PrefixTrie::lookupBatch(const uint32_t* ipAddresses, size_t count, const RoutingTableRow** out) const {
+    uint32_t octets[BATCH_GROUP_SIZE];
+    uint32_t nextOctets[BATCH_GROUP_SIZE];
+    uint32_t current[BATCH_GROUP_SIZE];
+    uint32_t best[BATCH_GROUP_SIZE];
+    for (size_t groupStart = 0; groupStart < count; groupStart += BATCH_GROUP_SIZE) {
+        const uint32_t* ips = ipAddresses + groupStart;
+        size_t groupSize = std::min(BATCH_GROUP_SIZE, count - groupStart);
+
+        // The root is read by every lookup and stays cached, its slots are read without prefetching.
+        octetsOf(ips, groupSize, 0, octets);
+        octetsOf(ips, groupSize, 1, nextOctets);
+        bool anyActive = false;
+        for (size_t i = 0; i < groupSize; ++i) {
+            const Slot& slot = nodes[0].slots[octets[i]];
+            best[i] = slot.route;
+            current[i] = slot.child;
+            if (slot.child != 0) {
+                ds::prefetch(&nodes[slot.child].slots[nextOctets[i]]);
+                anyActive = true;
+            }
+        }
+
+        for (unsigned int level = 1; level < 4 && anyActive; ++level) {
+            std::swap(octets, nextOctets);
+            if (level < 3) {
+                octetsOf(ips, groupSize, level + 1, nextOctets);
+            }
+            anyActive = false;
+            for (size_t i = 0; i < groupSize; ++i) {
+                if (current[i] == 0) {
+                    continue;
+                }
+                const Slot& slot = nodes[current[i]].slots[octets[i]];
+                if (slot.route != NONE) {
+                    best[i] = slot.route;
+                }
+                // Nodes of the last level never have children.
+                current[i] = slot.child;
+                if (slot.child != 0) {
+                    ds::prefetch(&nodes[slot.child].slots[nextOctets[i]]);
+                    anyActive = true;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < groupSize; ++i) {
+            if (best[i] != NONE) {
+                ds::prefetch(&routes[best[i]]);
+            }
+        }
+        for (size_t i = 0; i < groupSize; ++i) {
+            out[groupStart + i] = best[i] != NONE ? routes[best[i]].row : nullptr;
+        }
+    }
+}
+
+void PrefixTrie::allMatches(uint32_t ipAddress, ds::amt::IS<RoutingTableRow*>& sequence) const {
+    for (uint32_t route = lookupRoute(ipAddress); route != NONE; route = routes[route].cover) {
+        if (routes[route].row != nullptr) {
+            sequence.insertLast().data_ = routes[route].row;
+        }
+    }
+}
+
+size_t PrefixTrie::nodeCount() const {
+    return nodes.size();
+}
+
+// Withdrawn routes are counted until the next compaction.
+size_t PrefixTrie::routeCount() const {
+    return routes.size();
+}
+
+unsigned int PrefixTrie::octetOf(uint32_t ipAddress, unsigned int level) {
+    return (ipAddress >> (24 - 8 * level)) & 0xFF;
+}
+
+unsigned int PrefixTrie::levelOf(unsigned int length) {
+    return length == 0 ? 0 : (length - 1) / 8;
+}
+
+void PrefixTrie::octetsOf(const uint32_t* ipAddresses, size_t count, unsigned int level, uint32_t* octets) {
+    size_t i = 0;
+#ifdef PREFIX_TRIE_SSE2
+    const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(24 - 8 * level));
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    for (; i + 4 <= count; i += 4) {
+        __m128i ips = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ipAddresses + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(octets + i), _mm_and_si128(_mm_srl_epi32(ips, shift), mask));
+    }
+#endif
+    for (; i < count; ++i) {
+        octets[i] = octetOf(ipAddresses[i], level);
+    }
+}
+
+uint32_t PrefixTrie::lookupRoute(uint32_t ipAddress) const {
+    uint32_t best = NONE;
+    uint32_t node = 0;
+    for (unsigned int level = 0; level < 4; ++level) {
+        const Slot& slot = nodes[node].slots[octetOf(ipAddress, level)];
+        if (slot.route != NONE) {
+            best = slot.route;
+        }
+        if (slot.child == 0) {
+            break;
+        }
+        node = slot.child;
+    }
+    return best;
+}
+
+// Node of the given level on the path of network, NONE when the path ends above it.
+uint32_t PrefixTrie::findNode(uint32_t network, unsigned int level) const {
+    uint32_t node = 0;
+    for (unsigned int i = 0; i < level; ++i) {
+        node = nodes[node].slots[octetOf(network, i)].child;
+        if (node == 0) {
+            return NONE;
+        }
+    }
+    return node;
+}
+
+// Walks the chain of the first slot of the prefix, which holds every route with the prefix. Matches a live
+// route with the given destination or the route of the given row.
+uint32_t PrefixTrie::findRoute(const IPv4Prefix& prefix, const IPv4Prefix* destination, const RoutingTableRow* row) const {
+    uint32_t network = prefix.network();
+    unsigned int targetLevel = levelOf(prefix.length);
+    uint32_t node = findNode(network, targetLevel);
+    if (node == NONE) {
+        return NONE;
+    }
+    for (uint32_t route = nodes[node].slots[octetOf(network, targetLevel)].route; route != NONE && routes[route].length >= prefix.length; route = routes[route].cover) {
+        const RoutingTableRow* routeRow = routes[route].row;
+        if (row != nullptr ? routeRow == row
+                           : routeRow != nullptr && routes[route].length == prefix.length && routeRow->ipAddress.network() == network && routeRow->destinationIP == *destination) {
+            return route;
+        }
+    }
+    return NONE;
+}
+
+// Longer routes inside the range of a new route are found in its slots and in the nodes below them.
+void PrefixTrie::takeOverChains(uint32_t routeIndex, uint32_t node) {
+    unsigned int length = routes[routeIndex].length;
+    unsigned int targetLevel = levelOf(length);
+    unsigned int first = octetOf(routes[routeIndex].row->ipAddress.network(), targetLevel);
+    unsigned int count = 1u << (8 * (targetLevel + 1) - length);
+
+    std::vector<uint32_t> pending;
+    for (unsigned int slot = first; slot < first + count; ++slot) {
+        relinkChain(nodes[node].slots[slot].route, routeIndex);
+        if (nodes[node].slots[slot].child != 0) {
+            pending.push_back(nodes[node].slots[slot].child);
+        }
+    }
+    while (!pending.empty()) {
+        uint32_t child = pending.back();
+        pending.pop_back();
+        for (const Slot& slot : nodes[child].slots) {
+            relinkChain(slot.route, routeIndex);
+            if (slot.child != 0) {
+                pending.push_back(slot.child);
+            }
+        }
+    }
+}
+
+// The chain passes from routes longer than the new route straight to shorter ones, that step now leads to it.
+void PrefixTrie::relinkChain(uint32_t route, uint32_t routeIndex) {
+    unsigned int length = routes[routeIndex].length;
+    while (route != NONE && routes[route].length > length) {
+        uint32_t next = routes[route].cover;
+        if (next == routeIndex) {
+            return;
+        }
+        if (next == NONE || routes[next].length <= length) {
+            routes[route].cover = routeIndex;
+            return;
+        }
+        route = next;
+    }
+}
+
+void PrefixTrie::insert(uint32_t routeIndex) {
+    const Route& route = routes[routeIndex];
+    uint32_t network = route.row->ipAddress.network();
+    unsigned int length = route.length;
+    unsigned int targetLevel = levelOf(length);
+
+    uint32_t node = 0;
+    for (unsigned int level = 0; level < targetLevel; ++level) {
+        unsigned int octet = octetOf(network, level);
+        if (nodes[node].slots[octet].child == 0) {
+            uint32_t child = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+            nodes[node].slots[octet].child = child;
+        }
+        node = nodes[node].slots[octet].child;
+    }
+
+    unsigned int bits = length - 8 * targetLevel;
+    unsigned int first = octetOf(network, targetLevel);
+    unsigned int count = 1u << (8 - bits);
+    // Slots of longer routes of the same level are kept, they are more specific.
+    for (unsigned int slot = first; slot < first + count; ++slot) {
+        uint32_t& slotRoute = nodes[node].slots[slot].route;
+        if (slotRoute == NONE || routes[slotRoute].length <= length) {
+            slotRoute = routeIndex;
+        }
+    }
+}
+
+// Slots never hold a withdrawn route, so only chains have to skip them. A chain keeps its order, every live
+// route just gets the index it has among the live routes.
+void PrefixTrie::compact() {
+    std::vector<uint32_t> liveIndex(routes.size());
+    uint32_t liveCount = 0;
+    for (size_t route = 0; route < routes.size(); ++route) {
+        if (routes[route].row != nullptr) {
+            liveIndex[route] = liveCount++;
+        } else {
+            liveIndex[route] = NONE;
+        }
+    }
+
+    std::vector<Route> liveRoutes;
+    liveRoutes.reserve(liveCount);
+    for (const Route& route : routes) {
+        if (route.row != nullptr) {
+            uint32_t cover = route.cover;
+            while (cover != NONE && routes[cover].row == nullptr) {
+                cover = routes[cover].cover;
+            }
+            liveRoutes.push_back({ route.row, cover != NONE ? liveIndex[cover] : NONE, route.length });
+        }
+    }
+    for (TrieNode& node : nodes) {
+        for (Slot& slot : node.slots) {
+            if (slot.route != NONE) {
+                slot.route = liveIndex[slot.route];
+            }
+        }
+    }
+
+    routes.swap(liveRoutes);
+    tombstoneCount = 0;
+}
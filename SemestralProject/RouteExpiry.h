@@ -0,0 +1,77 @@
+#pragma once
+#include "RowStore.h"
+#include "TimingWheel.h"
+#include <chrono>
+#include <functional>
+#include <libds/heap_monitor.h>
+
+// Withdraws routes whose lifetimes passed. A route expires its lifetime in seconds after it was scheduled,
+// routes without a lifetime (UINT_MAX) never expire. Routes are timers of a timing wheel identified by the
+// slots of their rows. Time is read from the clock in seconds, a test passes its own clock to move time.
+class RouteExpiry {
+public:
+    using Clock = std::function<uint64_t()>;
+
+    static uint64_t steadyClock();
+
+    explicit RouteExpiry(RowStore& rows, Clock clock = steadyClock);
+
+    size_t size() const;
+    void scheduleAll();
+    void schedule(const RoutingTableRow* row);
+    void cancel(const RoutingTableRow* row);
+
+    template<typename Function>
+    size_t expire(Function withdraw);
+
+private:
+    RowStore& rows;
+    Clock clock;
+    TimingWheel wheel;
+};
+
+uint64_t RouteExpiry::steadyClock() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+RouteExpiry::RouteExpiry(RowStore& rows, Clock clock) : rows(rows), clock(std::move(clock)), wheel(this->clock()) {
+}
+
+size_t RouteExpiry::size() const {
+    return wheel.size();
+}
+
+// Schedules every loaded route with one reading of the clock.
+void RouteExpiry::scheduleAll() {
+    uint64_t now = clock();
+    rows.liveSlots().forEachSet([this, now](size_t slot) {
+        unsigned int lifetime = rows[slot].lifetime;
+        if (lifetime != UINT_MAX) {
+            wheel.schedule(slot, now + lifetime);
+        }
+    });
+}
+
+// A route scheduled before is scheduled again, e.g. when its lifetime changes.
+void RouteExpiry::schedule(const RoutingTableRow* row) {
+    if (row->lifetime == UINT_MAX) {
+        cancel(row);
+        return;
+    }
+    wheel.schedule(rows.slotOf(row), clock() + row->lifetime);
+}
+
+void RouteExpiry::cancel(const RoutingTableRow* row) {
+    wheel.cancel(rows.slotOf(row));
+}
+
+// Advances to the time of the clock and calls withdraw with every expired row, returns the number of them.
+template<typename Function>
+size_t RouteExpiry::expire(Function withdraw) {
+    size_t expired = 0;
+    wheel.advance(clock(), [this, &withdraw, &expired](size_t slot) {
+        withdraw(&rows[slot]);
+        ++expired;
+    });
+    return expired;
+}
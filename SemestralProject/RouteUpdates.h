@@ -0,0 +1,179 @@
+#pragma once
+#include "HierarchyManager.h"
+#include "TableManager.h"
+#include "PrefixTrie.h"
+#include "RowStore.h"
+#include "RouteExpiry.h"
+#include <array>
+#include <libds/heap_monitor.h>
+
+// Applies a stream of route updates to the loaded routing table without loading it again. Every line of the
+// stream is one update with cells separated by ';' like the routing table CSV file:
+//     add;10.0.0.0/8;via 1.2.3.4;1h
+//     withdraw;10.0.0.0/8;via 1.2.3.4
+//     modify;10.0.0.0/8;via 1.2.3.4;2h
+// A route is identified by its prefix and next hop, withdraw and modify change the best ranked route of
+// the two. Empty lines and lines starting with '#' are skipped. Updates are applied as they are read, so
+// the stream can be a pipe fed while the program runs.
+// Every update changes only its row: the store reuses slots, the hierarchy follows one branch of octets,
+// the table finds the destination in O(log n) and then the row among rows of the destination, and the trie
+// finds and changes only the slots and chains of the prefix. With route expiry, added and modified routes
+// are scheduled and withdrawn routes are cancelled.
+class RouteUpdates {
+public:
+    enum class Operation {
+        Add,
+        Withdraw,
+        Modify
+    };
+
+    struct Update {
+        Operation operation;
+        IPv4Prefix prefix;
+        IPv4Prefix destination;
+        unsigned int lifetime = UINT_MAX;
+    };
+
+    struct Summary {
+        size_t added = 0;
+        size_t withdrawn = 0;
+        size_t modified = 0;
+        size_t rejected = 0;
+    };
+
+    RouteUpdates(RowStore& rows, HierarchyManager& hierarchy, TableManager& tableManager, PrefixTrie& prefixTrie, RouteExpiry* expiry = nullptr);
+
+    static Update parse(std::string_view line);
+    void apply(const Update& update);
+    void withdraw(RoutingTableRow* row);
+    Summary applyStream(std::istream& stream);
+
+private:
+    static const size_t MAX_CELLS = 5;
+
+    RowStore& rows;
+    HierarchyManager& hierarchy;
+    TableManager& tableManager;
+    PrefixTrie& prefixTrie;
+    RouteExpiry* expiry;
+};
+
+RouteUpdates::RouteUpdates(RowStore& rows, HierarchyManager& hierarchy, TableManager& tableManager, PrefixTrie& prefixTrie, RouteExpiry* expiry)
+    : rows(rows), hierarchy(hierarchy), tableManager(tableManager), prefixTrie(prefixTrie), expiry(expiry) {
+}
+
+RouteUpdates::Update RouteUpdates::parse(std::string_view line) {
+    std::array<std::string_view, MAX_CELLS> cells;
+    size_t cellCount = 0;
+    size_t start = 0;
+    while (start <= line.size() && cellCount < MAX_CELLS) {
+        size_t end = std::min(line.find(';', start), line.size());
+        cells[cellCount++] = line.substr(start, end - start);
+        start = end + 1;
+    }
+
+    Update update;
+    if (cells[0] == "add") {
+        update.operation = Operation::Add;
+    } else if (cells[0] == "withdraw") {
+        update.operation = Operation::Withdraw;
+    } else if (cells[0] == "modify") {
+        update.operation = Operation::Modify;
+    } else {
+        throw std::runtime_error("Error: Unknown update operation.\n");
+    }
+    size_t expectedCells = update.operation == Operation::Withdraw ? 3 : 4;
+    if (cellCount != expectedCells && !(update.operation == Operation::Add && cellCount == 3)) {
+        throw std::runtime_error("Error: Invalid number of cells.\n");
+    }
+    update.prefix = RoutingTableOperations::processIPAddress(cells[1]);
+    if (cells[2].substr(0, 3) != "via") {
+        throw std::runtime_error("Error: Supported only next-hop ip address.\n");
+    }
+    update.destination = RoutingTableOperations::processIPAddress(cells[2].substr(cells[2].size() > 3 && cells[2][3] == ' ' ? 4 : 3));
+    if (cellCount == 4) {
+        std::string_view lifetime = cells[3];
+        if (lifetime.empty() || !(std::isdigit(lifetime[0]) || std::isalpha(lifetime[0]))) {
+            throw std::runtime_error("Error: Invalid lifetime format.\n");
+        }
+        update.lifetime = RoutingTableOperations::processLifetime(lifetime);
+    }
+    return update;
+}
+
+void RouteUpdates::apply(const Update& update) {
+    if (update.operation == Operation::Add) {
+        RoutingTableRow entry;
+        entry.ipAddress = update.prefix;
+        entry.destinationIP = update.destination;
+        entry.lifetime = update.lifetime;
+        RoutingTableRow* row = rows.add(entry);
+        hierarchy.insertBranch(row->ipAddress, row);
+        tableManager.addEntry(row->destinationIP, row);
+        prefixTrie.add(row);
+        if (expiry != nullptr) {
+            expiry->schedule(row);
+        }
+        return;
+    }
+
+    RoutingTableRow* row = prefixTrie.find(update.prefix, update.destination);
+    if (row == nullptr) {
+        throw std::runtime_error("Error: Route is not in the routing table.\n");
+    }
+    if (update.operation == Operation::Modify) {
+        rows.setLifetime(row, update.lifetime);
+        hierarchy.hierarchy.refresh(*hierarchy.findLeaf(*hierarchy.hierarchy.accessRoot(), row));
+        if (expiry != nullptr) {
+            expiry->schedule(row);
+        }
+        return;
+    }
+    withdraw(row);
+}
+
+// Removes the row from every structure, also when its route expires.
+void RouteUpdates::withdraw(RoutingTableRow* row) {
+    if (expiry != nullptr) {
+        expiry->cancel(row);
+    }
+    hierarchy.removeBranch(row);
+    tableManager.removeEntry(row->destinationIP, row);
+    prefixTrie.remove(row);
+    rows.remove(row);
+}
+
+// A line that can not be parsed or applied is reported and skipped, the updates around it are still applied.
+RouteUpdates::Summary RouteUpdates::applyStream(std::istream& stream) {
+    Summary summary;
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(stream, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        try {
+            Update update = parse(line);
+            apply(update);
+            switch (update.operation) {
+                case Operation::Add:
+                    ++summary.added;
+                    break;
+                case Operation::Withdraw:
+                    ++summary.withdrawn;
+                    break;
+                case Operation::Modify:
+                    ++summary.modified;
+                    break;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "Check line " << lineNumber << std::endl;
+            ++summary.rejected;
+        }
+    }
+    return summary;
+}
@@ -1,43 +1,36 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
-#include <bitset>
 #include <functional>
+#include "IPv4Prefix.h"
 #include <libds/amt/implicit_sequence.h>
 #include <libds/heap_monitor.h>
 
-bool operator>(const std::bitset<32>& first, const std::bitset<32>& second) {
-    return (first.to_ulong() > second.to_ulong());
-}
-
-bool operator<(const std::bitset<32>& first, const std::bitset<32>& second) {
-    return (first.to_ulong() < second.to_ulong());
-}
-
 struct RoutingTableRow {
-    std::bitset<32> ipAddress;
-    std::bitset<32> destinationIP;
+    IPv4Prefix ipAddress;
+    IPv4Prefix destinationIP;
     unsigned int lifetime;
-    unsigned char prefix;
 };
 
 class RoutingTableOperations {
 private:
-    static bool isStringIPMaskFormat(const std::string& str);
     static void saveRowToCSV(std::ofstream& file, const RoutingTableRow& row);
 public:
     static bool isStringNumeric(const std::string& str);
-    static void print(const std::vector<RoutingTableRow>& vectorToPrint);
+    template<typename Rows>
+    static void print(const Rows& rowsToPrint);
     static void printRow(const RoutingTableRow& row);
     static void sortPrint(const RoutingTableRow& row);
-    static std::bitset<32> processIPAddress(const std::string& ipAddressString, unsigned char* prefix);
-    static unsigned int processLifetime(const std::string& lifetimeString);
+    static IPv4Prefix processIPAddress(std::string_view ipAddressString);
+    static unsigned int processLifetime(std::string_view lifetimeString);
     static std::string convertLifetime(unsigned int lifetime);
-    static void saveToCSV(const std::string& filename, const std::vector<RoutingTableRow>& vectorToPrint);
+    template<typename Rows>
+    static void saveToCSV(const std::string& filename, const Rows& rowsToPrint);
     static void saveFilteredToCSV(const std::string& filename, ds::amt::IS<RoutingTableRow*>& sequence);
 };
 
@@ -50,62 +43,27 @@ bool RoutingTableOperations::isStringNumeric(const std::string &str) {
     return true;
 }
 
-bool RoutingTableOperations::isStringIPMaskFormat(const std::string& str) {
-    for (char c : str) {
-        if (!std::isdigit(c) && c != '/' && c != '.' && c != ' ') {
-            return false;
-        }
-    }
-    return true;
-}
-
-void RoutingTableOperations::print(const std::vector<RoutingTableRow>& vectorToPrint) {
-    for (const RoutingTableRow& row : vectorToPrint) {
+template<typename Rows>
+void RoutingTableOperations::print(const Rows& rowsToPrint) {
+    for (const RoutingTableRow& row : rowsToPrint) {
         printRow(row);
     }
 }
 
 void RoutingTableOperations::printRow(const RoutingTableRow& row) {
     std::cout << "==========================================" << std::endl;
-    std::cout << "IP Address: ";
-    for (int i = row.ipAddress.size() - 8; i >= 0; i -= 8) {
-        std::cout << std::bitset<8>(row.ipAddress.to_ulong() >> i).to_ulong();
-        if (i > 0) {
-            std::cout << ".";
-        }
-    }
-    std::cout << "/" << int(row.prefix) << std::endl;
-    std::cout << "Next Hop: ";
-    for (int i = row.destinationIP.size() - 8; i >= 0; i -= 8) {
-        std::cout << std::bitset<8>(row.destinationIP.to_ulong() >> i).to_ulong();
-        if (i > 0) {
-            std::cout << ".";
-        }
-    }
-    std::cout << std::endl;
+    std::cout << "IP Address: " << row.ipAddress.addressString() << "/" << int(row.ipAddress.length) << std::endl;
+    std::cout << "Next Hop: " << row.destinationIP.addressString() << std::endl;
     std::cout << "Lifetime: ";
     row.lifetime > 59 ? std::cout << row.lifetime << "(s) " << convertLifetime(row.lifetime) << std::endl : std::cout << row.lifetime << "s" << std::endl;
 }
 
 void RoutingTableOperations::sortPrint(const RoutingTableRow &row) {
-    std::string firstPart = "IP address: ";
-    for (int i = row.ipAddress.size() - 8; i >= 0; i -= 8) {
-        firstPart += std::to_string(int(std::bitset<8>(row.ipAddress.to_ulong() >> i).to_ulong()));
-        if (i > 0) {
-            firstPart += ".";
-        }
-    }
-    firstPart += "/" + std::to_string(int(row.prefix));
+    std::string firstPart = "IP address: " + row.ipAddress.addressString() + "/" + std::to_string(int(row.ipAddress.length));
     while (firstPart.size() < 35) {
         firstPart += " ";
     }
-    firstPart += "Next Hop: ";
-    for (int i = row.destinationIP.size() - 8; i >= 0; i -= 8) {
-        firstPart += std::to_string(int(std::bitset<8>(row.destinationIP.to_ulong() >> i).to_ulong()));
-        if (i > 0) {
-            firstPart += ".";
-        }
-    }
+    firstPart += "Next Hop: " + row.destinationIP.addressString();
     while (firstPart.size() < 62) {
         firstPart += " ";
     }
@@ -122,40 +80,62 @@ void RoutingTableOperations::sortPrint(const RoutingTableRow &row) {
     std::cout << firstPart << std::endl;
 }
 
-std::bitset<32> RoutingTableOperations::processIPAddress(const std::string& ipAddressString, unsigned char* prefix) {
-    std::bitset<32> ipAddressBits;
-    std::istringstream iss(ipAddressString);
-    std::string octetString;
-    int index = 3;
-    while (std::getline(iss, octetString, '.')) {
-        if (!isStringIPMaskFormat(octetString)) {
-            std::cout << octetString << std::endl;
+// Parses W.X.Y.Z or W.X.Y.Z/L in place. Every character is either a digit accumulated into the current number
+// or a separator closing it, the checks of a number are done once when it is closed.
+IPv4Prefix RoutingTableOperations::processIPAddress(std::string_view ipAddressString) {
+    IPv4Prefix ipAddress;
+    uint32_t address = 0;
+    unsigned int number = 0;
+    unsigned int digits = 0;
+    unsigned int octets = 0;
+    size_t i = 0;
+    for (; i <= ipAddressString.size(); ++i) {
+        char c = i < ipAddressString.size() ? ipAddressString[i] : '\0';
+        unsigned int digit = static_cast<unsigned char>(c - '0');
+        if (digit < 10) {
+            number = number * 10 + digit;
+            ++digits;
+            continue;
+        }
+        if (digits == 0 || digits > 3 || number > 255 || octets == 4 || (c != '.' && octets != 3)) {
             throw std::runtime_error("Error: Invalid IP address format.\n");
         }
-        int octet = std::stoi(octetString);
-        if (octet >= 0 && octet < 256) {
-            ipAddressBits |= (std::bitset<32>(octet) << (index * 8));
+        address = (address << 8) | number;
+        ++octets;
+        number = 0;
+        digits = 0;
+        if (c != '.') {
+            break;
         }
-        --index;
     }
-    size_t startingPrefixIndex = ipAddressString.find('/');
-    if (startingPrefixIndex != std::string::npos) {
-        std::string prefixString = ipAddressString.substr(startingPrefixIndex + 1);
-        if (!isStringIPMaskFormat(prefixString)) {
+    ipAddress.address = address;
+    if (i == ipAddressString.size()) {
+        return ipAddress;
+    }
+    if (ipAddressString[i] != '/') {
+        throw std::runtime_error("Error: Invalid IP address format.\n");
+    }
+    for (++i; i < ipAddressString.size(); ++i) {
+        unsigned int digit = static_cast<unsigned char>(ipAddressString[i] - '0');
+        if (digit >= 10) {
             throw std::runtime_error("Error: Invalid prefix format.\n");
         }
-        int prefixValue = std::stoi(prefixString);
-        if (prefixValue < 0 || prefixValue > 32) {
+        number = number * 10 + digit;
+        if (++digits > 2) {
             throw std::runtime_error("Error: Invalid prefix value.\n");
         }
-        if (prefix != nullptr) {
-            *prefix = prefixValue;
-        }
     }
-    return ipAddressBits;
+    if (digits == 0) {
+        throw std::runtime_error("Error: Invalid prefix format.\n");
+    }
+    if (number > 32) {
+        throw std::runtime_error("Error: Invalid prefix value.\n");
+    }
+    ipAddress.length = static_cast<uint8_t>(number);
+    return ipAddress;
 }
 
-unsigned int RoutingTableOperations::processLifetime(const std::string& lifetimeString) {
+unsigned int RoutingTableOperations::processLifetime(std::string_view lifetimeString) {
     std::vector<unsigned int> lifetime;
     unsigned int processingNumber = 0;
     bool hoursMuliply = true;
@@ -186,7 +166,7 @@ unsigned int RoutingTableOperations::processLifetime(const std::string& lifetime
     for (; i < lifetimeString.size(); ++i) {
         char charValue = lifetimeString[i];
         if (std::isdigit(charValue)) {
-            processingNumber += std::atoi(&charValue);
+            processingNumber += charValue - '0';
             if (i + 1 < lifetimeString.size()) {
                 if (std::isdigit(lifetimeString[i + 1])) {
                     processingNumber *= 10;
@@ -304,36 +284,25 @@ std::string RoutingTableOperations::convertLifetime(unsigned int lifetime) {
     return result;
 }
 
-void RoutingTableOperations::saveToCSV(const std::string& filename, const std::vector<RoutingTableRow>& vectorToPrint) {
+template<typename Rows>
+void RoutingTableOperations::saveToCSV(const std::string& filename, const Rows& rowsToPrint) {
     std::ofstream file(filename);
     if (file.is_open()) {
         file << "IP/Prefix;Next-Hop;Lifetime\n";
-        for (size_t i = 0; i < vectorToPrint.size(); ++i) {
-            const auto& row = vectorToPrint[i];
-            saveRowToCSV(file, row);
-            if (i < vectorToPrint.size() - 1) {
+        bool first = true;
+        for (const RoutingTableRow& row : rowsToPrint) {
+            if (!first) {
                 file << "\n";
             }
+            saveRowToCSV(file, row);
+            first = false;
         }
     }
     file.close();
 }
 
 void RoutingTableOperations::saveRowToCSV(std::ofstream& file, const RoutingTableRow& row) {
-    std::string ipAddressString = row.ipAddress.to_string();
-    std::string destinationIPString = row.destinationIP.to_string();
-    std::stringstream ipAddressStream, destinationIPStream;
-    for (int i = 0; i <= 24; i += 8) {
-        std::bitset<8> ipAddressOctet(ipAddressString.substr(i, 8));
-        std::bitset<8> destinationIPOctet(destinationIPString.substr(i, 8));
-        ipAddressStream << ipAddressOctet.to_ulong();
-        destinationIPStream << destinationIPOctet.to_ulong();
-        if (i < 24) {
-            ipAddressStream << ".";
-            destinationIPStream << ".";
-        }
-    }
-    file << ipAddressStream.str() << "/" << int(row.prefix) << ";via " << destinationIPStream.str() << ";" << convertLifetime(row.lifetime);
+    file << row.ipAddress.addressString() << "/" << int(row.ipAddress.length) << ";via " << row.destinationIP.addressString() << ";" << convertLifetime(row.lifetime);
 }
 
 void RoutingTableOperations::saveFilteredToCSV(const std::string& filename, ds::amt::IS<RoutingTableRow*>& sequence) {
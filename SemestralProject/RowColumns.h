@@ -0,0 +1,243 @@
+#pragma once
+#include "RoutingTable.h"
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include <libds/heap_monitor.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ROW_COLUMNS_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ROW_COLUMNS_SSE2
+#endif
+
+// Set of rows given by their slots, one bit per slot in words of 64 bits. Selections of the same rows are
+// combined word by word.
+class RowSelection {
+public:
+    static const size_t WORD_BITS = 64;
+
+    size_t slotCount() const;
+    void resize(size_t slotCount);
+    bool test(size_t slot) const;
+    void set(size_t slot, bool value);
+    size_t count() const;
+    RowSelection& operator&=(const RowSelection& other);
+
+    uint64_t* words();
+    const uint64_t* words() const;
+    size_t wordCount() const;
+
+    template<typename Function>
+    void forEachSet(Function function) const;
+
+private:
+    std::vector<uint64_t> words_;
+    size_t slots = 0;
+};
+
+// Fields of rows the store filters by, split into columns, so a filter reads only its field of consecutive
+// rows. The prefix of a row is kept as its mask. Next hops are not filtered here, the destination table finds
+// their rows. Filters compare 8 (AVX2) or 4 (SSE2) rows of a column at once and write a whole word of the
+// selection for every 64 slots instead of testing rows one by one.
+class RowColumns {
+public:
+    size_t slotCount() const;
+    void append(const RoutingTableRow& row);
+    void set(size_t slot, const RoutingTableRow& row);
+    void setLifetime(size_t slot, unsigned int lifetime);
+
+    void selectLifetime(unsigned int startTime, unsigned int endTime, RowSelection& selection) const;
+    void selectContaining(uint32_t ipAddress, RowSelection& selection) const;
+
+private:
+    std::vector<uint32_t> addresses;
+    std::vector<uint32_t> masks;
+    std::vector<uint32_t> lifetimes;
+};
+
+size_t RowSelection::slotCount() const {
+    return slots;
+}
+
+// Bits of new slots are cleared.
+void RowSelection::resize(size_t slotCount) {
+    size_t wordCount = (slotCount + WORD_BITS - 1) / WORD_BITS;
+    if (slotCount < slots && slotCount % WORD_BITS != 0) {
+        words_[wordCount - 1] &= (uint64_t(1) << (slotCount % WORD_BITS)) - 1;
+    }
+    words_.resize(wordCount, 0);
+    slots = slotCount;
+}
+
+bool RowSelection::test(size_t slot) const {
+    return (words_[slot / WORD_BITS] >> (slot % WORD_BITS)) & 1;
+}
+
+void RowSelection::set(size_t slot, bool value) {
+    uint64_t bit = uint64_t(1) << (slot % WORD_BITS);
+    words_[slot / WORD_BITS] = value ? words_[slot / WORD_BITS] | bit : words_[slot / WORD_BITS] & ~bit;
+}
+
+size_t RowSelection::count() const {
+    size_t result = 0;
+    for (uint64_t word : words_) {
+        result += std::popcount(word);
+    }
+    return result;
+}
+
+RowSelection& RowSelection::operator&=(const RowSelection& other) {
+    if (other.slots != slots) {
+        throw std::invalid_argument("Selections of different rows!");
+    }
+    for (size_t i = 0; i < words_.size(); ++i) {
+        words_[i] &= other.words_[i];
+    }
+    return *this;
+}
+
+uint64_t* RowSelection::words() {
+    return words_.data();
+}
+
+const uint64_t* RowSelection::words() const {
+    return words_.data();
+}
+
+size_t RowSelection::wordCount() const {
+    return words_.size();
+}
+
+// Calls function with every selected slot in increasing order.
+template<typename Function>
+void RowSelection::forEachSet(Function function) const {
+    for (size_t i = 0; i < words_.size(); ++i) {
+        for (uint64_t word = words_[i]; word != 0; word &= word - 1) {
+            function(i * WORD_BITS + std::countr_zero(word));
+        }
+    }
+}
+
+size_t RowColumns::slotCount() const {
+    return lifetimes.size();
+}
+
+void RowColumns::append(const RoutingTableRow& row) {
+    addresses.push_back(row.ipAddress.address);
+    masks.push_back(row.ipAddress.mask());
+    lifetimes.push_back(row.lifetime);
+}
+
+void RowColumns::set(size_t slot, const RoutingTableRow& row) {
+    addresses[slot] = row.ipAddress.address;
+    masks[slot] = row.ipAddress.mask();
+    lifetimes[slot] = row.lifetime;
+}
+
+void RowColumns::setLifetime(size_t slot, unsigned int lifetime) {
+    lifetimes[slot] = lifetime;
+}
+
+// A lifetime is in <startTime, endTime> when lifetime - startTime does not exceed endTime - startTime as
+// unsigned numbers, so every row needs one subtraction and one compare. SIMD has only signed compares of
+// 32-bit lanes, flipping the sign bit of both sides turns them into unsigned ones.
+void RowColumns::selectLifetime(unsigned int startTime, unsigned int endTime, RowSelection& selection) const {
+    selection.resize(slotCount());
+    uint64_t* words = selection.words();
+    if (startTime > endTime) {
+        std::fill(words, words + selection.wordCount(), 0);
+        return;
+    }
+    uint32_t range = endTime - startTime;
+    size_t fullWords = slotCount() / RowSelection::WORD_BITS;
+    const uint32_t* column = lifetimes.data();
+#if defined(ROW_COLUMNS_AVX2)
+    const __m256i start = _mm256_set1_epi32(static_cast<int>(startTime));
+    const __m256i sign = _mm256_set1_epi32(INT32_MIN);
+    const __m256i limit = _mm256_set1_epi32(static_cast<int>(range ^ 0x80000000u));
+    for (size_t i = 0; i < fullWords; ++i) {
+        uint64_t outside = 0;
+        for (unsigned int lane = 0; lane < RowSelection::WORD_BITS; lane += 8) {
+            __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + i * RowSelection::WORD_BITS + lane));
+            __m256i offsets = _mm256_xor_si256(_mm256_sub_epi32(values, start), sign);
+            uint64_t bits = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(offsets, limit))));
+            outside |= bits << lane;
+        }
+        words[i] = ~outside;
+    }
+#elif defined(ROW_COLUMNS_SSE2)
+    const __m128i start = _mm_set1_epi32(static_cast<int>(startTime));
+    const __m128i sign = _mm_set1_epi32(INT32_MIN);
+    const __m128i limit = _mm_set1_epi32(static_cast<int>(range ^ 0x80000000u));
+    for (size_t i = 0; i < fullWords; ++i) {
+        uint64_t outside = 0;
+        for (unsigned int lane = 0; lane < RowSelection::WORD_BITS; lane += 4) {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + i * RowSelection::WORD_BITS + lane));
+            __m128i offsets = _mm_xor_si128(_mm_sub_epi32(values, start), sign);
+            uint64_t bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(offsets, limit))));
+            outside |= bits << lane;
+        }
+        words[i] = ~outside;
+    }
+#else
+    fullWords = 0;
+#endif
+    for (size_t i = fullWords; i < selection.wordCount(); ++i) {
+        uint64_t word = 0;
+        size_t end = std::min(slotCount(), (i + 1) * RowSelection::WORD_BITS);
+        for (size_t slot = i * RowSelection::WORD_BITS; slot < end; ++slot) {
+            word |= uint64_t(column[slot] - startTime <= range) << (slot % RowSelection::WORD_BITS);
+        }
+        words[i] = word;
+    }
+}
+
+void RowColumns::selectContaining(uint32_t ipAddress, RowSelection& selection) const {
+    selection.resize(slotCount());
+    uint64_t* words = selection.words();
+    size_t fullWords = slotCount() / RowSelection::WORD_BITS;
+#if defined(ROW_COLUMNS_AVX2)
+    const __m256i address = _mm256_set1_epi32(static_cast<int>(ipAddress));
+    const __m256i zero = _mm256_setzero_si256();
+    for (size_t i = 0; i < fullWords; ++i) {
+        uint64_t word = 0;
+        for (unsigned int lane = 0; lane < RowSelection::WORD_BITS; lane += 8) {
+            size_t slot = i * RowSelection::WORD_BITS + lane;
+            __m256i networks = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(addresses.data() + slot));
+            __m256i prefixMasks = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks.data() + slot));
+            __m256i difference = _mm256_and_si256(_mm256_xor_si256(networks, address), prefixMasks);
+            uint64_t bits = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(difference, zero))));
+            word |= bits << lane;
+        }
+        words[i] = word;
+    }
+#elif defined(ROW_COLUMNS_SSE2)
+    const __m128i address = _mm_set1_epi32(static_cast<int>(ipAddress));
+    const __m128i zero = _mm_setzero_si128();
+    for (size_t i = 0; i < fullWords; ++i) {
+        uint64_t word = 0;
+        for (unsigned int lane = 0; lane < RowSelection::WORD_BITS; lane += 4) {
+            size_t slot = i * RowSelection::WORD_BITS + lane;
+            __m128i networks = _mm_loadu_si128(reinterpret_cast<const __m128i*>(addresses.data() + slot));
+            __m128i prefixMasks = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.data() + slot));
+            __m128i difference = _mm_and_si128(_mm_xor_si128(networks, address), prefixMasks);
+            uint64_t bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(difference, zero))));
+            word |= bits << lane;
+        }
+        words[i] = word;
+    }
+#else
+    fullWords = 0;
+#endif
+    for (size_t i = fullWords; i < selection.wordCount(); ++i) {
+        uint64_t word = 0;
+        size_t end = std::min(slotCount(), (i + 1) * RowSelection::WORD_BITS);
+        for (size_t slot = i * RowSelection::WORD_BITS; slot < end; ++slot) {
+            word |= uint64_t(((addresses[slot] ^ ipAddress) & masks[slot]) == 0) << (slot % RowSelection::WORD_BITS);
+        }
+        words[i] = word;
+    }
+}
@@ -0,0 +1,314 @@
+#pragma once
+#include "RowColumns.h"
+#include "LifetimeIndex.h"
+#include <memory>
+#include <vector>
+#include <libds/heap_monitor.h>
+
+// Rows of the routing table with stable addresses. Rows are kept in chunks of CHUNK_ROWS rows which never
+// move, so the hierarchy, the table and the trie can point to rows while other rows are added and withdrawn.
+// Every row has a slot index, a slot of a withdrawn row is reused by the next added row. Iteration visits
+// live rows in the order of their slots.
+// Columns mirror the rows for filters. Filters select slots of live rows, combined filters AND their
+// selections before rows are collected. Lifetimes are changed by setLifetime to keep the columns in sync.
+// Lifetime ranges are also found by the lifetime index, which is built when it is first used, so loading
+// does not sort the rows, and then changed with every row.
+class RowStore {
+public:
+    static const size_t CHUNK_ROWS = 4096;
+
+    template<typename Store, typename Row>
+    class BasicIterator {
+    public:
+        BasicIterator(Store* store, size_t slot);
+        bool operator!=(const BasicIterator& other) const;
+        Row& operator*() const;
+        BasicIterator& operator++();
+
+    private:
+        void skipWithdrawn();
+
+        Store* store;
+        size_t slot;
+    };
+
+    using Iterator = BasicIterator<RowStore, RoutingTableRow>;
+    using ConstIterator = BasicIterator<const RowStore, const RoutingTableRow>;
+
+    RowStore() = default;
+    RowStore(const RowStore&) = delete;
+    RowStore& operator=(const RowStore&) = delete;
+
+    size_t size() const;
+    bool empty() const;
+    size_t slotCount() const;
+    bool isLive(size_t slot) const;
+    RoutingTableRow& operator[](size_t slot);
+    const RoutingTableRow& operator[](size_t slot) const;
+    size_t slotOf(const RoutingTableRow* row) const;
+    void reserve(size_t slots);
+    RoutingTableRow* append(const RoutingTableRow& row);
+    RoutingTableRow* add(const RoutingTableRow& row);
+    void remove(RoutingTableRow* row);
+    void setLifetime(RoutingTableRow* row, unsigned int lifetime);
+
+    const RowSelection& liveSlots() const;
+    void selectLifetime(unsigned int startTime, unsigned int endTime, RowSelection& selection) const;
+    void selectContaining(uint32_t ipAddress, RowSelection& selection) const;
+    void collect(const RowSelection& selection, ds::amt::IS<RoutingTableRow*>& sequence);
+    void collect(std::vector<size_t>& slots, ds::amt::IS<RoutingTableRow*>& sequence);
+
+    size_t countInLifetime(unsigned int startTime, unsigned int endTime);
+    template<typename Function>
+    void forEachInLifetime(unsigned int startTime, unsigned int endTime, Function function);
+
+    Iterator begin();
+    Iterator end();
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+private:
+    void addChunk();
+    void buildLifetimeIndex();
+
+    std::vector<std::unique_ptr<RoutingTableRow[]>> chunks;
+    // First rows of chunks sorted by address together with the index of their chunk.
+    std::vector<std::pair<const RoutingTableRow*, size_t>> chunksByAddress;
+    RowSelection live;
+    RowColumns columns;
+    std::vector<size_t> freeSlots;
+    size_t liveCount = 0;
+    LifetimeIndex lifetimeIndex;
+    bool lifetimeIndexBuilt = false;
+    RowSelection collected;
+};
+
+template<typename Store, typename Row>
+RowStore::BasicIterator<Store, Row>::BasicIterator(Store* store, size_t slot) : store(store), slot(slot) {
+    skipWithdrawn();
+}
+
+template<typename Store, typename Row>
+bool RowStore::BasicIterator<Store, Row>::operator!=(const BasicIterator& other) const {
+    return slot != other.slot;
+}
+
+template<typename Store, typename Row>
+Row& RowStore::BasicIterator<Store, Row>::operator*() const {
+    return (*store)[slot];
+}
+
+template<typename Store, typename Row>
+RowStore::BasicIterator<Store, Row>& RowStore::BasicIterator<Store, Row>::operator++() {
+    ++slot;
+    skipWithdrawn();
+    return *this;
+}
+
+template<typename Store, typename Row>
+void RowStore::BasicIterator<Store, Row>::skipWithdrawn() {
+    while (slot < store->slotCount() && !store->isLive(slot)) {
+        ++slot;
+    }
+}
+
+size_t RowStore::size() const {
+    return liveCount;
+}
+
+bool RowStore::empty() const {
+    return liveCount == 0;
+}
+
+size_t RowStore::slotCount() const {
+    return live.slotCount();
+}
+
+bool RowStore::isLive(size_t slot) const {
+    return live.test(slot);
+}
+
+RoutingTableRow& RowStore::operator[](size_t slot) {
+    return chunks[slot / CHUNK_ROWS][slot % CHUNK_ROWS];
+}
+
+const RoutingTableRow& RowStore::operator[](size_t slot) const {
+    return chunks[slot / CHUNK_ROWS][slot % CHUNK_ROWS];
+}
+
+size_t RowStore::slotOf(const RoutingTableRow* row) const {
+    auto next = std::upper_bound(chunksByAddress.begin(), chunksByAddress.end(), row, [](const RoutingTableRow* address, const std::pair<const RoutingTableRow*, size_t>& chunk) {
+        return std::less<const RoutingTableRow*>()(address, chunk.first);
+    });
+    if (next == chunksByAddress.begin()) {
+        throw std::out_of_range("Row is not in the store!");
+    }
+    --next;
+    size_t offset = static_cast<size_t>(row - next->first);
+    if (offset >= CHUNK_ROWS || next->second * CHUNK_ROWS + offset >= slotCount()) {
+        throw std::out_of_range("Row is not in the store!");
+    }
+    return next->second * CHUNK_ROWS + offset;
+}
+
+void RowStore::reserve(size_t slots) {
+    while (chunks.size() * CHUNK_ROWS < slots) {
+        addChunk();
+    }
+}
+
+// Appended rows keep the order in which they were loaded, which ranks routes with the same prefix.
+RoutingTableRow* RowStore::append(const RoutingTableRow& row) {
+    size_t slot = slotCount();
+    if (slot == chunks.size() * CHUNK_ROWS) {
+        addChunk();
+    }
+    live.resize(slot + 1);
+    live.set(slot, true);
+    columns.append(row);
+    ++liveCount;
+    if (lifetimeIndexBuilt) {
+        lifetimeIndex.insert({ row.lifetime, static_cast<uint32_t>(slot) });
+    }
+    RoutingTableRow& stored = (*this)[slot];
+    stored = row;
+    return &stored;
+}
+
+RoutingTableRow* RowStore::add(const RoutingTableRow& row) {
+    if (freeSlots.empty()) {
+        return append(row);
+    }
+    size_t slot = freeSlots.back();
+    freeSlots.pop_back();
+    live.set(slot, true);
+    columns.set(slot, row);
+    ++liveCount;
+    if (lifetimeIndexBuilt) {
+        lifetimeIndex.insert({ row.lifetime, static_cast<uint32_t>(slot) });
+    }
+    RoutingTableRow& stored = (*this)[slot];
+    stored = row;
+    return &stored;
+}
+
+void RowStore::remove(RoutingTableRow* row) {
+    size_t slot = slotOf(row);
+    if (!live.test(slot)) {
+        throw std::logic_error("Row is already withdrawn!");
+    }
+    live.set(slot, false);
+    --liveCount;
+    if (lifetimeIndexBuilt) {
+        lifetimeIndex.erase({ row->lifetime, static_cast<uint32_t>(slot) });
+    }
+    freeSlots.push_back(slot);
+}
+
+void RowStore::setLifetime(RoutingTableRow* row, unsigned int lifetime) {
+    size_t slot = slotOf(row);
+    if (lifetimeIndexBuilt) {
+        lifetimeIndex.erase({ row->lifetime, static_cast<uint32_t>(slot) });
+        lifetimeIndex.insert({ lifetime, static_cast<uint32_t>(slot) });
+    }
+    row->lifetime = lifetime;
+    columns.setLifetime(slot, lifetime);
+}
+
+const RowSelection& RowStore::liveSlots() const {
+    return live;
+}
+
+void RowStore::selectLifetime(unsigned int startTime, unsigned int endTime, RowSelection& selection) const {
+    columns.selectLifetime(startTime, endTime, selection);
+    selection &= live;
+}
+
+void RowStore::selectContaining(uint32_t ipAddress, RowSelection& selection) const {
+    columns.selectContaining(ipAddress, selection);
+    selection &= live;
+}
+
+// Capacity of the sequence is set once for all selected rows.
+void RowStore::collect(const RowSelection& selection, ds::amt::IS<RoutingTableRow*>& sequence) {
+    size_t count = selection.count();
+    if (count == 0) {
+        return;
+    }
+    sequence.reserveCapacity(sequence.size() + count);
+    selection.forEachSet([this, &sequence](size_t slot) {
+        sequence.insertLast().data_ = &(*this)[slot];
+    });
+}
+
+// Rows are collected in the order of slots like from a selection. A few slots are sorted, many slots are
+// marked in a selection, which visits them in order without sorting.
+void RowStore::collect(std::vector<size_t>& slots, ds::amt::IS<RoutingTableRow*>& sequence) {
+    if (slots.empty()) {
+        return;
+    }
+    if (slots.size() * RowSelection::WORD_BITS >= slotCount()) {
+        collected.resize(0);
+        collected.resize(slotCount());
+        for (size_t slot : slots) {
+            collected.set(slot, true);
+        }
+        collect(collected, sequence);
+        return;
+    }
+    std::sort(slots.begin(), slots.end());
+    sequence.reserveCapacity(sequence.size() + slots.size());
+    for (size_t slot : slots) {
+        sequence.insertLast().data_ = &(*this)[slot];
+    }
+}
+
+size_t RowStore::countInLifetime(unsigned int startTime, unsigned int endTime) {
+    if (!lifetimeIndexBuilt) {
+        buildLifetimeIndex();
+    }
+    return lifetimeIndex.count(startTime, endTime);
+}
+
+// Calls function with slots of live rows with lifetimes in <startTime, endTime> in the order of lifetimes.
+template<typename Function>
+void RowStore::forEachInLifetime(unsigned int startTime, unsigned int endTime, Function function) {
+    if (!lifetimeIndexBuilt) {
+        buildLifetimeIndex();
+    }
+    lifetimeIndex.forEachInRange(startTime, endTime, function);
+}
+
+RowStore::Iterator RowStore::begin() {
+    return Iterator(this, 0);
+}
+
+RowStore::Iterator RowStore::end() {
+    return Iterator(this, slotCount());
+}
+
+RowStore::ConstIterator RowStore::begin() const {
+    return ConstIterator(this, 0);
+}
+
+RowStore::ConstIterator RowStore::end() const {
+    return ConstIterator(this, slotCount());
+}
+
+void RowStore::addChunk() {
+    chunks.push_back(std::make_unique<RoutingTableRow[]>(CHUNK_ROWS));
+    std::pair<const RoutingTableRow*, size_t> chunk(chunks.back().get(), chunks.size() - 1);
+    chunksByAddress.insert(std::upper_bound(chunksByAddress.begin(), chunksByAddress.end(), chunk, [](const auto& first, const auto& second) {
+        return std::less<const RoutingTableRow*>()(first.first, second.first);
+    }), chunk);
+}
+
+void RowStore::buildLifetimeIndex() {
+    std::vector<LifetimeIndex::Entry> entries;
+    entries.reserve(liveCount);
+    live.forEachSet([this, &entries](size_t slot) {
+        entries.push_back({ (*this)[slot].lifetime, static_cast<uint32_t>(slot) });
+    });
+    lifetimeIndex.assign(entries);
+    lifetimeIndexBuilt = true;
+}
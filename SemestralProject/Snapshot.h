@@ -0,0 +1,330 @@
+#pragma once
+#include "HierarchyManager.h"
+#include "TableManager.h"
+#include "PrefixTrie.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <filesystem>
+#include <libds/heap_monitor.h>
+
+// Binary snapshot of a loaded routing table, written next to its CSV file and memory mapped on the next start.
+// It holds the rows packed, the hierarchy in pre-order and the node array of the prefix trie. Records refer to
+// each other only by indices, so the snapshot does not depend on addresses of the process that wrote it.
+// The header remembers size, modification time and hash of the CSV file. When size or time differ the CSV is
+// hashed, a snapshot of a changed CSV file is stale. A hash of the records and bounds checks of all indices
+// reject a damaged snapshot before anything is built from it. The destination table is a treap whose shape is
+// random, it is not stored and is built again from the rows.
+class Snapshot {
+public:
+    static const uint32_t VERSION = 1;
+
+    static std::string pathFor(const std::string& csvFilename);
+    static bool tryLoad(const std::string& csvFilename, RowStore& rows, HierarchyManager& hierarchy, TableManager& tableManager, PrefixTrie& prefixTrie);
+    static void save(const std::string& csvFilename, const RowStore& rows, HierarchyManager& hierarchy, const PrefixTrie& prefixTrie);
+
+private:
+    static const uint32_t NONE = UINT32_MAX;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerSize;
+        uint64_t sourceSize;
+        int64_t sourceModified;
+        uint64_t sourceHash;
+        uint64_t contentHash;
+        uint64_t rowCount;
+        uint64_t rowOffset;
+        uint64_t hierarchyCount;
+        uint64_t hierarchyOffset;
+        uint64_t trieNodeCount;
+        uint64_t trieNodeOffset;
+        uint64_t routeCount;
+        uint64_t routeOffset;
+    };
+
+    struct Row {
+        uint32_t address;
+        uint32_t destination;
+        uint32_t lifetime;
+        uint8_t length;
+        uint8_t destinationLength;
+        uint16_t reserved;
+    };
+
+    struct HierarchyRecord {
+        uint32_t row;
+        uint32_t degree;
+        uint8_t octet;
+        uint8_t reserved[3];
+    };
+
+    struct RouteRecord {
+        uint32_t row;
+        uint32_t cover;
+    };
+
+    static constexpr char MAGIC[8] = { 'R', 'T', 'S', 'N', 'A', 'P', 0, 0 };
+
+    static bool isFresh(const Header& header, const std::string& csvFilename);
+    static bool hasValidSections(const Header& header, size_t snapshotSize);
+    static bool hasValidRows(std::string_view snapshot, const Header& header);
+    static bool hasValidHierarchy(std::string_view snapshot, const Header& header);
+    static bool hasValidTrie(std::string_view snapshot, const Header& header);
+    static int64_t modificationTime(const std::string& filename);
+    static uint64_t hashOf(std::string_view contents);
+
+    template<typename T>
+    static T recordAt(std::string_view snapshot, uint64_t offset, uint64_t index);
+};
+
+std::string Snapshot::pathFor(const std::string& csvFilename) {
+    return csvFilename + ".snapshot";
+}
+
+bool Snapshot::tryLoad(const std::string& csvFilename, RowStore& rows, HierarchyManager& hierarchy, TableManager& tableManager, PrefixTrie& prefixTrie) {
+    std::error_code error;
+    if (!std::filesystem::exists(pathFor(csvFilename), error)) {
+        return false;
+    }
+    MappedFile file(pathFor(csvFilename));
+    std::string_view snapshot = file.contents();
+    if (snapshot.size() < sizeof(Header)) {
+        return false;
+    }
+    Header header;
+    std::memcpy(&header, snapshot.data(), sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.headerSize != sizeof(Header)
+        || !hasValidSections(header, snapshot.size()) || hashOf(snapshot.substr(sizeof(Header))) != header.contentHash
+        || !hasValidRows(snapshot, header) || !hasValidHierarchy(snapshot, header) || !hasValidTrie(snapshot, header)
+        || !isFresh(header, csvFilename)) {
+        return false;
+    }
+
+    rows.reserve(rows.slotCount() + header.rowCount);
+    size_t firstRow = rows.slotCount();
+    for (uint64_t i = 0; i < header.rowCount; ++i) {
+        Row row = recordAt<Row>(snapshot, header.rowOffset, i);
+        RoutingTableRow entry;
+        entry.ipAddress.address = row.address;
+        entry.ipAddress.length = row.length;
+        entry.destinationIP.address = row.destination;
+        entry.destinationIP.length = row.destinationLength;
+        entry.lifetime = row.lifetime;
+        rows.append(entry);
+    }
+
+    // Records are in pre-order, every node becomes the next son of the nearest node above it with sons left.
+    RoutingHierarchy& routingHierarchy = hierarchy.hierarchy;
+    routingHierarchy.deferAggregates();
+    std::vector<std::pair<RoutingBlock*, uint32_t>> parents;
+    for (uint64_t i = 0; i < header.hierarchyCount; ++i) {
+        HierarchyRecord record = recordAt<HierarchyRecord>(snapshot, header.hierarchyOffset, i);
+        RoutingBlock* node = routingHierarchy.accessRoot();
+        if (i > 0) {
+            while (parents.back().second == 0) {
+                parents.pop_back();
+            }
+            --parents.back().second;
+            RoutingBlock& parent = *parents.back().first;
+            node = &routingHierarchy.emplaceSon(parent, routingHierarchy.degree(parent));
+        }
+        node->data_.octet = record.octet;
+        node->data_.pData = record.row != NONE ? &rows[firstRow + record.row] : nullptr;
+        parents.push_back({ node, record.degree });
+    }
+    routingHierarchy.resumeAggregates();
+
+    for (uint64_t i = 0; i < header.rowCount; ++i) {
+        tableManager.addEntry(rows[firstRow + i].destinationIP, &rows[firstRow + i]);
+    }
+
+    prefixTrie.nodes.resize(header.trieNodeCount);
+    std::memcpy(prefixTrie.nodes.data(), snapshot.data() + header.trieNodeOffset, header.trieNodeCount * sizeof(PrefixTrie::TrieNode));
+    prefixTrie.routes.clear();
+    prefixTrie.routes.reserve(header.routeCount);
+    prefixTrie.tombstoneCount = 0;
+    for (uint64_t i = 0; i < header.routeCount; ++i) {
+        RouteRecord route = recordAt<RouteRecord>(snapshot, header.routeOffset, i);
+        RoutingTableRow& row = rows[firstRow + route.row];
+        prefixTrie.routes.push_back({ &row, route.cover, row.ipAddress.length });
+    }
+    return true;
+}
+
+// The snapshot is written to a temporary file which then replaces the old one, so a reader never maps a half
+// written snapshot. Failing to write it is not an error, the next start loads the CSV file again. It is saved
+// right after loading, before any update has withdrawn a row.
+void Snapshot::save(const std::string& csvFilename, const RowStore& rows, HierarchyManager& hierarchy, const PrefixTrie& prefixTrie) {
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(Header);
+    try {
+        header.sourceModified = modificationTime(csvFilename);
+        MappedFile source(csvFilename);
+        header.sourceSize = source.contents().size();
+        header.sourceHash = hashOf(source.contents());
+    } catch (const std::exception& e) {
+        std::cerr << "Snapshot not saved: " << e.what() << std::endl;
+        return;
+    }
+
+    std::vector<HierarchyRecord> hierarchyRecords;
+    hierarchyRecords.reserve(hierarchy.hierarchy.size());
+    hierarchy.hierarchy.processPreOrder(hierarchy.hierarchy.accessRoot(), [&](const RoutingBlock* node) {
+        HierarchyRecord record = {};
+        record.row = node->data_.pData != nullptr ? static_cast<uint32_t>(rows.slotOf(node->data_.pData)) : NONE;
+        record.degree = static_cast<uint32_t>(hierarchy.hierarchy.degree(*node));
+        record.octet = node->data_.octet;
+        hierarchyRecords.push_back(record);
+    });
+
+    header.rowCount = rows.size();
+    header.rowOffset = sizeof(Header);
+    header.hierarchyCount = hierarchyRecords.size();
+    header.hierarchyOffset = header.rowOffset + header.rowCount * sizeof(Row);
+    header.trieNodeCount = prefixTrie.nodes.size();
+    header.trieNodeOffset = header.hierarchyOffset + header.hierarchyCount * sizeof(HierarchyRecord);
+    header.routeCount = prefixTrie.routes.size();
+    header.routeOffset = header.trieNodeOffset + header.trieNodeCount * sizeof(PrefixTrie::TrieNode);
+
+    std::string content;
+    content.reserve(header.routeOffset + header.routeCount * sizeof(RouteRecord) - sizeof(Header));
+    for (const RoutingTableRow& entry : rows) {
+        Row row = { entry.ipAddress.address, entry.destinationIP.address, entry.lifetime, entry.ipAddress.length, entry.destinationIP.length, 0 };
+        content.append(reinterpret_cast<const char*>(&row), sizeof(Row));
+    }
+    content.append(reinterpret_cast<const char*>(hierarchyRecords.data()), hierarchyRecords.size() * sizeof(HierarchyRecord));
+    content.append(reinterpret_cast<const char*>(prefixTrie.nodes.data()), prefixTrie.nodes.size() * sizeof(PrefixTrie::TrieNode));
+    for (const PrefixTrie::Route& route : prefixTrie.routes) {
+        RouteRecord record = { static_cast<uint32_t>(rows.slotOf(route.row)), route.cover };
+        content.append(reinterpret_cast<const char*>(&record), sizeof(RouteRecord));
+    }
+    header.contentHash = hashOf(content);
+
+    std::string temporaryPath = pathFor(csvFilename) + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        file.write(content.data(), content.size());
+        if (!file) {
+            std::cerr << "Snapshot not saved: Could not write " << temporaryPath << std::endl;
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, pathFor(csvFilename), error);
+    if (error) {
+        std::cerr << "Snapshot not saved: " << error.message() << std::endl;
+        std::filesystem::remove(temporaryPath, error);
+    }
+}
+
+bool Snapshot::isFresh(const Header& header, const std::string& csvFilename) {
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(csvFilename, error);
+    if (error || size != header.sourceSize) {
+        return false;
+    }
+    try {
+        if (modificationTime(csvFilename) == header.sourceModified) {
+            return true;
+        }
+        // Same size but touched, e.g. copied or checked out again, the contents decide.
+        MappedFile source(csvFilename);
+        return hashOf(source.contents()) == header.sourceHash;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool Snapshot::hasValidSections(const Header& header, size_t snapshotSize) {
+    uint64_t end = sizeof(Header);
+    const std::pair<uint64_t, uint64_t> sections[] = {
+        { header.rowOffset, header.rowCount * sizeof(Row) },
+        { header.hierarchyOffset, header.hierarchyCount * sizeof(HierarchyRecord) },
+        { header.trieNodeOffset, header.trieNodeCount * sizeof(PrefixTrie::TrieNode) },
+        { header.routeOffset, header.routeCount * sizeof(RouteRecord) },
+    };
+    // Counts are bounded by the snapshot size first, so the sizes of sections can not overflow.
+    if (header.rowCount > snapshotSize || header.hierarchyCount > snapshotSize || header.trieNodeCount > snapshotSize || header.routeCount > snapshotSize) {
+        return false;
+    }
+    for (const auto& [offset, size] : sections) {
+        if (offset != end || size > snapshotSize - offset) {
+            return false;
+        }
+        end = offset + size;
+    }
+    return end == snapshotSize && header.rowCount < NONE && header.hierarchyCount > 0 && header.trieNodeCount > 0;
+}
+
+bool Snapshot::hasValidRows(std::string_view snapshot, const Header& header) {
+    for (uint64_t i = 0; i < header.rowCount; ++i) {
+        Row row = recordAt<Row>(snapshot, header.rowOffset, i);
+        if (row.length > 32 || row.destinationLength > 32) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Snapshot::hasValidHierarchy(std::string_view snapshot, const Header& header) {
+    // Number of sons still expected below the nodes on the path, the first record is the root.
+    uint64_t pendingSons = 1;
+    for (uint64_t i = 0; i < header.hierarchyCount; ++i) {
+        HierarchyRecord record = recordAt<HierarchyRecord>(snapshot, header.hierarchyOffset, i);
+        if (pendingSons == 0 || (record.row != NONE && record.row >= header.rowCount)) {
+            return false;
+        }
+        pendingSons = pendingSons - 1 + record.degree;
+    }
+    return pendingSons == 0;
+}
+
+bool Snapshot::hasValidTrie(std::string_view snapshot, const Header& header) {
+    for (uint64_t i = 0; i < header.trieNodeCount; ++i) {
+        PrefixTrie::TrieNode node = recordAt<PrefixTrie::TrieNode>(snapshot, header.trieNodeOffset, i);
+        for (const PrefixTrie::Slot& slot : node.slots) {
+            if (slot.child >= header.trieNodeCount || (slot.route != PrefixTrie::NONE && slot.route >= header.routeCount)) {
+                return false;
+            }
+        }
+    }
+    for (uint64_t i = 0; i < header.routeCount; ++i) {
+        RouteRecord route = recordAt<RouteRecord>(snapshot, header.routeOffset, i);
+        if (route.row >= header.rowCount || (route.cover != PrefixTrie::NONE && route.cover >= header.routeCount)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int64_t Snapshot::modificationTime(const std::string& filename) {
+    return static_cast<int64_t>(std::filesystem::last_write_time(filename).time_since_epoch().count());
+}
+
+// FNV-1a over 8-byte words instead of bytes, detects changed files and damaged snapshots at memory speed.
+uint64_t Snapshot::hashOf(std::string_view contents) {
+    const uint64_t prime = 1099511628211ull;
+    uint64_t hash = 14695981039346656037ull ^ contents.size();
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= contents.size(); i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, contents.data() + i, sizeof(uint64_t));
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 32;
+    }
+    for (; i < contents.size(); ++i) {
+        hash = (hash ^ static_cast<unsigned char>(contents[i])) * prime;
+    }
+    return hash;
+}
+
+template<typename T>
+T Snapshot::recordAt(std::string_view snapshot, uint64_t offset, uint64_t index) {
+    T record;
+    std::memcpy(&record, snapshot.data() + offset + index * sizeof(T), sizeof(T));
+    return record;
+}
@@ -2,13 +2,7 @@
 #include <libds/heap_monitor.h>
 
 auto comparePrefix = [](const RoutingTableRow* first, const RoutingTableRow* second) {
-    if (first->ipAddress.to_ulong() < second->ipAddress.to_ulong()) {
-        return true;
-    }
-    if (first->ipAddress.to_ulong() == second->ipAddress.to_ulong()) {
-        return first->prefix < second->prefix;
-    }
-    return false;
+    return first->ipAddress < second->ipAddress;
 };
 
 auto compareTime = [](const RoutingTableRow* first, const RoutingTableRow* second) {
@@ -1,3 +1,4 @@
+#pragma once
 #include <libds/adt/table.h>
 #include <libds/adt/list.h>
 #include "RoutingTable.h"
@@ -6,18 +7,19 @@
 class TableManager
 {
 public:
-    ds::adt::Table<std::bitset<32>, ds::adt::ImplicitList<RoutingTableRow*>*> * table;
+    ds::adt::Table<IPv4Prefix, ds::adt::ImplicitList<RoutingTableRow*>*> * table;
     TableManager();
     ~TableManager();
-    void addEntry(std::bitset<32>& key, RoutingTableRow* value);
-    void removeEntries(ds::adt::ImplicitList<std::bitset<32>>& ipAddresses);
-    void findRowWithKey(std::bitset<32>& key, ds::amt::IS<RoutingTableRow*>& filteringSequence);
+    void addEntry(IPv4Prefix& key, RoutingTableRow* value);
+    void removeEntry(const IPv4Prefix& key, RoutingTableRow* value);
+    void removeEntries(ds::adt::ImplicitList<IPv4Prefix>& ipAddresses);
+    void findRowWithKey(IPv4Prefix& key, ds::amt::IS<RoutingTableRow*>& filteringSequence);
 };
 
 TableManager::TableManager() {
-    //table = new ds::adt::SortedSequenceTable<std::bitset<32>, ds::adt::ImplicitList<RoutingTableRow*>*>();
-    //table = new ds::adt::BinarySearchTree<std::bitset<32>, ds::adt::ImplicitList<RoutingTableRow*>*>();
-    table = new ds::adt::Treap<std::bitset<32>, ds::adt::ImplicitList<RoutingTableRow*>*>();
+    //table = new ds::adt::SortedSequenceTable<IPv4Prefix, ds::adt::ImplicitList<RoutingTableRow*>*>();
+    //table = new ds::adt::BinarySearchTree<IPv4Prefix, ds::adt::ImplicitList<RoutingTableRow*>*>();
+    table = new ds::adt::Treap<IPv4Prefix, ds::adt::ImplicitList<RoutingTableRow*>*>();
 }
 
 TableManager::~TableManager() {
@@ -25,7 +27,7 @@ TableManager::~TableManager() {
     delete table;
 }
 
-void TableManager::addEntry(std::bitset<32>& key, RoutingTableRow* value) {
+void TableManager::addEntry(IPv4Prefix& key, RoutingTableRow* value) {
     ds::adt::ImplicitList<RoutingTableRow*>** place = nullptr;
     if (!table->tryFind(key, place)) {
         ds::adt::ImplicitList<RoutingTableRow*>* sequence = new ds::adt::ImplicitList<RoutingTableRow*>();
@@ -36,9 +38,27 @@ void TableManager::addEntry(std::bitset<32>& key, RoutingTableRow* value) {
     }
 }
 
-void TableManager::removeEntries(ds::adt::ImplicitList<std::bitset<32>>& ipAddresses) {
-    ds::adt::ImplicitList<std::bitset<32>>::IteratorType begin = ipAddresses.begin();
-    ds::adt::ImplicitList<std::bitset<32>>::IteratorType end = ipAddresses.end();
+// The key is removed together with its last row, so keys of the table are always destinations of some row.
+void TableManager::removeEntry(const IPv4Prefix& key, RoutingTableRow* value) {
+    ds::adt::ImplicitList<RoutingTableRow*>** place = nullptr;
+    if (!table->tryFind(key, place)) {
+        throw std::logic_error("Destination is not in the table!");
+    }
+    ds::adt::ImplicitList<RoutingTableRow*>* sequence = *place;
+    size_t index = sequence->calculateIndex(value);
+    if (index == ds::INVALID_INDEX) {
+        throw std::logic_error("Row is not in the table!");
+    }
+    sequence->remove(index);
+    if (sequence->isEmpty()) {
+        table->remove(key);
+        delete sequence;
+    }
+}
+
+void TableManager::removeEntries(ds::adt::ImplicitList<IPv4Prefix>& ipAddresses) {
+    ds::adt::ImplicitList<IPv4Prefix>::IteratorType begin = ipAddresses.begin();
+    ds::adt::ImplicitList<IPv4Prefix>::IteratorType end = ipAddresses.end();
     while (begin != end) {
         ds::adt::ImplicitList<RoutingTableRow*>** place = nullptr;
         table->tryFind(*begin, place);
@@ -47,10 +67,9 @@ void TableManager::removeEntries(ds::adt::ImplicitList<std::bitset<32>>& ipAddre
     }
 }
 
-void TableManager::findRowWithKey(std::bitset<32>& key, ds::amt::IS<RoutingTableRow*>& filteringSequence) {
+void TableManager::findRowWithKey(IPv4Prefix& key, ds::amt::IS<RoutingTableRow*>& filteringSequence) {
     ds::adt::ImplicitList<RoutingTableRow*>** place = nullptr;
-    table->tryFind(key, place);
-    if (*place != nullptr) {
+    if (table->tryFind(key, place) && *place != nullptr) {
         ds::adt::ImplicitList<RoutingTableRow*>::IteratorType begin = (*place)->begin();
         ds::adt::ImplicitList<RoutingTableRow*>::IteratorType end = (*place)->end();
         while (begin != end) {
@@ -0,0 +1,154 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include <libds/heap_monitor.h>
+
+// Hierarchical timing wheel of timers identified by small ids, such as slots of rows. Level l has BUCKETS
+// buckets of BUCKETS^l ticks. A timer is kept at the level of the highest group of BUCKET_BITS bits in which
+// its time differs from the current time, in the bucket given by that group of its time. Buckets are doubly
+// linked lists of ids, so a timer is scheduled and cancelled in O(1). Advancing jumps to the first occupied
+// bucket of the lowest occupied level, found in bitmaps of occupied buckets: timers of a bucket of level 0
+// expire, timers of a higher bucket move to lower levels, every timer at most LEVELS times.
+class TimingWheel {
+public:
+    static const unsigned int BUCKET_BITS = 6;
+    static const unsigned int BUCKETS = 1 << BUCKET_BITS;
+    static const unsigned int LEVELS = (64 + BUCKET_BITS - 1) / BUCKET_BITS;
+
+    explicit TimingWheel(uint64_t now = 0);
+
+    uint64_t now() const;
+    size_t size() const;
+    bool isScheduled(size_t id) const;
+    void schedule(size_t id, uint64_t time);
+    void cancel(size_t id);
+
+    template<typename Function>
+    void advance(uint64_t time, Function expire);
+
+private:
+    static const uint32_t NONE = UINT32_MAX;
+
+    struct Timer {
+        uint64_t time = 0;
+        uint32_t previous = NONE;
+        uint32_t next = NONE;
+        uint8_t level = 0;
+        uint8_t bucket = 0;
+        bool scheduled = false;
+    };
+
+    void link(uint32_t id);
+    void unlink(uint32_t id);
+
+    std::vector<Timer> timers;
+    std::array<std::array<uint32_t, BUCKETS>, LEVELS> heads;
+    std::array<uint64_t, LEVELS> occupied{};
+    uint64_t current;
+    size_t count = 0;
+};
+
+TimingWheel::TimingWheel(uint64_t now) : current(now) {
+    for (auto& level : heads) {
+        level.fill(uint32_t(NONE));
+    }
+}
+
+uint64_t TimingWheel::now() const {
+    return current;
+}
+
+size_t TimingWheel::size() const {
+    return count;
+}
+
+bool TimingWheel::isScheduled(size_t id) const {
+    return id < timers.size() && timers[id].scheduled;
+}
+
+// A scheduled timer is moved to the new time, a time already passed expires on the next advance.
+void TimingWheel::schedule(size_t id, uint64_t time) {
+    if (id >= timers.size()) {
+        timers.resize(id + 1);
+    }
+    if (timers[id].scheduled) {
+        unlink(static_cast<uint32_t>(id));
+    }
+    timers[id].time = std::max(time, current);
+    link(static_cast<uint32_t>(id));
+}
+
+void TimingWheel::cancel(size_t id) {
+    if (isScheduled(id)) {
+        unlink(static_cast<uint32_t>(id));
+    }
+}
+
+// Calls expire with ids of timers whose time is not after time, in the order of their times. Timers of the
+// same time expire in no particular order.
+template<typename Function>
+void TimingWheel::advance(uint64_t time, Function expire) {
+    while (true) {
+        unsigned int level = 0;
+        while (level < LEVELS && occupied[level] == 0) {
+            ++level;
+        }
+        if (level == LEVELS) {
+            break;
+        }
+        unsigned int shift = level * BUCKET_BITS;
+        unsigned int bucket = static_cast<unsigned int>(std::countr_zero(occupied[level]));
+        uint64_t due = shift + BUCKET_BITS < 64 ? current >> (shift + BUCKET_BITS) << (shift + BUCKET_BITS) : 0;
+        due |= static_cast<uint64_t>(bucket) << shift;
+        if (due > time) {
+            break;
+        }
+        current = std::max(current, due);
+        for (uint32_t id = heads[level][bucket]; id != NONE; id = heads[level][bucket]) {
+            unlink(id);
+            if (level == 0) {
+                expire(static_cast<size_t>(id));
+            } else {
+                link(id);
+            }
+        }
+    }
+    current = std::max(current, time);
+}
+
+void TimingWheel::link(uint32_t id) {
+    Timer& timer = timers[id];
+    uint64_t difference = timer.time ^ current;
+    timer.level = static_cast<uint8_t>(difference == 0 ? 0 : (std::bit_width(difference) - 1) / BUCKET_BITS);
+    timer.bucket = static_cast<uint8_t>((timer.time >> (timer.level * BUCKET_BITS)) & (BUCKETS - 1));
+    uint32_t& head = heads[timer.level][timer.bucket];
+    timer.previous = NONE;
+    timer.next = head;
+    if (head != NONE) {
+        timers[head].previous = id;
+    }
+    head = id;
+    occupied[timer.level] |= uint64_t(1) << timer.bucket;
+    timer.scheduled = true;
+    ++count;
+}
+
+void TimingWheel::unlink(uint32_t id) {
+    Timer& timer = timers[id];
+    if (timer.previous != NONE) {
+        timers[timer.previous].next = timer.next;
+    } else {
+        heads[timer.level][timer.bucket] = timer.next;
+        if (timer.next == NONE) {
+            occupied[timer.level] &= ~(uint64_t(1) << timer.bucket);
+        }
+    }
+    if (timer.next != NONE) {
+        timers[timer.next].previous = timer.previous;
+    }
+    timer.scheduled = false;
+    --count;
+}
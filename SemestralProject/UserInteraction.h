@@ -33,8 +33,9 @@ void UserInteraction::printOptions() {
     std::cout << "\t[-1] To exit program" << std::endl;
     std::cout << "\t-------------- Standard filtering --------------" << std::endl;
     std::cout << "\t[0] Filter by matching IP address and lifetime" << std::endl;
-    std::cout << "\t[1] Filter by matching IP address" << std::endl;
+    std::cout << "\t[1] Filter by matching IP address (longest prefix first)" << std::endl;
     std::cout << "\t[2] Filter by matching lifetime" << std::endl;
+    std::cout << "\t[7] Find best matching route (longest prefix)" << std::endl;
     std::cout << "\t------------ Save and print options ------------" << std::endl;
     std::cout << "\t[3] Print whole routing table" << std::endl;
     std::cout << "\t[4] Save whole table to CSV" << std::endl;
@@ -53,6 +54,10 @@ void UserInteraction::printOptions() {
     std::cout << "\t----------------- Sorting mode -----------------" << std::endl;
     std::cout << "\t[31] Sort filtered by IP address" << std::endl;
     std::cout << "\t[32] Sort filtered by lifetime" << std::endl;
+    std::cout << "\t---------------- Benchmark mode ----------------" << std::endl;
+    std::cout << "\t[41] Benchmark longest prefix lookups" << std::endl;
+    std::cout << "\t----------------- Update mode ------------------" << std::endl;
+    std::cout << "\t[51] Apply route updates from file or pipe" << std::endl;
     std::cout << "Your option: ";
 }
 
@@ -2,30 +2,53 @@
 #include "Loader.h"
 #include "UserInteraction.h"
 #include "SortingManager.h"
+#include "LookupBenchmark.h"
+#include "Snapshot.h"
+#include "RouteUpdates.h"
+#include "tests/lifetime_index.test.h"
+#include "tests/prefix_trie.test.h"
+#include "tests/route_expiry.test.h"
+#include "tests/route_updates.test.h"
+#include "tests/timing_wheel.test.h"
 #include <libds/heap_monitor.h>
 
-void mainLoop(std::vector<RoutingTableRow>& loadedRoutingTable, HierarchyManager& hierarchyManager, TableManager& tableManager) {
+void mainLoop(RowStore& loadedRoutingTable, HierarchyManager& hierarchyManager, TableManager& tableManager, PrefixTrie& prefixTrie) {
     ds::amt::IS<RoutingTableRow*> filteringSequence;
     ds::amt::IS<Node*> hierarchyFilteringSequence;
+    RowSelection addressSelection;
+    RowSelection lifetimeSelection;
+    std::vector<size_t> lifetimeSlots;
     std::string optionString;
     int option;
     auto* actualNode = hierarchyManager.hierarchy.accessRoot();
+    RouteExpiry routeExpiry(loadedRoutingTable);
+    routeExpiry.scheduleAll();
+    RouteUpdates routeUpdates(loadedRoutingTable, hierarchyManager, tableManager, prefixTrie, &routeExpiry);
     do {
+        size_t expired = routeExpiry.expire([&routeUpdates](RoutingTableRow* row) {
+            routeUpdates.withdraw(row);
+        });
+        if (expired > 0) {
+            // Filtered rows and the current node may have been withdrawn.
+            filteringSequence.clear();
+            actualNode = hierarchyManager.hierarchy.accessRoot();
+            std::cout << "Expired routes: " << expired << ". Values in table: " << loadedRoutingTable.size() << std::endl;
+        }
         UserInteraction::printOptions();
         std::cin >> optionString;
         std::cout << "------------------------------------------" << std::endl;
         unsigned int startingLifetime = 0;
         unsigned int endingLifetime = UINT_MAX;
-        std::bitset<32> ipAddressToCompare;
-        ds::amt::MultiWayEH<Node>::PreOrderHierarchyIterator begin(&hierarchyManager.hierarchy, actualNode);
-        ds::amt::MultiWayEH<Node>::PreOrderHierarchyIterator end(&hierarchyManager.hierarchy, nullptr);
+        IPv4Prefix ipAddressToCompare;
+        RoutingHierarchy::PreOrderHierarchyIterator begin(&hierarchyManager.hierarchy, actualNode);
+        RoutingHierarchy::PreOrderHierarchyIterator end(&hierarchyManager.hierarchy, nullptr);
         try {
             option = std::stoi(optionString);
         } catch (const std::exception& e) {
             option = -1;
         }
         std::string filename;
-        if ((option > -1 && option < 3) || option == 21 || (option > 9 && option < 13)) {
+        if ((option > -1 && option < 3) || option == 7 || option == 21 || (option > 9 && option < 13)) {
             filteringSequence.clear();
         }
         switch (option) {
@@ -35,25 +58,22 @@ void mainLoop(std::vector<RoutingTableRow>& loadedRoutingTable, HierarchyManager
             case 0:
                 Filter::chooseAddress(ipAddressToCompare);
                 Filter::chooseLifetime(startingLifetime, endingLifetime);
-                Filter::filterEntries(loadedRoutingTable.begin(), loadedRoutingTable.end(),
-                                      [&](const RoutingTableRow& row) {
-                                          return matchWithAddress(row, ipAddressToCompare) &&
-                                                 matchLifetime(row, startingLifetime, endingLifetime);
-                                      }, filteringSequence);
+                loadedRoutingTable.selectContaining(ipAddressToCompare.address, addressSelection);
+                loadedRoutingTable.selectLifetime(startingLifetime, endingLifetime, lifetimeSelection);
+                addressSelection &= lifetimeSelection;
+                loadedRoutingTable.collect(addressSelection, filteringSequence);
                 break;
             case 1:
                 Filter::chooseAddress(ipAddressToCompare);
-                Filter::filterEntries(loadedRoutingTable.begin(), loadedRoutingTable.end(),
-                                      [&](const RoutingTableRow& row) {
-                                          return matchWithAddress(row, ipAddressToCompare);
-                                      }, filteringSequence);
+                prefixTrie.allMatches(ipAddressToCompare.address, filteringSequence);
                 break;
             case 2:
                 Filter::chooseLifetime(startingLifetime, endingLifetime);
-                Filter::filterEntries(loadedRoutingTable.begin(), loadedRoutingTable.end(),
-                                      [&](const RoutingTableRow& row) {
-                                          return matchLifetime(row, startingLifetime, endingLifetime);
-                                      }, filteringSequence);
+                loadedRoutingTable.forEachInLifetime(startingLifetime, endingLifetime, [&lifetimeSlots](size_t slot) {
+                    lifetimeSlots.push_back(slot);
+                });
+                loadedRoutingTable.collect(lifetimeSlots, filteringSequence);
+                lifetimeSlots.clear();
                 break;
             case 3:
                 RoutingTableOperations::print(loadedRoutingTable);
@@ -79,13 +99,18 @@ void mainLoop(std::vector<RoutingTableRow>& loadedRoutingTable, HierarchyManager
                     std::cout << "No filtered routing table values to save!" << std::endl;
                 }
                 break;
+            case 7:
+                Filter::chooseAddress(ipAddressToCompare);
+                if (RoutingTableRow* bestRow = prefixTrie.lookup(ipAddressToCompare.address)) {
+                    filteringSequence.insertLast().data_ = bestRow;
+                }
+                break;
             case 10:
                 std::cout << "Your IP should start with: " << hierarchyManager.getOctetsToNode(*actualNode) << std::endl;
                 Filter::chooseAddress(ipAddressToCompare);
                 Filter::chooseLifetime(startingLifetime, endingLifetime);
-                Filter::filterEntries(begin, end, [&](const Node& node) {
-                    return matchWithAddressHierarchy(node, ipAddressToCompare) &&
-                           matchLifetimeHierarchy(node, startingLifetime, endingLifetime);
+                hierarchyManager.filterByLifetime(*actualNode, startingLifetime, endingLifetime, [&](const Node& node) {
+                    return matchWithAddressHierarchy(node, ipAddressToCompare);
                 }, hierarchyFilteringSequence);
                 break;
             case 11:
@@ -97,9 +122,7 @@ void mainLoop(std::vector<RoutingTableRow>& loadedRoutingTable, HierarchyManager
                 break;
             case 12:
                 Filter::chooseLifetime(startingLifetime, endingLifetime);
-                Filter::filterEntries(begin, end, [&](const Node& node) {
-                    return matchLifetimeHierarchy(node, startingLifetime, endingLifetime);
-                }, hierarchyFilteringSequence);
+                hierarchyManager.filterByLifetime(*actualNode, startingLifetime, endingLifetime, loadedRoutingTable, filteringSequence);
                 break;
             case 13:
                 hierarchyManager.printNodeInfo(*actualNode);
@@ -114,7 +137,7 @@ void mainLoop(std::vector<RoutingTableRow>& loadedRoutingTable, HierarchyManager
             case 15:
                 hierarchyManager.printNodeInfo(*actualNode);
                 hierarchyManager.printSons(*actualNode);
-                if (actualNode->sons_->isEmpty()) {
+                if (hierarchyManager.hierarchy.isLeaf(*actualNode)) {
                     std::cout << "No sons to go to!" << std::endl;
                     break;
                 }
@@ -125,11 +148,11 @@ void mainLoop(std::vector<RoutingTableRow>& loadedRoutingTable, HierarchyManager
                 } catch (const std::exception& e) {
                     option = -10;
                 }
-                if (option < 0 || option >= actualNode->sons_->size()) {
+                if (option < 0 || option >= hierarchyManager.hierarchy.degree(*actualNode)) {
                     std::cout << "Invalid son number!" << std::endl;
                     break;
                 }
-                actualNode = actualNode->sons_->access(option)->data_;
+                actualNode = hierarchyManager.hierarchy.accessSon(*actualNode, option);
                 option = -10;
                 break;
             case 16:
@@ -146,6 +169,25 @@ void mainLoop(std::vector<RoutingTableRow>& loadedRoutingTable, HierarchyManager
             case 32:
                 SortingManager::sortData(filteringSequence, compareTime);
                 break;
+            case 41:
+                LookupBenchmark::run(loadedRoutingTable);
+                break;
+            case 51: {
+                std::cout << "Insert path of the update file or pipe: ";
+                std::cin >> filename;
+                std::ifstream updateStream(filename);
+                if (!updateStream.is_open()) {
+                    std::cout << "Could not open " << filename << std::endl;
+                    break;
+                }
+                RouteUpdates::Summary summary = routeUpdates.applyStream(updateStream);
+                // Filtered rows and the current node may have been withdrawn.
+                filteringSequence.clear();
+                actualNode = hierarchyManager.hierarchy.accessRoot();
+                std::cout << "Added: " << summary.added << ", withdrawn: " << summary.withdrawn << ", modified: " << summary.modified << ", rejected: " << summary.rejected
+                          << ". Values in table: " << loadedRoutingTable.size() << std::endl;
+                break;
+            }
             default:
                 std::cout << "Invalid option!" << std::endl;
                 break;
@@ -154,15 +196,15 @@ void mainLoop(std::vector<RoutingTableRow>& loadedRoutingTable, HierarchyManager
             UserInteraction::hierarchyFilteredToNormalSequence(hierarchyFilteringSequence, filteringSequence);
             hierarchyFilteringSequence.clear();
         }
-        if ((option > -1 && option < 3) || option == 21 || (option > 9 && option < 13)) {
+        if ((option > -1 && option < 3) || option == 7 || option == 21 || (option > 9 && option < 13)) {
             UserInteraction::printFilteredSequence(filteringSequence);
         }
         option = -10;
     } while (true);
 }
 
-void deleteTable(std::vector<RoutingTableRow>& loadedRoutingTable, TableManager& tableManager) {
-    ds::adt::ImplicitList<std::bitset<32>> destAddresses;
+void deleteTable(RowStore& loadedRoutingTable, TableManager& tableManager) {
+    ds::adt::ImplicitList<IPv4Prefix> destAddresses;
     for (auto& row : loadedRoutingTable) {
         if (!destAddresses.contains(row.destinationIP)) {
             destAddresses.insertLast(row.destinationIP);
@@ -171,19 +213,41 @@ void deleteTable(std::vector<RoutingTableRow>& loadedRoutingTable, TableManager&
     tableManager.removeEntries(destAddresses);
 }
 
-int main() {
+// Started with --test, the program runs tests of its own structures instead of loading the routing table.
+int runTests() {
+    ds::tests::CompositeTest root("SemestralProject");
+    root.add_test(std::make_unique<LifetimeIndexTest>());
+    root.add_test(std::make_unique<TimingWheelTest>());
+    root.add_test(std::make_unique<PrefixTrieTest>());
+    root.add_test(std::make_unique<RouteUpdatesTest>());
+    root.add_test(std::make_unique<RouteExpiryTest>());
+    root.run();
+    ds::tests::console_print_results(root, ds::tests::ConsoleOutputType::NoLeaf);
+    return root.result() == ds::tests::TestResult::Pass ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
     //initHeapMonitor();
-    std::vector<RoutingTableRow> loadedRoutingTable;
+    if (argc > 1 && std::string(argv[1]) == "--test") {
+        return runTests();
+    }
+    RowStore loadedRoutingTable;
     HierarchyManager hierarchyManager;
     TableManager tableManager;
+    PrefixTrie prefixTrie;
     try {
-        Loader::loadFromCSV("RT.csv", loadedRoutingTable, hierarchyManager, tableManager);
+        if (Snapshot::tryLoad("RT.csv", loadedRoutingTable, hierarchyManager, tableManager, prefixTrie)) {
+            std::cout << "Routing table loaded from snapshot " << Snapshot::pathFor("RT.csv") << std::endl;
+        } else {
+            Loader::loadFromCSV("RT.csv", loadedRoutingTable, hierarchyManager, tableManager, prefixTrie);
+            Snapshot::save("RT.csv", loadedRoutingTable, hierarchyManager, prefixTrie);
+        }
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
         return 1;
     }
     std::cout << "Routing table loaded successfully! Values in vector: " << loadedRoutingTable.size() << ". Values in hierarchy: " << hierarchyManager.hierarchy.size() << ". Table size: " << tableManager.table->size() << std::endl;
-    mainLoop(loadedRoutingTable, hierarchyManager, tableManager);
+    mainLoop(loadedRoutingTable, hierarchyManager, tableManager, prefixTrie);
     deleteTable(loadedRoutingTable, tableManager);
     return 0;
 }
\ No newline at end of file
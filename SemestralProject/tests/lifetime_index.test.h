@@ -0,0 +1,85 @@
+#pragma once
+#include "../LifetimeIndex.h"
+#include <tests/_details/test.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Inserting into an index without blocks creates the first block from the entry, also after the last entry
+// was erased.
+class LifetimeIndexTestInsertIntoEmpty : public ds::tests::LeafTest {
+public:
+    LifetimeIndexTestInsertIntoEmpty() : LeafTest("insert-into-empty") {
+    }
+
+protected:
+    void test() override {
+        LifetimeIndex index;
+        index.insert({ 50, 1 });
+        this->assert_equals(static_cast<size_t>(1), index.size());
+        this->assert_equals(static_cast<size_t>(1), index.count(0, 100));
+
+        index.erase({ 50, 1 });
+        this->assert_equals(static_cast<size_t>(0), index.count(0, 100));
+        index.insert({ 70, 2 });
+        this->assert_equals(static_cast<size_t>(1), index.count(60, 80));
+        this->assert_equals(static_cast<size_t>(0), index.count(0, 60));
+    }
+};
+
+// Random inserts and erases split and drop blocks, ranges are checked against a sorted vector.
+class LifetimeIndexTestRanges : public ds::tests::LeafTest {
+public:
+    LifetimeIndexTestRanges() : LeafTest("ranges") {
+    }
+
+protected:
+    void test() override {
+        std::mt19937 random(49);
+        std::vector<LifetimeIndex::Entry> entries;
+        LifetimeIndex index;
+        for (uint32_t slot = 0; slot < 5 * LifetimeIndex::BLOCK_SIZE; ++slot) {
+            LifetimeIndex::Entry entry = { static_cast<uint32_t>(random() % 1000), slot };
+            index.insert(entry);
+            entries.push_back(entry);
+        }
+        for (size_t i = 0; i < entries.size(); i += 3) {
+            index.erase(entries[i]);
+        }
+        std::vector<LifetimeIndex::Entry> expected;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (i % 3 != 0) {
+                expected.push_back(entries[i]);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        this->assert_equals(expected.size(), index.size());
+
+        for (unsigned int start = 0; start < 1000; start += 97) {
+            unsigned int end = start + 150;
+            std::vector<size_t> slots;
+            index.forEachInRange(start, end, [&slots](size_t slot) {
+                slots.push_back(slot);
+            });
+            std::vector<size_t> expectedSlots;
+            for (const LifetimeIndex::Entry& entry : expected) {
+                if (entry.lifetime >= start && entry.lifetime <= end) {
+                    expectedSlots.push_back(entry.slot);
+                }
+            }
+            this->assert_equals(expectedSlots.size(), index.count(start, end));
+            this->assert_true(slots == expectedSlots, "Range is visited in the order of lifetimes.");
+        }
+        this->assert_throws([&index, &entries]() {
+            index.erase(entries[0]);
+        }, "Erasing a missing entry throws.");
+    }
+};
+
+class LifetimeIndexTest : public ds::tests::CompositeTest {
+public:
+    LifetimeIndexTest() : CompositeTest("LifetimeIndex") {
+        this->add_test(std::make_unique<LifetimeIndexTestInsertIntoEmpty>());
+        this->add_test(std::make_unique<LifetimeIndexTestRanges>());
+    }
+};
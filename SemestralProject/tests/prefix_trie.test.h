@@ -0,0 +1,174 @@
+#pragma once
+#include "../PrefixTrie.h"
+#include "../RoutingTable.h"
+#include "../RowStore.h"
+#include <tests/_details/test.hpp>
+#include <algorithm>
+#include <random>
+#include <string_view>
+#include <vector>
+
+// Rows added to a trie one by one in the order they are kept in added, withdrawn rows are removed from it.
+class PrefixTrieTestBase : public ds::tests::LeafTest {
+public:
+    explicit PrefixTrieTestBase(std::string name) : LeafTest(std::move(name)) {
+    }
+
+protected:
+    RoutingTableRow* addRoute(std::string_view prefix, std::string_view destination) {
+        RoutingTableRow entry;
+        entry.ipAddress = RoutingTableOperations::processIPAddress(prefix);
+        entry.destinationIP = RoutingTableOperations::processIPAddress(destination);
+        entry.lifetime = UINT_MAX;
+        RoutingTableRow* row = rows.add(entry);
+        trie.add(row);
+        added.push_back(row);
+        return row;
+    }
+
+    void removeRoute(RoutingTableRow* row) {
+        trie.remove(row);
+        added.erase(std::find(added.begin(), added.end(), row));
+        rows.remove(row);
+    }
+
+    // Longer routes match first, routes with the same prefix in the order they were added.
+    std::vector<RoutingTableRow*> expectedMatches(uint32_t ipAddress) const {
+        std::vector<RoutingTableRow*> matches;
+        for (RoutingTableRow* row : added) {
+            if (row->ipAddress.contains(ipAddress)) {
+                matches.push_back(row);
+            }
+        }
+        std::stable_sort(matches.begin(), matches.end(), [](const RoutingTableRow* first, const RoutingTableRow* second) {
+            return first->ipAddress.length > second->ipAddress.length;
+        });
+        return matches;
+    }
+
+    // Addresses inside every route and random ones are looked up and compared with all routes.
+    bool matchesAll(std::mt19937& random) const {
+        std::vector<uint32_t> addresses;
+        for (const RoutingTableRow* row : added) {
+            addresses.push_back(row->ipAddress.network() | (random() & ~row->ipAddress.mask()));
+        }
+        for (int i = 0; i < 100; ++i) {
+            addresses.push_back(static_cast<uint32_t>(random()));
+        }
+        for (uint32_t address : addresses) {
+            std::vector<RoutingTableRow*> expected = expectedMatches(address);
+            ds::amt::IS<RoutingTableRow*> matches;
+            trie.allMatches(address, matches);
+            std::vector<RoutingTableRow*> actual;
+            for (RoutingTableRow* row : matches) {
+                actual.push_back(row);
+            }
+            const RoutingTableRow* batch = nullptr;
+            trie.lookupBatch(&address, 1, &batch);
+            RoutingTableRow* best = expected.empty() ? nullptr : expected[0];
+            if (actual != expected || trie.lookup(address) != best || batch != best) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    RowStore rows;
+    PrefixTrie trie;
+    std::vector<RoutingTableRow*> added;
+};
+
+class PrefixTrieTestAddRemove : public PrefixTrieTestBase {
+public:
+    PrefixTrieTestAddRemove() : PrefixTrieTestBase("add-remove") {
+    }
+
+protected:
+    void test() override {
+        std::mt19937 random(41);
+        this->assert_true(trie.lookup(0x0A010203) == nullptr, "Empty trie matches nothing.");
+
+        const std::vector<std::string_view> prefixes = {
+            "10.1.2.0/24", "10.0.0.0/8", "10.1.2.128/25", "0.0.0.0/0", "10.1.2.3/32", "10.1.0.0/16",
+            "192.168.0.0/16", "10.1.2.0/23", "172.16.0.0/12", "192.168.1.0/24", "10.128.0.0/9", "10.1.2.4/30"
+        };
+        for (std::string_view prefix : prefixes) {
+            addRoute(prefix, "1.1.1.1");
+            this->assert_true(matchesAll(random), "Added route takes over its addresses.");
+        }
+
+        removeRoute(added[5]);
+        removeRoute(added[0]);
+        removeRoute(added[2]);
+        this->assert_true(matchesAll(random), "Withdrawn routes give their addresses to covering routes.");
+        addRoute("10.1.2.0/24", "2.2.2.2");
+        addRoute("10.0.0.0/7", "2.2.2.2");
+        this->assert_true(matchesAll(random), "Routes are added again after withdrawals.");
+        while (!added.empty()) {
+            removeRoute(added[random() % added.size()]);
+            this->assert_true(matchesAll(random), "Withdrawn route is not matched.");
+        }
+    }
+};
+
+class PrefixTrieTestDuplicates : public PrefixTrieTestBase {
+public:
+    PrefixTrieTestDuplicates() : PrefixTrieTestBase("duplicates") {
+    }
+
+protected:
+    void test() override {
+        std::mt19937 random(47);
+        RoutingTableRow* first = addRoute("10.1.0.0/16", "1.1.1.1");
+        RoutingTableRow* second = addRoute("10.1.0.0/16", "2.2.2.2");
+        addRoute("10.0.0.0/8", "3.3.3.3");
+        this->assert_true(trie.lookup(0x0A010203) == first, "First added route with a prefix is the best match.");
+        this->assert_true(matchesAll(random), "Duplicates follow each other in the order they were added.");
+
+        IPv4Prefix prefix = RoutingTableOperations::processIPAddress("10.1.0.0/16");
+        this->assert_true(trie.find(prefix, RoutingTableOperations::processIPAddress("2.2.2.2")) == second, "Route is found by its next hop.");
+        removeRoute(first);
+        this->assert_true(trie.lookup(0x0A010203) == second, "Duplicate takes over the slots of a withdrawn route.");
+        this->assert_true(trie.find(prefix, RoutingTableOperations::processIPAddress("1.1.1.1")) == nullptr, "Withdrawn route is not found.");
+        RoutingTableRow* third = addRoute("10.1.0.0/16", "4.4.4.4");
+        removeRoute(second);
+        this->assert_true(trie.lookup(0x0A010203) == third, "Route added after a withdrawal is matched.");
+        this->assert_true(matchesAll(random), "Chains skip withdrawn duplicates.");
+    }
+};
+
+class PrefixTrieTestCompaction : public PrefixTrieTestBase {
+public:
+    PrefixTrieTestCompaction() : PrefixTrieTestBase("compaction") {
+    }
+
+protected:
+    void test() override {
+        std::mt19937 random(47);
+        for (uint32_t i = 0; i < 100; ++i) {
+            RoutingTableRow entry;
+            entry.ipAddress = { static_cast<uint32_t>(0x0A000000 | (random() & 0x00FFFFFF)), static_cast<uint8_t>(8 + random() % 25) };
+            entry.destinationIP = { i, 32 };
+            entry.lifetime = UINT_MAX;
+            RoutingTableRow* row = rows.add(entry);
+            trie.add(row);
+            added.push_back(row);
+        }
+        for (int i = 0; i < 60; ++i) {
+            removeRoute(added[random() % added.size()]);
+        }
+        this->assert_true(trie.routeCount() < 100, "Withdrawn routes are dropped.");
+        this->assert_true(matchesAll(random), "Compaction keeps the matches.");
+        addRoute("10.0.0.0/8", "5.5.5.5");
+        this->assert_true(matchesAll(random), "Routes are added after compaction.");
+    }
+};
+
+class PrefixTrieTest : public ds::tests::CompositeTest {
+public:
+    PrefixTrieTest() : CompositeTest("PrefixTrie") {
+        this->add_test(std::make_unique<PrefixTrieTestAddRemove>());
+        this->add_test(std::make_unique<PrefixTrieTestDuplicates>());
+        this->add_test(std::make_unique<PrefixTrieTestCompaction>());
+    }
+};
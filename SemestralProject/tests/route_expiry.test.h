@@ -0,0 +1,88 @@
+#pragma once
+#include "../RouteExpiry.h"
+#include "route_updates.test.h"
+#include <tests/_details/test.hpp>
+#include <vector>
+
+// Time of the expiry is read from time, which the tests move forward by hand.
+class RouteExpiryTestBase : public RouteUpdatesTestBase {
+public:
+    explicit RouteExpiryTestBase(std::string name) : RouteUpdatesTestBase(std::move(name)), time(1000), expiry(rows, [this]() { return time; }) {
+    }
+
+protected:
+    size_t expireAt(RouteUpdates& updates, uint64_t now) {
+        time = now;
+        return expiry.expire([&updates](RoutingTableRow* row) {
+            updates.withdraw(row);
+        });
+    }
+
+    uint64_t time;
+    RouteExpiry expiry;
+};
+
+class RouteExpiryTestScheduleAll : public RouteExpiryTestBase {
+public:
+    RouteExpiryTestScheduleAll() : RouteExpiryTestBase("schedule-all") {
+    }
+
+protected:
+    void test() override {
+        RouteUpdates updates(rows, hierarchy, tableManager, prefixTrie);
+        updates.apply(update(RouteUpdates::Operation::Add, "10.0.0.0/8", "1.1.1.1", 30));
+        updates.apply(update(RouteUpdates::Operation::Add, "10.1.0.0/16", "1.1.1.1", 10));
+        updates.apply(update(RouteUpdates::Operation::Add, "10.1.2.0/24", "1.1.1.1", 300));
+        updates.apply(update(RouteUpdates::Operation::Add, "10.1.2.3/32", "1.1.1.1"));
+        expiry.scheduleAll();
+        this->assert_equals(static_cast<size_t>(3), expiry.size(), "Routes with a lifetime are scheduled.");
+
+        this->assert_equals(static_cast<size_t>(0), expireAt(updates, 1009), "Route does not expire before its lifetime.");
+        this->assert_equals(static_cast<size_t>(1), expireAt(updates, 1010), "Route expires after its lifetime.");
+        this->assert_true(lookup("10.1.5.5")->ipAddress.length == 8, "Expired route is withdrawn.");
+        this->assert_equals(static_cast<size_t>(1), expireAt(updates, 1299), "Route expires when the clock skips past its time.");
+        this->assert_equals(static_cast<size_t>(1), expireAt(updates, 1300), "Route expires at the next level of the wheel.");
+        this->assert_equals(static_cast<size_t>(0), expireAt(updates, 1000000), "Route without a lifetime never expires.");
+        this->assert_equals(static_cast<size_t>(1), rows.size(), "Only the route without a lifetime is left.");
+        this->assert_equals(static_cast<size_t>(0), expiry.size(), "No route is scheduled.");
+        withdrawAll(updates);
+    }
+};
+
+class RouteExpiryTestUpdates : public RouteExpiryTestBase {
+public:
+    RouteExpiryTestUpdates() : RouteExpiryTestBase("updates") {
+    }
+
+protected:
+    void test() override {
+        RouteUpdates updates(rows, hierarchy, tableManager, prefixTrie, &expiry);
+        updates.apply(update(RouteUpdates::Operation::Add, "10.0.0.0/8", "1.1.1.1", 10));
+        updates.apply(update(RouteUpdates::Operation::Add, "10.1.0.0/16", "1.1.1.1", 5));
+        updates.apply(update(RouteUpdates::Operation::Add, "10.2.0.0/16", "1.1.1.1", 5));
+        this->assert_equals(static_cast<size_t>(3), expiry.size(), "Added routes are scheduled.");
+
+        time = 1003;
+        updates.apply(update(RouteUpdates::Operation::Withdraw, "10.1.0.0/16", "1.1.1.1"));
+        updates.apply(update(RouteUpdates::Operation::Modify, "10.2.0.0/16", "1.1.1.1", UINT_MAX));
+        this->assert_equals(static_cast<size_t>(1), expiry.size(), "Withdrawn route and route without a lifetime are cancelled.");
+        this->assert_equals(static_cast<size_t>(0), expireAt(updates, 1008), "Cancelled routes do not expire.");
+        updates.apply(update(RouteUpdates::Operation::Modify, "10.0.0.0/8", "1.1.1.1", 10));
+        this->assert_equals(static_cast<size_t>(0), expireAt(updates, 1012), "Modified route is rescheduled.");
+        this->assert_equals(static_cast<size_t>(0), expireAt(updates, 1017), "Modified route does not expire before its new lifetime.");
+        this->assert_equals(static_cast<size_t>(1), expireAt(updates, 1018), "Modified route expires after its new lifetime.");
+        this->assert_true(lookup("10.3.0.0") == nullptr, "Expired route is withdrawn.");
+
+        updates.apply(update(RouteUpdates::Operation::Modify, "10.2.0.0/16", "1.1.1.1", 2));
+        this->assert_equals(static_cast<size_t>(1), expireAt(updates, 1020), "Route given a lifetime expires.");
+        this->assert_equals(static_cast<size_t>(0), rows.size(), "Every route expired.");
+    }
+};
+
+class RouteExpiryTest : public ds::tests::CompositeTest {
+public:
+    RouteExpiryTest() : CompositeTest("RouteExpiry") {
+        this->add_test(std::make_unique<RouteExpiryTestScheduleAll>());
+        this->add_test(std::make_unique<RouteExpiryTestUpdates>());
+    }
+};
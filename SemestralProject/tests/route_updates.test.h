@@ -0,0 +1,154 @@
+#pragma once
+#include "../RouteUpdates.h"
+#include <tests/_details/test.hpp>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+
+// Empty routing table with every structure the updates change. Rows left in it are withdrawn at the end
+// of a test, so lists of the table are released.
+class RouteUpdatesTestBase : public ds::tests::LeafTest {
+public:
+    explicit RouteUpdatesTestBase(std::string name) : LeafTest(std::move(name)) {
+    }
+
+protected:
+    static RouteUpdates::Update update(RouteUpdates::Operation operation, std::string_view prefix, std::string_view destination, unsigned int lifetime = UINT_MAX) {
+        RouteUpdates::Update result;
+        result.operation = operation;
+        result.prefix = RoutingTableOperations::processIPAddress(prefix);
+        result.destination = RoutingTableOperations::processIPAddress(destination);
+        result.lifetime = lifetime;
+        return result;
+    }
+
+    RoutingTableRow* lookup(std::string_view address) const {
+        return prefixTrie.lookup(RoutingTableOperations::processIPAddress(address).address);
+    }
+
+    size_t rowsTo(std::string_view destination) {
+        IPv4Prefix key = RoutingTableOperations::processIPAddress(destination);
+        ds::amt::IS<RoutingTableRow*> sequence;
+        tableManager.findRowWithKey(key, sequence);
+        return sequence.size();
+    }
+
+    bool inHierarchy(const RoutingTableRow* row) {
+        return hierarchy.findLeaf(*hierarchy.hierarchy.accessRoot(), row) != nullptr;
+    }
+
+    void withdrawAll(RouteUpdates& updates) {
+        while (rows.size() > 0) {
+            updates.withdraw(&*rows.begin());
+        }
+    }
+
+    RowStore rows;
+    HierarchyManager hierarchy;
+    TableManager tableManager;
+    PrefixTrie prefixTrie;
+};
+
+class RouteUpdatesTestParse : public ds::tests::LeafTest {
+public:
+    RouteUpdatesTestParse() : LeafTest("parse") {
+    }
+
+protected:
+    void test() override {
+        RouteUpdates::Update add = RouteUpdates::parse("add;10.0.0.0/8;via 1.2.3.4;1h");
+        this->assert_true(add.operation == RouteUpdates::Operation::Add, "Add is parsed.");
+        this->assert_true(add.prefix == RoutingTableOperations::processIPAddress("10.0.0.0/8"), "Prefix is parsed.");
+        this->assert_true(add.destination == RoutingTableOperations::processIPAddress("1.2.3.4"), "Next hop is parsed.");
+        this->assert_equals(3600u, add.lifetime, "Lifetime is parsed.");
+        this->assert_equals(UINT_MAX, RouteUpdates::parse("add;10.0.0.0/8;via1.2.3.4").lifetime, "Route without lifetime never expires.");
+        RouteUpdates::Update withdraw = RouteUpdates::parse("withdraw;10.0.0.0/8;via 1.2.3.4");
+        this->assert_true(withdraw.operation == RouteUpdates::Operation::Withdraw, "Withdraw is parsed.");
+        this->assert_true(RouteUpdates::parse("modify;10.0.0.0/8;via 1.2.3.4;2h").operation == RouteUpdates::Operation::Modify, "Modify is parsed.");
+
+        this->assert_throws([]() { RouteUpdates::parse("replace;10.0.0.0/8;via 1.2.3.4"); }, "Unknown operation is rejected.");
+        this->assert_throws([]() { RouteUpdates::parse("add;10.0.0.0/8;1.2.3.4"); }, "Next hop without via is rejected.");
+        this->assert_throws([]() { RouteUpdates::parse("withdraw;10.0.0.0/8;via 1.2.3.4;1h"); }, "Withdraw with lifetime is rejected.");
+        this->assert_throws([]() { RouteUpdates::parse("modify;10.0.0.0/8;via 1.2.3.4"); }, "Modify without lifetime is rejected.");
+        this->assert_throws([]() { RouteUpdates::parse("add;10.0.0.0/8;via 1.2.3.4;-5"); }, "Invalid lifetime is rejected.");
+    }
+};
+
+class RouteUpdatesTestApply : public RouteUpdatesTestBase {
+public:
+    RouteUpdatesTestApply() : RouteUpdatesTestBase("apply") {
+    }
+
+protected:
+    void test() override {
+        RouteUpdates updates(rows, hierarchy, tableManager, prefixTrie);
+        updates.apply(update(RouteUpdates::Operation::Add, "10.0.0.0/8", "1.1.1.1", 100));
+        updates.apply(update(RouteUpdates::Operation::Add, "10.1.0.0/16", "2.2.2.2", 200));
+        updates.apply(update(RouteUpdates::Operation::Add, "10.1.2.0/24", "1.1.1.1"));
+        this->assert_equals(static_cast<size_t>(3), rows.size(), "Added routes are rows.");
+        this->assert_equals(static_cast<size_t>(2), rowsTo("1.1.1.1"), "Added routes are in the table.");
+        RoutingTableRow* route = lookup("10.1.5.5");
+        this->assert_true(route != nullptr && route->destinationIP == RoutingTableOperations::processIPAddress("2.2.2.2"), "Added route is matched.");
+        this->assert_true(inHierarchy(route), "Added route is in the hierarchy.");
+
+        updates.apply(update(RouteUpdates::Operation::Modify, "10.1.0.0/16", "2.2.2.2", 7));
+        this->assert_equals(7u, route->lifetime, "Modified route has the new lifetime.");
+        this->assert_equals(7u, hierarchy.hierarchy.aggregate(*hierarchy.hierarchy.accessRoot()).min, "Hierarchy sees the new lifetime.");
+
+        updates.apply(update(RouteUpdates::Operation::Withdraw, "10.1.0.0/16", "2.2.2.2"));
+        this->assert_equals(static_cast<size_t>(2), rows.size(), "Withdrawn route is not a row.");
+        this->assert_equals(static_cast<size_t>(0), rowsTo("2.2.2.2"), "Withdrawn route is not in the table.");
+        route = lookup("10.1.5.5");
+        this->assert_true(route != nullptr && route->ipAddress == RoutingTableOperations::processIPAddress("10.0.0.0/8"), "Covering route takes over.");
+        this->assert_throws([&updates]() { updates.apply(update(RouteUpdates::Operation::Withdraw, "10.1.0.0/16", "2.2.2.2")); }, "Unknown route is not withdrawn.");
+        this->assert_throws([&updates]() { updates.apply(update(RouteUpdates::Operation::Modify, "10.0.0.0/8", "2.2.2.2", 1)); }, "Route with another next hop is not modified.");
+
+        withdrawAll(updates);
+        this->assert_true(lookup("10.1.2.3") == nullptr, "No route is left in the trie.");
+        this->assert_equals(static_cast<size_t>(1), hierarchy.hierarchy.size(), "Only the root is left in the hierarchy.");
+        this->assert_equals(static_cast<size_t>(0), tableManager.table->size(), "No destination is left in the table.");
+    }
+};
+
+class RouteUpdatesTestStream : public RouteUpdatesTestBase {
+public:
+    RouteUpdatesTestStream() : RouteUpdatesTestBase("stream") {
+    }
+
+protected:
+    void test() override {
+        RouteUpdates updates(rows, hierarchy, tableManager, prefixTrie);
+        std::istringstream stream(
+            "add;1.2.3.0/24;via 9.9.9.9;1h\r\n"
+            "withdraw;1.2.3.0/24;via 9.9.9.8\n"
+            "foo;x\n"
+            "# comment\n"
+            "\n"
+            "modify;1.2.3.0/24;via 9.9.9.9;5\n"
+            "add;1.2.0.0/16;via 9.9.9.9\n"
+            "withdraw;1.2.3.0/24;via 9.9.9.9\n"
+            "add;1.2.3.0/33;via 1.1.1.1\n");
+        std::ostringstream errors;
+        std::streambuf* cerrBuffer = std::cerr.rdbuf(errors.rdbuf());
+        RouteUpdates::Summary summary = updates.applyStream(stream);
+        std::cerr.rdbuf(cerrBuffer);
+
+        this->assert_equals(static_cast<size_t>(2), summary.added, "Added lines are counted.");
+        this->assert_equals(static_cast<size_t>(1), summary.withdrawn, "Withdrawn lines are counted.");
+        this->assert_equals(static_cast<size_t>(1), summary.modified, "Modified lines are counted.");
+        this->assert_equals(static_cast<size_t>(3), summary.rejected, "Invalid lines are rejected.");
+        this->assert_true(errors.str().find("Check line 2") != std::string::npos, "Rejected line is reported.");
+        this->assert_equals(static_cast<size_t>(1), rows.size(), "Updates around rejected lines are applied.");
+        this->assert_true(lookup("1.2.3.4") != nullptr && lookup("1.2.3.4")->ipAddress.length == 16, "Route left after the stream is matched.");
+        withdrawAll(updates);
+    }
+};
+
+class RouteUpdatesTest : public ds::tests::CompositeTest {
+public:
+    RouteUpdatesTest() : CompositeTest("RouteUpdates") {
+        this->add_test(std::make_unique<RouteUpdatesTestParse>());
+        this->add_test(std::make_unique<RouteUpdatesTestApply>());
+        this->add_test(std::make_unique<RouteUpdatesTestStream>());
+    }
+};
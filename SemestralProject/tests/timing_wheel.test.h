@@ -0,0 +1,131 @@
+#pragma once
+#include "../TimingWheel.h"
+#include <tests/_details/test.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Advances the wheel and returns the expired ids sorted, timers of the same time expire in no particular order.
+inline std::vector<size_t> advanceWheel(TimingWheel& wheel, uint64_t time) {
+    std::vector<size_t> expired;
+    wheel.advance(time, [&expired](size_t id) {
+        expired.push_back(id);
+    });
+    std::sort(expired.begin(), expired.end());
+    return expired;
+}
+
+class TimingWheelTestScheduleExpire : public ds::tests::LeafTest {
+public:
+    TimingWheelTestScheduleExpire() : LeafTest("schedule-expire") {
+    }
+
+protected:
+    void test() override {
+        TimingWheel wheel(100);
+        wheel.schedule(0, 105);
+        wheel.schedule(1, 103);
+        wheel.schedule(2, 110);
+        wheel.schedule(3, 103);
+        wheel.schedule(4, 200);
+        this->assert_equals(static_cast<size_t>(5), wheel.size());
+
+        this->assert_true(advanceWheel(wheel, 102).empty(), "Nothing expires before its time.");
+        this->assert_true(advanceWheel(wheel, 104) == std::vector<size_t>{ 1, 3 }, "Timers expire at their time.");
+        this->assert_equals(static_cast<uint64_t>(104), wheel.now());
+        this->assert_false(wheel.isScheduled(1), "Expired timer is not scheduled.");
+        this->assert_true(advanceWheel(wheel, 110) == std::vector<size_t>{ 0, 2 }, "Timers expire up to the time.");
+        this->assert_true(advanceWheel(wheel, 199).empty(), "Nothing expires before its time.");
+        this->assert_true(advanceWheel(wheel, 1000) == std::vector<size_t>{ 4 }, "Last timer expires.");
+        this->assert_equals(static_cast<size_t>(0), wheel.size());
+        this->assert_equals(static_cast<uint64_t>(1000), wheel.now());
+    }
+};
+
+class TimingWheelTestCancelReschedule : public ds::tests::LeafTest {
+public:
+    TimingWheelTestCancelReschedule() : LeafTest("cancel-reschedule") {
+    }
+
+protected:
+    void test() override {
+        TimingWheel wheel;
+        wheel.schedule(0, 50);
+        wheel.schedule(1, 60);
+        wheel.schedule(2, 70);
+        wheel.cancel(0);
+        wheel.cancel(0);
+        this->assert_false(wheel.isScheduled(0), "Cancelled timer is not scheduled.");
+        this->assert_equals(static_cast<size_t>(2), wheel.size());
+
+        wheel.schedule(1, 40);
+        wheel.schedule(2, 5000);
+        this->assert_equals(static_cast<size_t>(2), wheel.size());
+        this->assert_true(advanceWheel(wheel, 45) == std::vector<size_t>{ 1 }, "Timer moved earlier expires at its new time.");
+        this->assert_true(advanceWheel(wheel, 4999).empty(), "Timer moved later does not expire at its old time.");
+
+        wheel.schedule(3, 10);
+        this->assert_true(advanceWheel(wheel, 4999) == std::vector<size_t>{ 3 }, "Time already passed expires on the next advance.");
+        this->assert_true(advanceWheel(wheel, 5000) == std::vector<size_t>{ 2 }, "Timer expires at its new time.");
+    }
+};
+
+// Timers in buckets of higher levels move down level by level and still expire exactly at their times.
+class TimingWheelTestCascade : public ds::tests::LeafTest {
+public:
+    TimingWheelTestCascade() : LeafTest("cascade") {
+    }
+
+protected:
+    void test() override {
+        const std::vector<uint64_t> times = {
+            TimingWheel::BUCKETS - 1,
+            TimingWheel::BUCKETS,
+            TimingWheel::BUCKETS * TimingWheel::BUCKETS - 1,
+            TimingWheel::BUCKETS * TimingWheel::BUCKETS,
+            uint64_t(1) << 18,
+            (uint64_t(1) << 18) + 5,
+            (uint64_t(1) << 40) + 3
+        };
+        TimingWheel wheel;
+        for (size_t id = 0; id < times.size(); ++id) {
+            wheel.schedule(id, times[id]);
+        }
+        for (size_t id = 0; id < times.size(); ++id) {
+            this->assert_true(advanceWheel(wheel, times[id] - 1).empty(), "Timer does not expire before its time.");
+            this->assert_true(advanceWheel(wheel, times[id]) == std::vector<size_t>{ id }, "Timer expires at its time.");
+        }
+
+        std::mt19937_64 random(50);
+        std::vector<uint64_t> randomTimes(1000);
+        for (size_t id = 0; id < randomTimes.size(); ++id) {
+            randomTimes[id] = wheel.now() + random() % (uint64_t(1) << 20);
+            wheel.schedule(id, randomTimes[id]);
+        }
+        uint64_t time = wheel.now();
+        while (wheel.size() > 0) {
+            uint64_t previous = time;
+            time += random() % 4096;
+            std::vector<size_t> expected;
+            for (size_t id = 0; id < randomTimes.size(); ++id) {
+                if (randomTimes[id] > previous && randomTimes[id] <= time) {
+                    expected.push_back(id);
+                }
+            }
+            if (advanceWheel(wheel, time) != expected) {
+                this->fail("Timers expire exactly when the time passes them.");
+                return;
+            }
+        }
+        this->pass("All timers expired at their times.");
+    }
+};
+
+class TimingWheelTest : public ds::tests::CompositeTest {
+public:
+    TimingWheelTest() : CompositeTest("TimingWheel") {
+        this->add_test(std::make_unique<TimingWheelTestScheduleExpire>());
+        this->add_test(std::make_unique<TimingWheelTestCancelReschedule>());
+        this->add_test(std::make_unique<TimingWheelTestCascade>());
+    }
+};